@@ -0,0 +1,366 @@
+/**
+ * ============================================
+ * File: bench/FixtureGenerator.cpp
+ * Description: Fixture generator implementation
+ * ============================================
+ */
+
+#include "FixtureGenerator.h"
+#include <QDir>
+#include <QFile>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+/**
+ * @brief xorshift64*: fixed seed, same sequence on every platform
+ */
+class Random
+{
+public:
+    explicit Random(quint64 seed) : m_state(seed) {}
+
+    quint64 next()
+    {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1DULL;
+    }
+
+    quint64 below(quint64 bound) { return next() % bound; }
+
+private:
+    quint64 m_state;
+};
+
+constexpr quint64 SEED = 0x5EED5EED5EED5EEDULL;
+
+const char* const PROCESS_NAMES[] = {
+    "systemd", "kthreadd", "rcu_gp", "kworker/0:1-events", "ksoftirqd/0",
+    "migration/0", "systemd-journal", "systemd-udevd", "dbus-daemon",
+    "NetworkManager", "sshd", "bash", "ili9341-system", "Web Content",
+    "(sd-pam)", "tmux: server", "python3", "containerd-shim", "postgres",
+    "nginx: worker process"
+};
+
+bool writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(content) == content.size();
+}
+
+void appendNumber(QByteArray& out, quint64 value)
+{
+    char digits[24];
+    const int length = snprintf(digits, sizeof(digits), "%llu", static_cast<unsigned long long>(value));
+    out.append(digits, length);
+}
+
+QByteArray procStat(const FixtureGenerator::Scale& scale, Random& random)
+{
+    QByteArray out;
+
+    auto cpuLine = [&](const char* label, quint64 factor) {
+        out.append(label);
+        const quint64 idle = factor * (800000 + random.below(200000));
+        const quint64 fields[10] = {
+            factor * random.below(120000), factor * random.below(2000),
+            factor * random.below(60000), idle, factor * random.below(9000),
+            0, factor * random.below(3000), 0, 0, 0
+        };
+        for (quint64 field : fields) {
+            out.append(' ');
+            appendNumber(out, field);
+        }
+        out.append('\n');
+    };
+
+    cpuLine("cpu ", static_cast<quint64>(scale.cores));
+    for (int core = 0; core < scale.cores; ++core) {
+        char label[16];
+        snprintf(label, sizeof(label), "cpu%d", core);
+        cpuLine(label, 1);
+    }
+
+    // intr and softirq are long lines the parser has to skip
+    out.append("intr ");
+    appendNumber(out, random.below(1u << 30));
+    for (int irq = 0; irq < 64 + scale.cores * 4; ++irq) {
+        out.append(' ');
+        appendNumber(out, (irq % 3 == 0) ? random.below(1000000) : 0);
+    }
+    out.append("\nctxt ");
+    appendNumber(out, random.below(1ULL << 34));
+    out.append("\nbtime 1760600000\nprocesses ");
+    appendNumber(out, static_cast<quint64>(scale.pids) * 40);
+    out.append("\nprocs_running ");
+    appendNumber(out, 1 + random.below(static_cast<quint64>(scale.cores)));
+    out.append("\nprocs_blocked ");
+    appendNumber(out, random.below(3));
+    out.append("\nsoftirq ");
+    appendNumber(out, random.below(1u << 28));
+    for (int vector = 0; vector < 10; ++vector) {
+        out.append(' ');
+        appendNumber(out, random.below(1u << 24));
+    }
+    out.append('\n');
+    return out;
+}
+
+QByteArray memInfo(const FixtureGenerator::Scale& scale)
+{
+    // 1 GiB per core, the rest in proportion
+    const quint64 total = static_cast<quint64>(scale.cores) * 1024 * 1024;
+    const struct { const char* key; quint64 value; } rows[] = {
+        { "MemTotal", total }, { "MemFree", total / 4 }, { "MemAvailable", total / 2 },
+        { "Buffers", total / 64 }, { "Cached", total / 5 }, { "SwapCached", 0 },
+        { "Active", total / 4 }, { "Inactive", total / 6 }, { "Active(anon)", total / 8 },
+        { "Inactive(anon)", total / 32 }, { "Active(file)", total / 8 },
+        { "Inactive(file)", total / 7 }, { "Unevictable", 16 }, { "Mlocked", 16 },
+        { "SwapTotal", total / 4 }, { "SwapFree", total / 4 }, { "Zswap", 0 },
+        { "Zswapped", 0 }, { "Dirty", 120 }, { "Writeback", 0 },
+        { "AnonPages", total / 7 }, { "Mapped", total / 20 }, { "Shmem", total / 100 },
+        { "KReclaimable", total / 50 }, { "Slab", total / 30 },
+        { "SReclaimable", total / 50 }, { "SUnreclaim", total / 90 },
+        { "KernelStack", 4096 }, { "PageTables", total / 400 },
+        { "SecPageTables", 0 }, { "NFS_Unstable", 0 }, { "Bounce", 0 },
+        { "WritebackTmp", 0 }, { "CommitLimit", total / 2 + total / 4 },
+        { "Committed_AS", total / 3 }, { "VmallocTotal", 261087232 },
+        { "VmallocUsed", 20480 }, { "VmallocChunk", 0 }, { "Percpu", 1024 },
+        { "CmaTotal", 65536 }, { "CmaFree", 60000 }
+    };
+
+    QByteArray out;
+    for (const auto& row : rows) {
+        char line[64];
+        snprintf(line, sizeof(line), "%-16s%8llu kB\n", (QByteArray(row.key) + ':').constData(),
+                 static_cast<unsigned long long>(row.value));
+        out.append(line);
+    }
+    out.append("HugePages_Total:       0\nHugePages_Free:        0\n"
+               "HugePages_Rsvd:        0\nHugePages_Surp:        0\n"
+               "Hugepagesize:       2048 kB\nHugetlb:               0 kB\n");
+    return out;
+}
+
+QByteArray netDev(const FixtureGenerator::Scale& scale, Random& random)
+{
+    QByteArray out("Inter-|   Receive                                                |  Transmit\n"
+                   " face |bytes    packets errs drop fifo frame compressed multicast|"
+                   "bytes    packets errs drop fifo colls carrier compressed\n");
+
+    for (int index = 0; index < scale.interfaces; ++index) {
+        char name[16];
+        if (index == 0) {
+            snprintf(name, sizeof(name), "lo");
+        } else if (index == 1) {
+            snprintf(name, sizeof(name), "eth0");
+        } else if (index == 2) {
+            snprintf(name, sizeof(name), "wlan0");
+        } else {
+            snprintf(name, sizeof(name), "veth%05x", index);
+        }
+
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "%6s: %llu %llu 0 0 0 0 0 %llu %llu %llu 0 0 0 0 0 0\n", name,
+                 static_cast<unsigned long long>(random.below(1ULL << 40)),
+                 static_cast<unsigned long long>(random.below(1ULL << 30)),
+                 static_cast<unsigned long long>(random.below(1ULL << 16)),
+                 static_cast<unsigned long long>(random.below(1ULL << 40)),
+                 static_cast<unsigned long long>(random.below(1ULL << 30)));
+        out.append(line);
+    }
+    return out;
+}
+
+/**
+ * @brief TCP state of the next socket, weighted like a busy server
+ */
+int tcpState(Random& random)
+{
+    // ESTABLISHED, TIME_WAIT, LISTEN, CLOSE_WAIT, then SYN_SENT..FIN_WAIT2
+    const quint64 roll = random.below(100);
+    if (roll < 70) {
+        return 0x01;
+    }
+    if (roll < 85) {
+        return 0x06;
+    }
+    if (roll < 90) {
+        return 0x0A;
+    }
+    if (roll < 95) {
+        return 0x08;
+    }
+    return 0x02 + static_cast<int>(random.below(4));
+}
+
+QByteArray netTcp(int sockets, bool ipv6, Random& random)
+{
+    QByteArray out;
+    out.reserve(static_cast<qsizetype>(sockets) * (ipv6 ? 180 : 150) + 256);
+
+    if (ipv6) {
+        out.append("  sl  local_address                         remote_address                        "
+                   "st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n");
+    } else {
+        out.append("  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt"
+                   "   uid  timeout inode\n");
+    }
+
+    for (int slot = 0; slot < sockets; ++slot) {
+        const unsigned local = static_cast<unsigned>(random.next());
+        const unsigned remote = static_cast<unsigned>(random.next());
+        const unsigned localPort = static_cast<unsigned>(random.below(65536));
+        const unsigned remotePort = static_cast<unsigned>(random.below(65536));
+        const int state = tcpState(random);
+        const unsigned long long inode = 100000 + static_cast<unsigned long long>(slot);
+
+        char line[256];
+        if (ipv6) {
+            snprintf(line, sizeof(line),
+                     "%4d: 0000000000000000FFFF0000%08X:%04X 0000000000000000FFFF0000%08X:%04X %02X "
+                     "00000000:00000000 00:00000000 00000000  1000        0 %llu 1 0000000000000000 20 4 30 10 -1\n",
+                     slot, local, localPort, remote, remotePort, state, inode);
+        } else {
+            snprintf(line, sizeof(line),
+                     "%4d: %08X:%04X %08X:%04X %02X 00000000:00000000 00:00000000 00000000  1000"
+                     "        0 %llu 1 0000000000000000 20 4 30 10 -1\n",
+                     slot, local, localPort, remote, remotePort, state, inode);
+        }
+        out.append(line);
+    }
+    return out;
+}
+
+QByteArray diskStats(const FixtureGenerator::Scale& scale, Random& random)
+{
+    QByteArray out;
+
+    // Loop devices come first on a real system, and are skipped
+    for (int loop = 0; loop < 2; ++loop) {
+        char line[160];
+        snprintf(line, sizeof(line), "   7       %d loop%d 52 0 2104 12 0 0 0 0 0 20 12 0 0 0 0 0 0\n",
+                 loop, loop);
+        out.append(line);
+    }
+
+    for (int device = 0; device < scale.disks; ++device) {
+        const int disk = device / 4;
+        const int partition = device % 4;
+
+        // mmcblk0 like the target board, then sda, sdb, ...
+        char name[24];
+        if (disk == 0) {
+            snprintf(name, sizeof(name), "mmcblk0");
+        } else {
+            snprintf(name, sizeof(name), "sd%c", static_cast<char>('a' + (disk - 1) % 26));
+        }
+        if (partition) {
+            const size_t length = strlen(name);
+            snprintf(name + length, sizeof(name) - length, disk == 0 ? "p%d" : "%d", partition);
+        }
+
+        char line[256];
+        snprintf(line, sizeof(line),
+                 " %3d %7d %s %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu 0 0 0 0 %llu %llu\n",
+                 disk == 0 ? 179 : 8, disk == 0 ? partition : (disk - 1) * 16 + partition, name,
+                 static_cast<unsigned long long>(random.below(1u << 24)),
+                 static_cast<unsigned long long>(random.below(1u << 16)),
+                 static_cast<unsigned long long>(random.below(1ULL << 34)),
+                 static_cast<unsigned long long>(random.below(1u << 26)),
+                 static_cast<unsigned long long>(random.below(1u << 24)),
+                 static_cast<unsigned long long>(random.below(1u << 16)),
+                 static_cast<unsigned long long>(random.below(1ULL << 34)),
+                 static_cast<unsigned long long>(random.below(1u << 26)),
+                 static_cast<unsigned long long>(random.below(4)),
+                 static_cast<unsigned long long>(random.below(1u << 26)),
+                 static_cast<unsigned long long>(random.below(1u << 27)),
+                 static_cast<unsigned long long>(random.below(1u << 20)),
+                 static_cast<unsigned long long>(random.below(1u << 20)));
+        out.append(line);
+    }
+    return out;
+}
+
+QByteArray pidStat(int pid, Random& random)
+{
+    const char* name = PROCESS_NAMES[random.below(sizeof(PROCESS_NAMES) / sizeof(PROCESS_NAMES[0]))];
+    const char states[] = "SSSSSRDIZ";
+    const char state = states[random.below(sizeof(states) - 1)];
+
+    // All 52 fields of proc(5), so the parser skips what the kernel sends
+    char line[512];
+    snprintf(line, sizeof(line),
+             "%d (%s) %c %d %d %d 0 -1 4194560 %llu 0 %llu 0 %llu %llu 0 0 20 0 %llu 0 %llu %llu %llu "
+             "18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 17 %llu 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+             pid, name, state, pid > 1 ? 1 : 0, pid, pid,
+             static_cast<unsigned long long>(random.below(1u << 20)),
+             static_cast<unsigned long long>(random.below(1u << 10)),
+             static_cast<unsigned long long>(random.below(1u << 22)),
+             static_cast<unsigned long long>(random.below(1u << 20)),
+             static_cast<unsigned long long>(1 + random.below(64)),
+             static_cast<unsigned long long>(random.below(1u << 24)),
+             static_cast<unsigned long long>(random.below(1ULL << 33)),
+             static_cast<unsigned long long>(random.below(1u << 18)),
+             static_cast<unsigned long long>(random.below(4)));
+    return QByteArray(line);
+}
+
+} // namespace
+
+bool FixtureGenerator::generate(const QString& root, const Scale& scale)
+{
+    const QString proc = root + "/proc";
+    if (!QDir().mkpath(proc + "/net")) {
+        return false;
+    }
+
+    Random random(SEED);
+    const int tcp6Sockets = scale.tcpSockets / 5;
+
+    if (!writeFile(proc + "/stat", procStat(scale, random))
+        || !writeFile(proc + "/meminfo", memInfo(scale))
+        || !writeFile(proc + "/net/dev", netDev(scale, random))
+        || !writeFile(proc + "/net/tcp", netTcp(scale.tcpSockets - tcp6Sockets, false, random))
+        || !writeFile(proc + "/net/tcp6", netTcp(tcp6Sockets, true, random))
+        || !writeFile(proc + "/diskstats", diskStats(scale, random))) {
+        return false;
+    }
+
+    // Ascending pids with gaps, as left behind by exited processes
+    int pid = 0;
+    for (int i = 0; i < scale.pids; ++i) {
+        pid += 1 + static_cast<int>(random.below(3));
+        const QString dir = proc + '/' + QString::number(pid);
+        if (!QDir().mkpath(dir) || !writeFile(dir + "/stat", pidStat(pid, random))) {
+            return false;
+        }
+    }
+
+    return writeFile(root + '/' + STAMP_FILE, stamp(scale));
+}
+
+bool FixtureGenerator::isCurrent(const QString& root, const Scale& scale)
+{
+    QFile file(root + '/' + STAMP_FILE);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.readAll() == stamp(scale);
+}
+
+QByteArray FixtureGenerator::stamp(const Scale& scale)
+{
+    char text[160];
+    snprintf(text, sizeof(text), "%s cores=%d tcp=%d pids=%d disks=%d interfaces=%d format=%d\n",
+             scale.name, scale.cores, scale.tcpSockets, scale.pids, scale.disks, scale.interfaces,
+             FORMAT_VERSION);
+    return QByteArray(text);
+}
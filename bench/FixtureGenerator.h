@@ -0,0 +1,61 @@
+/**
+ * ============================================
+ * File: bench/FixtureGenerator.h
+ * Description: Synthetic /proc trees for the parser benchmarks
+ * ============================================
+ */
+
+#ifndef FIXTUREGENERATOR_H
+#define FIXTUREGENERATOR_H
+
+#include <QString>
+
+/**
+ * @class FixtureGenerator
+ * @brief Writes a /proc-shaped tree at a given scale
+ *
+ * Only the files the collectors parse are written: proc/stat,
+ * proc/meminfo, proc/diskstats, proc/net/dev, proc/net/tcp{,6} and
+ * proc/[pid]/stat, in the kernel's own layout. Values come from a
+ * fixed-seed generator, so a scale always produces byte-identical files
+ * and results from two commits compare like for like.
+ *
+ * The small tree is checked in (bench/fixtures/small); the large one
+ * (~20 MB, 20k directories) is written into the build tree on first use.
+ */
+class FixtureGenerator
+{
+public:
+    struct Scale {
+        const char* name;
+        int cores;
+        int tcpSockets;     // Split 4:1 between tcp and tcp6
+        int pids;
+        int disks;          // Whole disks and partitions, 4 per disk
+        int interfaces;     // Including lo
+    };
+
+    // The target board, and a large server
+    static constexpr Scale SMALL = { "small", 4, 24, 96, 4, 3 };
+    static constexpr Scale LARGE = { "large", 256, 100000, 20000, 64, 32 };
+
+    /**
+     * @brief Write the tree under root (created; existing files replaced)
+     * @return false on the first file that could not be written
+     */
+    static bool generate(const QString& root, const Scale& scale);
+
+    /**
+     * @brief true if root holds a tree generate() wrote at this scale
+     */
+    static bool isCurrent(const QString& root, const Scale& scale);
+
+private:
+    static QByteArray stamp(const Scale& scale);
+
+    // Constants
+    static constexpr const char* STAMP_FILE = "SCALE";
+    static constexpr int FORMAT_VERSION = 1;    // Bump when the output changes
+};
+
+#endif // FIXTUREGENERATOR_H
@@ -0,0 +1,238 @@
+/**
+ * ============================================
+ * File: bench/ParserBench.cpp
+ * Description: Parser benchmark cases and timing loop
+ * ============================================
+ */
+
+#include "ParserBench.h"
+#include "StorageMonitor.h"
+#include "Instrumentation.h"
+#include <QFile>
+#include <QVariantMap>
+#include <dirent.h>
+#include <netinet/tcp.h>
+
+ParserBench::ParserBench(const QString& root)
+    : m_root(root)
+    , m_statFile(path("proc/stat"))
+    , m_memInfoFile(path("proc/meminfo"))
+    , m_netDevFile(path("proc/net/dev"))
+    , m_tcpFile(path("proc/net/tcp"))
+    , m_tcp6File(path("proc/net/tcp6"))
+    , m_diskStatsFile(path("proc/diskstats"))
+    , m_tcpBytes(0)
+    , m_processMonitor(path("proc"))
+    , m_updatesPerPass(1)
+    , m_pidStatBytes(0)
+{
+    // The last interface listed, so the lookup scans the whole file
+    QFile netDev(path("proc/net/dev"));
+    if (netDev.open(QIODevice::ReadOnly)) {
+        for (const QByteArray& line : netDev.readAll().split('\n')) {
+            const qsizetype colon = line.indexOf(':');
+            if (colon > 0 && !line.contains('|')) {
+                m_interface = line.left(colon).trimmed();
+            }
+        }
+    }
+}
+
+QVector<ParserBench::Result> ParserBench::run(const Options& options)
+{
+    qint64 pids = 0;
+    m_pidStatBytes = 0;
+    if (DIR* dir = opendir(QFile::encodeName(path("proc")).constData())) {
+        while (const dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] >= '1' && entry->d_name[0] <= '9') {
+                QFile stat(path("proc") + '/' + QLatin1String(entry->d_name) + "/stat");
+                if (stat.open(QIODevice::ReadOnly)) {
+                    m_pidStatBytes += stat.readAll().size();
+                }
+                ++pids;
+            }
+        }
+        closedir(dir);
+    }
+
+    // An update reads up to SCAN_BUDGET pids; the one after the last pid
+    // reaches the end of the directory and completes the pass
+    m_updatesPerPass = static_cast<int>(pids / App::Process::SCAN_BUDGET) + 1;
+
+    m_tcpBytes = 0;
+    for (ProcFileHandle* file : { &m_tcpFile, &m_tcp6File }) {
+        file->forEachLine(m_tcpChunk, [this](QByteArrayView line) {
+            m_tcpBytes += line.size() + 1;
+        });
+    }
+
+    const Case cases[] = {
+        { "cpu.stat", countLines("proc/stat", 0), [this] { return readProcStat(); } },
+        { "memory.meminfo", countLines("proc/meminfo", 0), [this] { return readMemInfo(); } },
+        { "network.dev", countLines("proc/net/dev", 2), [this] { return readNetDev(); } },
+        { "network.tcp", countLines("proc/net/tcp", 1) + countLines("proc/net/tcp6", 1),
+          [this] { return countTcp(); } },
+        { "storage.diskstats", countLines("proc/diskstats", 0), [this] { return readDiskStats(); } },
+        { "process.update", pids, [this] { return updateProcesses(); } },
+    };
+
+    QVector<Result> results;
+    for (const Case& benchCase : cases) {
+        // A tree without the file (e.g. no tcp6) skips the case
+        if (benchCase.items > 0) {
+            results.append(measure(benchCase, options));
+        }
+    }
+    return results;
+}
+
+ParserBench::Result ParserBench::measure(const Case& benchCase, const Options& options)
+{
+    Result result;
+    result.name = QString::fromLatin1(benchCase.name);
+    result.items = benchCase.items;
+
+    // Warm-up: opens descriptors and sizes buffers, as the first tick does
+    const Op first = benchCase.run();
+    result.bytesPerOp = first.bytes;
+    result.check = first.check;
+
+    qint64 totalNs = 0;
+    qint64 minNs = 0;
+    int iterations = 0;
+    const quint64 allocationsStart = Instrumentation::threadAllocations();
+
+    while (iterations < options.maxIterations
+           && (iterations < options.minIterations || totalNs < options.minTimeNs)) {
+        const qint64 start = Instrumentation::monotonicNs();
+        const Op op = benchCase.run();
+        const qint64 elapsed = Instrumentation::monotonicNs() - start;
+
+        totalNs += elapsed;
+        minNs = (iterations == 0) ? elapsed : qMin(minNs, elapsed);
+        ++iterations;
+
+        // Static input: every op must read and find the same
+        result.check = op.check;
+    }
+
+    const quint64 allocations = Instrumentation::threadAllocations() - allocationsStart;
+
+    result.iterations = iterations;
+    result.nsPerOp = iterations > 0 ? static_cast<double>(totalNs) / iterations : 0.0;
+    result.nsMin = minNs;
+    if (Instrumentation::countsAllocations() && iterations > 0) {
+        result.allocationsPerOp = static_cast<double>(allocations) / iterations;
+    }
+    return result;
+}
+
+ParserBench::Op ParserBench::readProcStat()
+{
+    Op op;
+    if (!m_statFile.read(m_buffer) || !CpuMonitor::parseProcStat(m_buffer.constData(), m_buffer.size(), m_procStat)) {
+        return op;
+    }
+
+    // Aggregate totals, as parseCpuStats() derives them
+    const CpuMonitor::CoreStats& cpu = m_procStat.cores.first();
+    op.bytes = m_buffer.size();
+    op.check = cpu.user + cpu.nice + cpu.system + cpu.idle + cpu.iowait + cpu.irq + cpu.softirq;
+    return op;
+}
+
+ParserBench::Op ParserBench::readMemInfo()
+{
+    Op op;
+    if (!m_memInfoFile.read(m_buffer) || !MemoryMonitor::parseMemInfo(m_buffer.constData(), m_buffer.size(), m_memInfo)) {
+        return op;
+    }
+
+    op.bytes = m_buffer.size();
+    op.check = m_memInfo.usedKb();
+    return op;
+}
+
+ParserBench::Op ParserBench::readNetDev()
+{
+    Op op;
+    NetworkMonitor::NetStats stats;
+    if (!m_netDevFile.read(m_buffer)
+        || !NetworkMonitor::parseNetDev(m_buffer.constData(), m_buffer.size(), m_interface, stats)) {
+        return op;
+    }
+
+    op.bytes = m_buffer.size();
+    op.check = stats.rxBytes + stats.txBytes;
+    return op;
+}
+
+ParserBench::Op ParserBench::countTcp()
+{
+    Op op;
+    NetworkMonitor::TcpStateCounts counts{};
+
+    NetworkMonitor::countTcpStatesProc(m_tcpFile, m_tcpChunk, 1u << TCP_ESTABLISHED, counts);
+    NetworkMonitor::countTcpStatesProc(m_tcp6File, m_tcpChunk, 1u << TCP_ESTABLISHED, counts);
+
+    // Streamed, so the size was measured once up front
+    op.bytes = m_tcpBytes;
+    op.check = static_cast<quint64>(counts[TCP_ESTABLISHED]);
+    return op;
+}
+
+ParserBench::Op ParserBench::readDiskStats()
+{
+    Op op;
+    if (!m_diskStatsFile.read(m_buffer)) {
+        return op;
+    }
+
+    quint64 sectors = 0;
+    StorageMonitor::parseDiskStats(m_buffer.constData(), m_buffer.size(),
+                                   [&](QByteArrayView name, const StorageMonitor::DiskCounters& counters) {
+        if (name.startsWith("loop") || name.startsWith("ram")) {
+            return;
+        }
+        sectors += counters.sectorsRead + counters.sectorsWritten;
+    });
+
+    op.bytes = m_buffer.size();
+    op.check = sectors;
+    return op;
+}
+
+ParserBench::Op ParserBench::updateProcesses()
+{
+    Op op;
+
+    // The warm-up op is the first pass, so every timed op starts at the
+    // top of the directory
+    for (int i = 0; i < m_updatesPerPass; ++i) {
+        m_processMonitor.update();
+    }
+
+    // Streamed pid by pid, so the size was measured once up front
+    op.bytes = m_pidStatBytes;
+    op.check = static_cast<quint64>(m_processMonitor.getProcessCount());
+
+    const QVariantList top = m_processMonitor.getTopByMemory();
+    if (!top.isEmpty()) {
+        op.check += top.first().toMap().value(QStringLiteral("rss")).toULongLong();
+    }
+    return op;
+}
+
+QString ParserBench::path(const char* relative) const
+{
+    return m_root + '/' + QLatin1String(relative);
+}
+
+qint64 ParserBench::countLines(const char* relative, int header) const
+{
+    QFile file(path(relative));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    return qMax<qint64>(0, file.readAll().count('\n') - header);
+}
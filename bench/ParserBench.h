@@ -0,0 +1,131 @@
+/**
+ * ============================================
+ * File: bench/ParserBench.h
+ * Description: Collector read-and-parse paths timed over a fixture tree
+ * ============================================
+ */
+
+#ifndef PARSERBENCH_H
+#define PARSERBENCH_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "CpuMonitor.h"
+#include "MemoryMonitor.h"
+#include "NetworkMonitor.h"
+#include "ProcessMonitor.h"
+#include "FileReader.h"
+
+/**
+ * @class ParserBench
+ * @brief Runs each collector's per-tick read and parse against a /proc tree
+ *
+ * The cases call the monitors' own static parsers through the same
+ * ProcFileHandle reads the monitors do (ProcessMonitor itself, for
+ * processes), with the paths pointed into the fixture tree instead of
+ * /proc:
+ * - cpu.stat: /proc/stat, CpuMonitor::parseProcStat() and the aggregate
+ *   totals of parseCpuStats()
+ * - memory.meminfo: /proc/meminfo, MemoryMonitor::parseMemInfo()
+ * - network.dev: /proc/net/dev, NetworkMonitor::parseNetDev() for the
+ *   last interface listed (a full scan)
+ * - network.tcp: /proc/net/tcp and tcp6 streamed through
+ *   NetworkMonitor::countTcpStatesProc(), parseActiveConnections()'s
+ *   fallback when sock_diag is unavailable
+ * - storage.diskstats: /proc/diskstats, StorageMonitor::parseDiskStats()
+ *   as updateIoStats() runs it
+ * - process.update: one full directory pass of a ProcessMonitor rooted
+ *   in the tree, i.e. as many update() calls as the pass takes: the
+ *   [pid]/stat reads, the table, dropping what the pass missed and
+ *   rank() after every update
+ *
+ * Fixture files are static, so every op reads and parses the same bytes;
+ * page cache makes the reads memory copies, as they are from procfs.
+ */
+class ParserBench
+{
+public:
+    struct Options {
+        qint64 minTimeNs;       // Keep repeating a case for at least this long
+        int minIterations;
+        int maxIterations;
+    };
+
+    struct Result {
+        QString name;
+        qint64 items = 0;               // Cores, sockets, pids, ... one op handles
+        int iterations = 0;
+        double nsPerOp = 0.0;           // Mean
+        qint64 nsMin = 0;
+        double allocationsPerOp = -1.0; // -1 when not counted
+        qint64 bytesPerOp = 0;
+        quint64 check = 0;              // A parsed value; changes if the parse does
+    };
+
+    /**
+     * @param root Directory holding proc/ (a fixture tree, or "/" for live)
+     */
+    explicit ParserBench(const QString& root);
+
+    /**
+     * @brief Time every case whose fixture file exists, in a fixed order
+     */
+    QVector<Result> run(const Options& options);
+
+private:
+    /**
+     * @brief What one op read and found
+     */
+    struct Op {
+        qint64 bytes = 0;
+        quint64 check = 0;
+    };
+
+    struct Case {
+        const char* name;
+        qint64 items;
+        std::function<Op()> run;
+    };
+
+    Result measure(const Case& benchCase, const Options& options);
+
+    Op readProcStat();
+    Op readMemInfo();
+    Op readNetDev();
+    Op countTcp();
+    Op readDiskStats();
+    Op updateProcesses();
+
+    QString path(const char* relative) const;
+
+    /**
+     * @brief Lines of a fixture file, less its header lines
+     */
+    qint64 countLines(const char* relative, int header) const;
+
+private:
+    QString m_root;
+
+    // Handles and buffers kept across ops, as the monitors keep theirs
+    ProcFileHandle m_statFile;
+    ProcFileHandle m_memInfoFile;
+    ProcFileHandle m_netDevFile;
+    ProcFileHandle m_tcpFile;
+    ProcFileHandle m_tcp6File;
+    ProcFileHandle m_diskStatsFile;
+    QByteArray m_buffer;
+    QByteArray m_tcpChunk;
+    qint64 m_tcpBytes;                      // tcp + tcp6, measured by run()
+
+    CpuMonitor::ProcStatSnapshot m_procStat;
+    MemoryMonitor::MemInfoSnapshot m_memInfo;
+    QByteArray m_interface;                 // Last interface in net/dev
+
+    ProcessMonitor m_processMonitor;        // Over proc/, directory passes only
+    int m_updatesPerPass;                   // Measured by run()
+    qint64 m_pidStatBytes;                  // Likewise
+};
+
+#endif // PARSERBENCH_H
@@ -0,0 +1,178 @@
+/**
+ * ============================================================================
+ * File: bench/main.cpp
+ * Description: system-monitor-bench entry point
+ * ============================================================================
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <cstdio>
+
+#include "FixtureGenerator.h"
+#include "ParserBench.h"
+#include "Instrumentation.h"
+
+namespace {
+
+/**
+ * @brief A fixture tree to run, and the name it is reported under
+ */
+struct FixtureSet {
+    QString name;
+    QString root;
+};
+
+const FixtureGenerator::Scale* scaleNamed(const QString& name)
+{
+    if (name == QLatin1String(FixtureGenerator::SMALL.name)) {
+        return &FixtureGenerator::SMALL;
+    }
+    if (name == QLatin1String(FixtureGenerator::LARGE.name)) {
+        return &FixtureGenerator::LARGE;
+    }
+    return nullptr;
+}
+
+QJsonObject toJson(const ParserBench::Result& result)
+{
+    QJsonObject object;
+    object["name"] = result.name;
+    object["items"] = result.items;
+    object["iterations"] = result.iterations;
+    object["nsPerOp"] = qRound64(result.nsPerOp);
+    object["nsPerItem"] = result.items > 0 ? result.nsPerOp / result.items : 0.0;
+    object["nsMin"] = result.nsMin;
+    object["allocationsPerOp"] = result.allocationsPerOp;
+    object["bytesPerOp"] = result.bytesPerOp;
+    object["check"] = QString::number(result.check);   // Beyond a double's 53 bits
+    return object;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("system-monitor-bench");
+    QCoreApplication::setApplicationVersion(APP_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times each collector's /proc parse path over fixture trees "
+                                     "and prints the results as JSON.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption setOption("set", "Fixture set to run: small, large or all (default).", "name", "all");
+    const QCommandLineOption fixturesOption("fixtures", "Run this tree (a directory holding proc/; "
+                                            "\"/\" for the live system) instead of a set.", "dir");
+    const QCommandLineOption minTimeOption("min-time", "Minimum time per case, in ms (default 500).", "ms", "500");
+    const QCommandLineOption outputOption({ "o", "output" }, "Write the JSON here instead of stdout.", "file");
+    const QCommandLineOption generateOption("generate", "Write a fixture tree of --scale into dir and exit.", "dir");
+    const QCommandLineOption scaleOption("scale", "Scale for --generate: small or large.", "name", "small");
+    parser.addOptions({ setOption, fixturesOption, minTimeOption, outputOption, generateOption, scaleOption });
+    parser.process(app);
+
+    if (parser.isSet(generateOption)) {
+        const FixtureGenerator::Scale* scale = scaleNamed(parser.value(scaleOption));
+        if (!scale) {
+            fprintf(stderr, "Unknown scale: %s\n", qPrintable(parser.value(scaleOption)));
+            return 1;
+        }
+        if (!FixtureGenerator::generate(parser.value(generateOption), *scale)) {
+            fprintf(stderr, "Cannot write fixtures to %s\n", qPrintable(parser.value(generateOption)));
+            return 1;
+        }
+        return 0;
+    }
+
+    QVector<FixtureSet> sets;
+    if (parser.isSet(fixturesOption)) {
+        sets.append({ "custom", parser.value(fixturesOption) });
+    }
+    else {
+        const QString set = parser.value(setOption);
+        if (set != "all" && !scaleNamed(set)) {
+            fprintf(stderr, "Unknown set: %s\n", qPrintable(set));
+            return 1;
+        }
+
+        if (set == "all" || set == FixtureGenerator::SMALL.name) {
+            sets.append({ FixtureGenerator::SMALL.name, QString(BENCH_FIXTURE_DIR) + "/small" });
+        }
+        if (set == "all" || set == FixtureGenerator::LARGE.name) {
+            // Too large to check in: generated once into the build tree
+            const QString root = QString(BENCH_GENERATED_DIR) + "/large";
+            if (!FixtureGenerator::isCurrent(root, FixtureGenerator::LARGE)) {
+                fprintf(stderr, "Generating large fixtures in %s...\n", qPrintable(root));
+                QDir(root).removeRecursively();
+                if (!FixtureGenerator::generate(root, FixtureGenerator::LARGE)) {
+                    fprintf(stderr, "Cannot write fixtures to %s\n", qPrintable(root));
+                    return 1;
+                }
+            }
+            sets.append({ FixtureGenerator::LARGE.name, root });
+        }
+    }
+
+    ParserBench::Options options;
+    options.minTimeNs = parser.value(minTimeOption).toLongLong() * 1000000;
+    options.minIterations = 5;
+    options.maxIterations = 1000000;
+
+    QJsonArray setsJson;
+    for (const FixtureSet& set : std::as_const(sets)) {
+        if (!QDir(set.root + "/proc").exists()) {
+            fprintf(stderr, "No proc/ under %s\n", qPrintable(set.root));
+            return 1;
+        }
+
+        ParserBench bench(set.root);
+        const QVector<ParserBench::Result> results = bench.run(options);
+
+        // Human-readable summary on stderr; stdout stays pure JSON
+        fprintf(stderr, "\n[%s]\n%-18s %9s %12s %10s %9s %11s\n", qPrintable(set.name),
+                "case", "items", "ns/op", "ns/item", "allocs/op", "bytes/op");
+
+        QJsonArray casesJson;
+        for (const ParserBench::Result& result : results) {
+            fprintf(stderr, "%-18s %9lld %12.0f %10.1f %9.1f %11lld\n", qPrintable(result.name),
+                    static_cast<long long>(result.items), result.nsPerOp,
+                    result.items > 0 ? result.nsPerOp / result.items : 0.0,
+                    result.allocationsPerOp, static_cast<long long>(result.bytesPerOp));
+            casesJson.append(toJson(result));
+        }
+
+        QJsonObject setJson;
+        setJson["name"] = set.name;
+        setJson["cases"] = casesJson;
+        setsJson.append(setJson);
+    }
+
+    QJsonObject report;
+    report["benchmark"] = "system-monitor-bench";
+    report["version"] = APP_VERSION;
+    report["allocationsCounted"] = Instrumentation::countsAllocations();
+    report["minTimeMs"] = parser.value(minTimeOption).toLongLong();
+    report["sets"] = setsJson;
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+            fprintf(stderr, "Cannot write %s\n", qPrintable(parser.value(outputOption)));
+            return 1;
+        }
+    }
+    else {
+        fwrite(json.constData(), 1, static_cast<size_t>(json.size()), stdout);
+    }
+
+    return 0;
+}
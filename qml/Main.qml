@@ -11,6 +11,7 @@
  *   4. StorageDetail
  *   5. NetworkDetail
  *   6. Settings
+ *   7. ProcessDetail (from CpuDetail)
  */
 
 import QtQuick 2.15
@@ -48,12 +49,20 @@ Window {
         // Initial page
         initialItem: dashboardComponent
 
+        // Tell the controllers which page is on screen; the sampler idles
+        // collectors that only other pages display
+        onCurrentItemChanged: {
+            if (currentItem) {
+                navigation.currentIndex = root._pageIndex(currentItem.objectName)
+            }
+        }
+
         // Dashboard component
         Component {
             id: dashboardComponent
             
             Dashboard {
-
+                objectName: "dashboard"
             }
         }
 
@@ -135,6 +144,11 @@ Window {
             stackView.push(settingsComponent)
         }
 
+        // Handle the process table link on CpuDetail
+        function onProcessesRequested() {
+            stackView.push(processDetailComponent)
+        }
+
         // Handle bottom nav clicks
         function onNavigationRequested(index) {
             // Pop to dashboard first
@@ -149,6 +163,19 @@ Window {
     }
     
     // ==================== PAGE COMPONENTS ====================
+
+    // objectName -> App::NavIndex
+    function _pageIndex(name) {
+        switch (name) {
+        case "cpuDetail":     return 1
+        case "memoryDetail":  return 2
+        case "storageDetail": return 3
+        case "networkDetail": return 4
+        case "settings":      return 5
+        case "processDetail": return 6
+        default:              return 0
+        }
+    }
     
     Component {
         id: cpuDetailComponent
@@ -184,6 +211,13 @@ Window {
             objectName: "settings"
         }
     }
+    
+    Component {
+        id: processDetailComponent
+        ProcessDetail {
+            objectName: "processDetail"
+        }
+    }
 
     // ==================== KEYBOARD SHORTCUTS (Desktop Testing) ====================
     
@@ -225,6 +259,12 @@ Window {
                 stackView.push(networkDetailComponent)
                 event.accepted = true
             }
+            else if (event.key === Qt.Key_5) {
+                stackView.pop(null)
+                stackView.push(cpuDetailComponent)
+                stackView.push(processDetailComponent)
+                event.accepted = true
+            }
             else if (event.key === Qt.Key_9) {
                 stackView.push(settingsComponent)
                 event.accepted = true
@@ -0,0 +1,46 @@
+/*
+ * ============================================
+ * File: qml/views/components/HistoryChart.qml
+ * Description: LineChart showing either the live series or an archived range
+ * ============================================
+ */
+
+import QtQuick 2.15
+
+// range 0 draws liveModel; any other range (seconds) draws the persistent
+// archive from systemInfo.archivedHistory(metric, ...), re-read while
+// visible since archived buckets only change every few seconds.
+LineChart {
+    id: root
+
+    // ==================== PROPERTIES ====================
+
+    property var liveModel: null
+    property string metric: ""
+    property int range: 0
+    property int refreshInterval: 10000
+
+    model: root.range === 0 ? root.liveModel : null
+
+    // ==================== ARCHIVE ====================
+
+    function reload() {
+        if (root.range > 0) {
+            // About one point per two pixels is all the panel can show
+            root.dataPoints = systemInfo.archivedHistory(root.metric, root.range,
+                                                         Math.max(2, Math.floor(root.width / 2)))
+        } else {
+            root.dataPoints = []
+        }
+    }
+
+    onRangeChanged: reload()
+    onVisibleChanged: if (visible) reload()
+
+    Timer {
+        interval: root.refreshInterval
+        repeat: true
+        running: root.range > 0 && root.visible
+        onTriggered: root.reload()
+    }
+}
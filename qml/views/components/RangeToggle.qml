@@ -0,0 +1,48 @@
+/*
+ * ============================================
+ * File: qml/views/components/RangeToggle.qml
+ * Description: Tap-to-cycle chart range selector (LIVE / 1H / 24H / 30D)
+ * ============================================
+ */
+
+import QtQuick 2.15
+
+Rectangle {
+    id: root
+
+    // ==================== PROPERTIES ====================
+
+    width: 30
+    height: 14
+    radius: 3
+    color: root.index > 0 ? "#2196F3" : Qt.rgba(1, 1, 1, 0.1)
+
+    property int index: 0
+
+    // Seconds of history per step, 0 = the live in-memory series
+    readonly property var ranges: [0, 3600, 86400, 2592000]
+    readonly property var labels: ["LIVE", "1H", "24H", "30D"]
+    readonly property int range: ranges[index]
+
+    // ==================== LABEL ====================
+
+    Text {
+        anchors.centerIn: parent
+        text: root.labels[root.index]
+        font.family: "DejaVu Sans"
+        font.pixelSize: 7
+        font.bold: true
+        color: "#FFFFFF"
+        renderType: Text.NativeRendering
+        antialiasing: false
+        font.hintingPreference: Font.PreferFullHinting
+    }
+
+    // ==================== INTERACTION ====================
+
+    MouseArea {
+        anchors.fill: parent
+        anchors.margins: -4     // Larger touch target than the label
+        onClicked: root.index = (root.index + 1) % root.ranges.length
+    }
+}
@@ -20,6 +20,32 @@ Rectangle {
     signal backRequested()
     signal settingsRequested()
     signal navigationRequested(int index)
+    signal processesRequested()
+
+    // ==================== PERCENTILES ====================
+
+    // CPU usage spread over the last 5 minutes; bursts that a 60-point
+    // line or an average would hide show up in p95/p99
+    property int percentileWindow: 300
+    property real cpuP50: -1
+    property real cpuP95: -1
+    property real cpuP99: -1
+
+    function percentText(value) {
+        return value < 0 ? "--" : Math.round(value) + "%"
+    }
+
+    Timer {
+        interval: 5000
+        repeat: true
+        running: root.visible
+        triggeredOnStart: true
+        onTriggered: {
+            root.cpuP50 = systemInfo.percentile("cpuUsage", 0.50, root.percentileWindow)
+            root.cpuP95 = systemInfo.percentile("cpuUsage", 0.95, root.percentileWindow)
+            root.cpuP99 = systemInfo.percentile("cpuUsage", 0.99, root.percentileWindow)
+        }
+    }
 
     // ==================== HEADER ====================
     DetailHeader {
@@ -87,14 +113,25 @@ Rectangle {
                     }
                 }
 
-                LineChart {
+                HistoryChart {
                     width: parent.width
                     height: 50
-                    dataPoints: systemInfo.tempHistory
+                    liveModel: systemInfo.tempHistoryModel
+                    metric: "cpuTemp"
+                    range: tempRange.range
                     maxValue: 100
                     lineColor: "#FF5722"
                 }
             }   
+
+            RangeToggle {
+                id: tempRange
+                anchors {
+                    top: parent.top
+                    right: parent.right
+                    margins: 6
+                }
+            }
         }
 
         // ==================== CORE USAGE BARS ====================
@@ -118,25 +155,73 @@ Rectangle {
                 anchors.margins: 8
                 spacing: 4
 
-                Text {
-                    text: "Per-Core Usage"
-                    font.family: "DejaVu Sans"
-                    font.pixelSize: 10
-                    font.bold: true
-                    color: "#FFFFFF"
-                    renderType: Text.NativeRendering
+                Row {
+                    spacing: 6
+
+                    Text {
+                        text: "Per-Core Usage"
+                        font.family: "DejaVu Sans"
+                        font.pixelSize: 10
+                        font.bold: true
+                        color: "#FFFFFF"
+                        renderType: Text.NativeRendering
+                    }
+
+                    // Link to the top-processes table
+                    Rectangle {
+                        width: 30
+                        height: 14
+                        radius: 3
+                        color: "#2196F3"
+
+                        Text {
+                            anchors.centerIn: parent
+                            text: "TOP ›"
+                            font.family: "DejaVu Sans"
+                            font.pixelSize: 7
+                            font.bold: true
+                            color: "#FFFFFF"
+                            renderType: Text.NativeRendering
+                            antialiasing: false
+                            font.hintingPreference: Font.PreferFullHinting
+                        }
+
+                        MouseArea {
+                            anchors.fill: parent
+                            anchors.margins: -4     // Larger touch target than the label
+                            onClicked: root.processesRequested()
+                        }
+                    }
                 }
 
                 Repeater {
-                    model: systemInfo.coreUsages
+                    model: systemInfo.coreUsageModel
 
                     CoreUsageBar {
                         width: 288
                         coreIndex: index
-                        usage: modelData
+                        usage: model.usage
                     }
                 }
             }
+
+            Text {
+                anchors {
+                    top: parent.top
+                    right: parent.right
+                    topMargin: 9
+                    rightMargin: 8
+                }
+                text: "5m  p50 " + root.percentText(root.cpuP50)
+                    + "  p95 " + root.percentText(root.cpuP95)
+                    + "  p99 " + root.percentText(root.cpuP99)
+                font.family: "DejaVu Sans"
+                font.pixelSize: 8
+                color: "#B0B8C8"
+                renderType: Text.NativeRendering
+                antialiasing: false
+                font.hintingPreference: Font.PreferFullHinting
+            }
         }
     }
 
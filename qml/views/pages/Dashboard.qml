@@ -6,6 +6,7 @@
 
 import QtQuick 2.15
 import "../components"
+import SystemMonitor.Units 1.0
 
 Rectangle {
     id: root
@@ -133,7 +134,7 @@ Rectangle {
                     Text {
                         anchors.bottom: parent.bottom
                         anchors.horizontalCenter: parent.horizontalCenter
-                        text: "CLK " + systemInfo.cpuClock
+                        text: "CLK " + UnitFormatter.frequency(systemInfo.cpuClock, UnitFormatter.CpuClock)
                         font.pixelSize: 8
                         font.bold: true
                         font.family: "DejaVu Sans"
@@ -242,7 +243,7 @@ Rectangle {
                     Text {
                         anchors.bottom: parent.bottom
                         anchors.horizontalCenter: parent.horizontalCenter
-                        text: "MEM " + systemInfo.gpuMemUsage + "M"
+                        text: "MEM " + UnitFormatter.megabytes(systemInfo.gpuMemUsage, UnitFormatter.GpuMem)
                         font.pixelSize: 8
                         font.bold: true
                         font.family: "DejaVu Sans"
@@ -384,7 +385,7 @@ Rectangle {
                             anchors.horizontalCenter: parent.horizontalCenter
                         }
                         Text {
-                            text: systemInfo.ramUsed
+                            text: UnitFormatter.megabytes(systemInfo.ramUsed, UnitFormatter.RamUsed)
                             font.pixelSize: 9
                             font.bold: true
                             font.family: "DejaVu Sans"
@@ -404,7 +405,7 @@ Rectangle {
                     Text {
                         anchors.bottom: parent.bottom
                         anchors.horizontalCenter: parent.horizontalCenter
-                        text: "FREE " + systemInfo.ramFree
+                        text: "FREE " + UnitFormatter.megabytes(systemInfo.ramFree, UnitFormatter.RamFree)
                         font.pixelSize: 8
                         font.bold: true
                         font.family: "DejaVu Sans"
@@ -521,7 +522,7 @@ Rectangle {
                             antialiasing: false
                         }
                         Text {
-                            text: "↓" + systemInfo.net
+                            text: "↓" + UnitFormatter.rate(systemInfo.netDownSpeed, UnitFormatter.NetDown)
                             font.pixelSize: 7
                             font.bold: true
                             font.family: "DejaVu Sans"
@@ -531,7 +532,7 @@ Rectangle {
                             antialiasing: false
                         }
                         Text {
-                            text: "↑" + systemInfo.netUp
+                            text: "↑" + UnitFormatter.rate(systemInfo.netUpSpeed, UnitFormatter.NetUp)
                             font.pixelSize: 7
                             font.bold: true
                             font.family: "DejaVu Sans"
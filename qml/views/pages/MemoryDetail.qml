@@ -7,6 +7,7 @@
 
 import QtQuick 2.15
 import "../components"
+import SystemMonitor.Units 1.0
 
 Rectangle {
     id: root
@@ -27,7 +28,6 @@ Rectangle {
     
     property int mockRamUsage: 73            // RAM usage percentage
     property string mockRamUsed: "410MB"     // RAM used
-    property string mockRamTotal: "485MB"    // Total RAM
     property string mockRamFree: "75MB"      // Free RAM
     property string mockCache: "80MB"        // Cache size
     
@@ -227,7 +227,7 @@ Rectangle {
                 
                 // Used memory text
                 Text {
-                    text: "Used: " + systemInfo.ramUsed + " / " + root.mockRamTotal
+                    text: "Used: " + UnitFormatter.megabytes(systemInfo.ramUsed, UnitFormatter.RamUsed) + " / " + UnitFormatter.megabytes(systemInfo.ramTotal, UnitFormatter.RamTotal)
                     font.family: "DejaVu Sans"
                     font.pixelSize: 10
                     color: "#FFFFFF"
@@ -241,7 +241,7 @@ Rectangle {
                     spacing: 10
 
                     Text {
-                        text: "Free: " + systemInfo.ramFree
+                        text: "Free: " + UnitFormatter.megabytes(systemInfo.ramFree, UnitFormatter.RamFree)
                         font.family: "DejaVu Sans"
                         font.pixelSize: 8
                         color: "#B0B8C8"
@@ -251,7 +251,7 @@ Rectangle {
                     }
 
                     Text {
-                        text: "Cache: " + systemInfo.ramCache
+                        text: "Cache: " + UnitFormatter.megabytes(systemInfo.ramCache, UnitFormatter.RamCache)
                         font.family: "DejaVu Sans"
                         font.pixelSize: 8
                         color: "#B0B8C8"
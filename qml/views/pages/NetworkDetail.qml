@@ -8,6 +8,7 @@
 
 import QtQuick 2.15
 import "../components"
+import SystemMonitor.Units 1.0
 import ".." as Root
 
 Rectangle {
@@ -51,23 +52,53 @@ Rectangle {
     property string mockPacketRate: "0 pps"
     property int mockActiveConnections: 7
 
+    // ==================== PERCENTILES ====================
+
+    // Traffic spread over the last 5 minutes, in bytes/s; -1 = no samples
+    property int percentileWindow: 300
+    property real upP95: -1
+    property real upP99: -1
+    property real downP95: -1
+    property real downP99: -1
+
+    function rateText(value) {
+        return value < 0 ? "--" : UnitFormatter.rate(value)
+    }
+
+    Timer {
+        interval: 5000
+        repeat: true
+        running: root.visible
+        triggeredOnStart: true
+        onTriggered: {
+            root.upP95 = systemInfo.percentile("netUp", 0.95, root.percentileWindow)
+            root.upP99 = systemInfo.percentile("netUp", 0.99, root.percentileWindow)
+            root.downP95 = systemInfo.percentile("netDown", 0.95, root.percentileWindow)
+            root.downP99 = systemInfo.percentile("netDown", 0.99, root.percentileWindow)
+        }
+    }
+
     // ==================== DEBUG ====================
     Component.onCompleted: {
         if (QML_DEBUG_ENABLED) console.log("=== NetworkDetail DEBUG ===")
         if (QML_DEBUG_ENABLED) console.log("Interface:", systemInfo.networkInterface)
         if (QML_DEBUG_ENABLED) console.log("IP:", systemInfo.ipAddress)
         if (QML_DEBUG_ENABLED) console.log("MAC:", systemInfo.macAddress)
-        if (QML_DEBUG_ENABLED) console.log("Upload history length:", systemInfo.netUpHistory.length)
-        if (QML_DEBUG_ENABLED) console.log("Download history length:", systemInfo.netDownHistory.length)
+        if (QML_DEBUG_ENABLED) console.log("Upload history length:", systemInfo.netUpHistoryModel.count)
+        if (QML_DEBUG_ENABLED) console.log("Download history length:", systemInfo.netDownHistoryModel.count)
     }
 
     Connections {
-        target: systemInfo
-        function onNetUpHistoryChanged() {
-            if (QML_DEBUG_ENABLED) console.log("Upload history updated, length:", systemInfo.netUpHistory.length)
+        target: systemInfo.netUpHistoryModel
+        function onCountChanged() {
+            if (QML_DEBUG_ENABLED) console.log("Upload history updated, length:", systemInfo.netUpHistoryModel.count)
         }
-        function onNetDownHistoryChanged() {
-            if (QML_DEBUG_ENABLED) console.log("Download history updated, length:", systemInfo.netDownHistory.length)
+    }
+
+    Connections {
+        target: systemInfo.netDownHistoryModel
+        function onCountChanged() {
+            if (QML_DEBUG_ENABLED) console.log("Download history updated, length:", systemInfo.netDownHistoryModel.count)
         }
     }
 
@@ -180,6 +211,16 @@ Rectangle {
             border.width: 1
             border.color: Qt.rgba(1, 1, 1, 0.1)
 
+            RangeToggle {
+                id: trafficRange
+                anchors {
+                    top: parent.top
+                    right: parent.right
+                    margins: 4
+                }
+                height: 10
+            }
+
             Column {
                 anchors.fill: parent
                 anchors.margins: 6
@@ -203,18 +244,22 @@ Rectangle {
                     height: 40
 
                     // Download line (behind, orange)
-                    LineChart {
+                    HistoryChart {
                         anchors.fill: parent
-                        dataPoints: systemInfo.netDownHistory
+                        liveModel: systemInfo.netDownHistoryModel
+                        metric: "netDown"
+                        range: trafficRange.range
                         lineColor: "#FF9800"  // Orange for download
                         smoothLine: true
                         lineWidth: 2
                     }
 
                     // Upload line (behind, cyan)
-                    LineChart {
+                    HistoryChart {
                         anchors.fill: parent
-                        dataPoints: systemInfo.netUpHistory
+                        liveModel: systemInfo.netUpHistoryModel
+                        metric: "netUp"
+                        range: trafficRange.range
                         lineColor: "#00BCD4"  // Orange for download
                         smoothLine: true
                         lineWidth: 2
@@ -293,7 +338,7 @@ Rectangle {
                 spacing: 10
 
                 Text {
-                    text: "↑ Up: " + systemInfo.netUpSpeed
+                    text: "↑ Up: " + UnitFormatter.rate(systemInfo.netUpSpeed, UnitFormatter.NetUp)
                     font.family: "DejaVu Sans"
                     font.pixelSize: 10
                     color: "#00BCD4"
@@ -303,7 +348,7 @@ Rectangle {
                 }
 
                 Text {
-                    text: "↓ Down: " + systemInfo.netDownSpeed
+                    text: "↓ Down: " + UnitFormatter.rate(systemInfo.netDownSpeed, UnitFormatter.NetDown)
                     font.family: "DejaVu Sans"
                     font.pixelSize: 10
                     color: "#FF9800"
@@ -318,7 +363,7 @@ Rectangle {
                 spacing: 12
 
                 Text {
-                    text: "Packets: " + systemInfo.packetRate
+                    text: "Packets: " + UnitFormatter.packetRate(systemInfo.packetRate, UnitFormatter.PacketRate)
                     font.family: "DejaVu Sans"
                     font.pixelSize: 8
                     color: "#B0B8C8"
@@ -337,6 +382,31 @@ Rectangle {
                     font.hintingPreference: Font.PreferFullHinting
                 }
             }
+
+            // 5-minute p95 / p99
+            Row {
+                spacing: 12
+
+                Text {
+                    text: "↑ p95 " + root.rateText(root.upP95) + "  p99 " + root.rateText(root.upP99)
+                    font.family: "DejaVu Sans"
+                    font.pixelSize: 8
+                    color: "#00BCD4"
+                    renderType: Text.NativeRendering
+                    antialiasing: false
+                    font.hintingPreference: Font.PreferFullHinting
+                }
+
+                Text {
+                    text: "↓ p95 " + root.rateText(root.downP95) + "  p99 " + root.rateText(root.downP99)
+                    font.family: "DejaVu Sans"
+                    font.pixelSize: 8
+                    color: "#FF9800"
+                    renderType: Text.NativeRendering
+                    antialiasing: false
+                    font.hintingPreference: Font.PreferFullHinting
+                }
+            }
         }
     }
 
@@ -0,0 +1,223 @@
+/*
+ * ============================================
+ * File: qml/views/pages/ProcessDetail.qml
+ * Description: Top processes by CPU or resident memory
+ * ============================================
+ */
+
+import QtQuick 2.15
+import "../components"
+import SystemMonitor.Units 1.0
+
+Rectangle {
+    id: root
+
+    // ==================== PROPERTIES ====================
+    width: 320
+    height: 240
+    color: "#0F1419"
+
+    // false = ranked by CPU%, true = by resident memory
+    property bool sortByMemory: false
+
+    // ==================== SIGNALS FOR NAVIGATION ====================
+    signal backRequested()
+    signal settingsRequested()
+    signal navigationRequested(int index)
+
+    // ==================== HEADER ====================
+    DetailHeader {
+        id: header
+        anchors {
+            top: parent.top
+            left: parent.left
+            right: parent.right
+        }
+        title: "PROCESSES"
+
+        onBackClicked: root.backRequested()
+        onSettingsClicked: root.settingsRequested()
+    }
+
+    // ==================== CONTENT AREA ====================
+
+    Item {
+        id: contentArea
+        anchors {
+            top: header.bottom
+            left: parent.left
+            right: parent.right
+            bottom: parent.bottom
+            bottomMargin: 55
+        }
+
+        Rectangle {
+            id: tableCard
+            anchors {
+                horizontalCenter: parent.horizontalCenter
+                top: parent.top
+                topMargin: 4
+            }
+            width: 304
+            height: 149
+            radius: 6
+            color: "#1E2539"
+            border.width: 1
+            border.color: Qt.rgba(1, 1, 1, 0.1)
+
+            Column {
+                anchors.fill: parent
+                anchors.margins: 5
+
+                // Title, process count and sort toggle
+                Item {
+                    width: parent.width
+                    height: 14
+
+                    Text {
+                        anchors.verticalCenter: parent.verticalCenter
+                        text: "Top by " + (root.sortByMemory ? "Memory" : "CPU")
+                              + "  (" + systemInfo.processCount + " running)"
+                        font.family: "DejaVu Sans"
+                        font.pixelSize: 10
+                        font.bold: true
+                        color: "#FFFFFF"
+                        renderType: Text.NativeRendering
+                    }
+
+                    Rectangle {
+                        anchors {
+                            right: parent.right
+                            verticalCenter: parent.verticalCenter
+                        }
+                        width: 30
+                        height: 14
+                        radius: 3
+                        color: "#2196F3"
+
+                        Text {
+                            anchors.centerIn: parent
+                            text: root.sortByMemory ? "MEM" : "CPU"
+                            font.family: "DejaVu Sans"
+                            font.pixelSize: 7
+                            font.bold: true
+                            color: "#FFFFFF"
+                            renderType: Text.NativeRendering
+                            antialiasing: false
+                            font.hintingPreference: Font.PreferFullHinting
+                        }
+
+                        MouseArea {
+                            anchors.fill: parent
+                            anchors.margins: -4     // Larger touch target than the label
+                            onClicked: root.sortByMemory = !root.sortByMemory
+                        }
+                    }
+                }
+
+                // Column headings
+                ProcessRow {
+                    pid: "PID"
+                    name: "NAME"
+                    cpu: "CPU%"
+                    rss: "RSS"
+                    textColor: "#B0B8C8"
+                }
+
+                Repeater {
+                    model: root.sortByMemory ? systemInfo.topMemoryProcesses
+                                             : systemInfo.topCpuProcesses
+
+                    ProcessRow {
+                        pid: modelData.pid
+                        name: modelData.name
+                        cpu: modelData.cpu.toFixed(1)
+                        rss: UnitFormatter.size(modelData.rss)
+                        textColor: "#FFFFFF"
+                    }
+                }
+            }
+
+            // Lifecycle rates; exec is only known from proc connector events
+            Text {
+                anchors {
+                    left: parent.left
+                    bottom: parent.bottom
+                    margins: 5
+                }
+                text: "fork " + systemInfo.forkRate.toFixed(1) + "/s"
+                      + (systemInfo.processEvents ? "  exec " + systemInfo.execRate.toFixed(1) + "/s" : "")
+                      + "  exit " + systemInfo.exitRate.toFixed(1) + "/s"
+                      + (systemInfo.processEvents ? "  (events)" : "  (/proc scan)")
+                font.family: "DejaVu Sans"
+                font.pixelSize: 8
+                color: "#B0B8C8"
+                renderType: Text.NativeRendering
+                antialiasing: false
+                font.hintingPreference: Font.PreferFullHinting
+            }
+        }
+    }
+
+    // ==================== ROW ====================
+
+    component ProcessRow: Row {
+        property string pid
+        property string name
+        property string cpu
+        property string rss
+        property color textColor
+
+        height: 12
+
+        Text {
+            width: 44
+            text: parent.pid
+            font.family: "DejaVu Sans Mono"
+            font.pixelSize: 9
+            color: parent.textColor
+            renderType: Text.NativeRendering
+        }
+        Text {
+            width: 136
+            text: parent.name
+            elide: Text.ElideRight
+            font.family: "DejaVu Sans Mono"
+            font.pixelSize: 9
+            color: parent.textColor
+            renderType: Text.NativeRendering
+        }
+        Text {
+            width: 48
+            text: parent.cpu
+            horizontalAlignment: Text.AlignRight
+            font.family: "DejaVu Sans Mono"
+            font.pixelSize: 9
+            color: parent.textColor
+            renderType: Text.NativeRendering
+        }
+        Text {
+            width: 64
+            text: parent.rss
+            horizontalAlignment: Text.AlignRight
+            font.family: "DejaVu Sans Mono"
+            font.pixelSize: 9
+            color: parent.textColor
+            renderType: Text.NativeRendering
+        }
+    }
+
+    // ==================== BOTTOM NAVIGATION ====================
+
+    BottomNav {
+        id: bottomNav
+        anchors.bottom: parent.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        currentIndex: 1
+
+        onNavigationRequested: function(index) {
+            root.navigationRequested(index)
+        }
+    }
+}
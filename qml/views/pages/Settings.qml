@@ -65,7 +65,7 @@ Rectangle {
             left: parent.left
             right: parent.right
         }
-        tabs: ["System", "Monitor", "Warning", "Logs"]
+        tabs: ["System", "Monitor", "Warning", "Logs", "Perf"]
         currentIndex: 0
 
         onTabClicked: function(index) {
@@ -81,7 +81,7 @@ Rectangle {
             top: tabBar.bottom
             left: parent.left
             right: parent.right
-            bottom: tabBar.currentIndex === 0 ? bottomNav.top : saveButton.top
+            bottom: saveButton.visible ? saveButton.top : bottomNav.top
             margins: 8
         }
 
@@ -189,6 +189,48 @@ Rectangle {
                 }
             }
 
+            // Log level (tap to cycle, up to the level compiled in)
+            Row {
+                width: parent.width
+                spacing: 10
+                visible: systemInfo.maxLogLevel > 0
+
+                Text {
+                    text: "Log Level:"
+                    font.family: "DejaVu Sans"
+                    font.pixelSize: 9
+                    color: "#FFFFFF"
+                    anchors.verticalCenter: parent.verticalCenter
+                    renderType: Text.NativeRendering
+                    antialiasing: false
+                    font.hintingPreference: Font.PreferFullHinting
+                }
+
+                Rectangle {
+                    width: 60
+                    height: 24
+                    radius: 4
+                    color: "#1E2539"
+                    border.width: 1
+                    border.color: Qt.rgba(1, 1, 1, 0.2)
+
+                    Text {
+                        anchors.centerIn: parent
+                        text: ["OFF", "CRIT", "ERROR", "WARN", "INFO", "DEBUG"][systemInfo.logLevel]
+                        font.pixelSize: 9
+                        color: "#FFFFFF"
+                        renderType: Text.NativeRendering
+                        antialiasing: false
+                        font.hintingPreference: Font.PreferFullHinting
+                    }
+
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: systemInfo.logLevel = (systemInfo.logLevel + 1) % (systemInfo.maxLogLevel + 1)
+                    }
+                }
+            }
+
             // Removed Dark Mode toggle
         }
 
@@ -383,6 +425,119 @@ Rectangle {
                 }
             }
         }
+
+        // ==================== TAB 5: INSTRUMENTATION ====================
+
+        Column {
+            anchors.fill: parent
+            spacing: 4
+            visible: tabBar.currentIndex === 4
+
+            Item {
+                width: parent.width
+                height: 14
+
+                Text {
+                    anchors.verticalCenter: parent.verticalCenter
+                    text: "Stage timings (\u00B5s, wall / CPU)"
+                    font.family: "DejaVu Sans"
+                    font.pixelSize: 10
+                    font.bold: true
+                    color: "#FFFFFF"
+                    renderType: Text.NativeRendering
+                }
+
+                // Only with SYSMON_TRACE: write the timeline recorded so far
+                Rectangle {
+                    anchors {
+                        right: resetButton.left
+                        rightMargin: 6
+                        verticalCenter: parent.verticalCenter
+                    }
+                    width: 36
+                    height: 14
+                    radius: 3
+                    color: "#4CAF50"
+                    visible: systemInfo.tracing
+
+                    Text {
+                        anchors.centerIn: parent
+                        text: "TRACE"
+                        font.family: "DejaVu Sans"
+                        font.pixelSize: 7
+                        font.bold: true
+                        color: "#FFFFFF"
+                        renderType: Text.NativeRendering
+                        antialiasing: false
+                        font.hintingPreference: Font.PreferFullHinting
+                    }
+
+                    MouseArea {
+                        anchors.fill: parent
+                        anchors.margins: -4
+                        onClicked: systemInfo.dumpTrace()
+                    }
+                }
+
+                Rectangle {
+                    id: resetButton
+                    anchors {
+                        right: parent.right
+                        verticalCenter: parent.verticalCenter
+                    }
+                    width: 36
+                    height: 14
+                    radius: 3
+                    color: "#2196F3"
+
+                    Text {
+                        anchors.centerIn: parent
+                        text: "RESET"
+                        font.family: "DejaVu Sans"
+                        font.pixelSize: 7
+                        font.bold: true
+                        color: "#FFFFFF"
+                        renderType: Text.NativeRendering
+                        antialiasing: false
+                        font.hintingPreference: Font.PreferFullHinting
+                    }
+
+                    MouseArea {
+                        anchors.fill: parent
+                        anchors.margins: -4
+                        onClicked: systemInfo.resetInstrumentation()
+                    }
+                }
+            }
+
+            StageRow {
+                stage: "STAGE"
+                wallP50: "p50"
+                wallP99: "p99"
+                wallMax: "max"
+                cpuP50: "cpu50"
+                allocations: systemInfo.countsAllocations ? "alloc" : ""
+                textColor: "#B0B8C8"
+            }
+
+            ListView {
+                width: parent.width
+                height: parent.height - 34
+                clip: true
+                // Only read (and rebuilt every second) while the tab is open
+                model: tabBar.currentIndex === 4 ? systemInfo.instrumentation : []
+
+                delegate: StageRow {
+                    stage: modelData.name
+                    wallP50: modelData.wallP50
+                    wallP99: modelData.wallP99
+                    wallMax: modelData.wallMax
+                    cpuP50: modelData.cpuP50
+                    allocations: modelData.allocations >= 0 ? modelData.allocations.toFixed(1) : ""
+                    textColor: modelData.calls > 0 ? "#FFFFFF" : "#B0B8C8"
+                }
+            }
+        }
     }
 
     // ==================== SAVE BUTTON ====================
@@ -398,7 +553,7 @@ Rectangle {
         height: 24
         text: "Save Changes"
         buttonColor: "#4CAF50"  // Green
-        visible: tabBar.currentIndex !== 0  // Hide on System tab (index 0)
+        visible: tabBar.currentIndex !== 0 && tabBar.currentIndex !== 4  // Nothing to save on System/Perf
 
         onClicked: {
             if (QML_DEBUG_ENABLED) console.log("Saving settings...")
@@ -471,4 +626,39 @@ Rectangle {
             renderType: Text.NativeRendering
         }
     }
+
+    component StageRow: Row {
+        property string stage
+        property string wallP50
+        property string wallP99
+        property string wallMax
+        property string cpuP50
+        property string allocations
+        property color textColor
+
+        height: 12
+
+        Text {
+            width: 84
+            text: parent.stage
+            elide: Text.ElideRight
+            font.family: "DejaVu Sans Mono"
+            font.pixelSize: 8
+            color: parent.textColor
+            renderType: Text.NativeRendering
+        }
+        Repeater {
+            model: [parent.wallP50, parent.wallP99, parent.wallMax, parent.cpuP50, parent.allocations]
+
+            Text {
+                width: 42
+                text: modelData
+                horizontalAlignment: Text.AlignRight
+                font.family: "DejaVu Sans Mono"
+                font.pixelSize: 8
+                color: textColor
+                renderType: Text.NativeRendering
+            }
+        }
+    }
 }
@@ -7,6 +7,7 @@
 
 import QtQuick 2.15
 import "../components"
+import SystemMonitor.Units 1.0
 
 Rectangle {
     id: root
@@ -46,6 +47,13 @@ Rectangle {
         25, 29, 26, 31, 27, 32, 28, 30, 26, 28
     ]
 
+    // ==================== FUNCTIONS ====================
+
+    // KB/s to a short "12K"/"3.4M" label
+    function formatRate(kbs) {
+        return kbs >= 1024 ? (kbs / 1024).toFixed(1) + "M" : kbs.toFixed(0) + "K"
+    }
+
     // ==================== HEADER ====================
 
     DetailHeader {
@@ -91,10 +99,10 @@ Rectangle {
             PartitionBar {
                 width: 304
                 partitionName: root.mockRootName
-                totalSize: systemInfo.hddTotal
+                totalSize: UnitFormatter.size(systemInfo.hddTotal, UnitFormatter.HddTotal)
                 usage: systemInfo.hddUsage
-                usedSize: systemInfo.hddUsed
-                freeSize: systemInfo.hddFree
+                usedSize: UnitFormatter.size(systemInfo.hddUsed, UnitFormatter.HddUsed)
+                freeSize: UnitFormatter.size(systemInfo.hddFree, UnitFormatter.HddFree)
             }
 
             // ==================== SWAP PARTITION ====================
@@ -102,10 +110,10 @@ Rectangle {
             PartitionBar {
                 width: 304
                 partitionName: root.mockSwapName
-                totalSize: systemInfo.swapTotal
+                totalSize: UnitFormatter.size(systemInfo.swapTotal, UnitFormatter.SwapTotal)
                 usage: systemInfo.swapUsage
-                usedSize: systemInfo.swapUsed
-                freeSize: systemInfo.swapFree
+                usedSize: UnitFormatter.size(systemInfo.swapUsed, UnitFormatter.SwapUsed)
+                freeSize: UnitFormatter.size(systemInfo.swapFree, UnitFormatter.SwapFree)
             }
 
             // ==================== I/O STATISTICS CARD ====================
@@ -136,14 +144,26 @@ Rectangle {
                     }
 
                     // Mini chart
-                    LineChart {
+                    HistoryChart {
                         width: 288
                         height: 20
-                        dataPoints: systemInfo.ioHistory
+                        liveModel: systemInfo.ioHistoryModel
+                        metric: "diskIo"
+                        range: ioRange.range
                         lineColor: "#FFEB3B"  // Yellow for I/O
                         smoothLine: true
                     }
                 }
+
+                RangeToggle {
+                    id: ioRange
+                    anchors {
+                        top: parent.top
+                        right: parent.right
+                        margins: 2
+                    }
+                    height: 10
+                }
             }
 
             // ==================== I/O SPEEDS ====================
@@ -153,7 +173,7 @@ Rectangle {
                 spacing: 10
 
                 Text {
-                    text: "Read: " + systemInfo.ioRead
+                    text: "Read: " + UnitFormatter.rate(systemInfo.ioRead, UnitFormatter.IoRead)
                     font.family: "DejaVu Sans"
                     font.pixelSize: 8
                     color: "#B0B8C8"
@@ -163,7 +183,7 @@ Rectangle {
                 }
 
                 Text {
-                    text: "Write: " + systemInfo.ioWrite
+                    text: "Write: " + UnitFormatter.rate(systemInfo.ioWrite, UnitFormatter.IoWrite)
                     font.family: "DejaVu Sans"
                     font.pixelSize: 8
                     color: "#B0B8C8"
@@ -172,6 +192,45 @@ Rectangle {
                     font.hintingPreference: Font.PreferFullHinting
                 }
             }
+
+            // ==================== PER-DEVICE I/O ====================
+
+            Repeater {
+                model: systemInfo.diskDevices
+
+                // Whole disks only, partitions are in the API for detail views
+                Row {
+                    width: 304
+                    height: 10
+                    spacing: 4
+                    visible: !modelData.partition
+
+                    Text {
+                        width: 240
+                        text: modelData.name
+                              + "  R " + root.formatRate(modelData.readKBs)
+                              + "  W " + root.formatRate(modelData.writeKBs)
+                              + "  " + (modelData.readIops + modelData.writeIops).toFixed(0) + " IOPS"
+                              + "  " + modelData.awaitMs.toFixed(1) + " ms"
+                              + "  " + modelData.utilization.toFixed(0) + "%"
+                              + (modelData.inFlight > 0 ? "  q" + modelData.inFlight : "")
+                        elide: Text.ElideRight
+                        font.family: "DejaVu Sans"
+                        font.pixelSize: 8
+                        color: "#B0B8C8"
+                        renderType: Text.NativeRendering
+                        antialiasing: false
+                        font.hintingPreference: Font.PreferFullHinting
+                    }
+
+                    LineChart {
+                        width: 60
+                        height: 10
+                        dataPoints: modelData.history
+                        lineColor: "#FFEB3B"
+                    }
+                }
+            }
         }
     }
 
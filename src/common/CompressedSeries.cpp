@@ -0,0 +1,374 @@
+/**
+ * ============================================
+ * File: src/common/CompressedSeries.cpp
+ * Description: Gorilla-compressed time series implementation
+ * ============================================
+ */
+
+#include "CompressedSeries.h"
+#include <QtAlgorithms>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+quint64 lowMask(int bits)
+{
+    return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+quint64 doubleBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+quint64 readBits(const QVector<quint64>& words, int& pos, int bits)
+{
+    quint64 result = 0;
+    while (bits > 0) {
+        const int room = 64 - (pos & 63);
+        const int take = qMin(room, bits);
+        const quint64 chunk = (words.at(pos >> 6) >> (room - take)) & lowMask(take);
+
+        result = (take == 64) ? chunk : (result << take) | chunk;
+        pos += take;
+        bits -= take;
+    }
+    return result;
+}
+
+qint64 signExtend(quint64 value, int bits)
+{
+    return (value & (1ULL << (bits - 1))) ? static_cast<qint64>(value | ~lowMask(bits))
+                                          : static_cast<qint64>(value);
+}
+
+/**
+ * @brief Delta-of-delta buckets: prefix, prefix length, payload bits
+ *
+ * The last bucket (prefix 1111) carries the raw 64-bit value.
+ */
+struct DodBucket {
+    quint64 prefix;
+    int prefixBits;
+    int payloadBits;
+};
+
+constexpr DodBucket DOD_BUCKETS[] = {
+    { 0b10, 2, 7 },
+    { 0b110, 3, 9 },
+    { 0b1110, 4, 12 },
+    { 0b1111, 4, 64 }
+};
+
+} // namespace
+
+// ==================== Encoding ====================
+
+CompressedSeries::CompressedSeries(qint64 retentionSec, double quantum)
+    : m_retentionSec(retentionSec)
+    , m_quantum(quantum)
+    , m_prevDelta(0)
+    , m_prevBits(0)
+    , m_prevLeading(-1)
+    , m_prevTrailing(0)
+{
+}
+
+void CompressedSeries::append(qint64 timeSec, double value)
+{
+    if (m_quantum > 0.0) {
+        value = std::round(value / m_quantum) * m_quantum;
+    }
+
+    const qint64 newest = lastTime();
+    if (!isEmpty() && timeSec < newest) {
+        timeSec = newest;
+    }
+
+    if (m_open.count == 0) {
+        m_open.firstTime = timeSec;
+        m_open.lastTime = timeSec;
+        m_open.firstValue = value;
+        m_open.min = value;
+        m_open.max = value;
+        m_open.count = 1;
+
+        m_prevDelta = 0;
+        m_prevBits = doubleBits(value);
+        m_prevLeading = -1;
+        return;
+    }
+
+    // Timestamp: delta of deltas, 1 bit for a steady period
+    const qint64 delta = timeSec - m_open.lastTime;
+    const qint64 dod = delta - m_prevDelta;
+
+    if (dod == 0) {
+        writeBits(0, 1);
+    }
+    else {
+        for (const DodBucket& bucket : DOD_BUCKETS) {
+            const qint64 limit = (bucket.payloadBits < 64) ? (1LL << (bucket.payloadBits - 1)) : 0;
+            if (bucket.payloadBits == 64 || (dod >= -limit && dod < limit)) {
+                writeBits(bucket.prefix, bucket.prefixBits);
+                writeBits(static_cast<quint64>(dod) & lowMask(bucket.payloadBits), bucket.payloadBits);
+                break;
+            }
+        }
+    }
+
+    // Value: XOR with the previous one, 1 bit when unchanged
+    const quint64 bits = doubleBits(value);
+    const quint64 xorBits = bits ^ m_prevBits;
+
+    if (xorBits == 0) {
+        writeBits(0, 1);
+    }
+    else {
+        const int leading = qMin(31, static_cast<int>(qCountLeadingZeroBits(xorBits)));
+        const int trailing = static_cast<int>(qCountTrailingZeroBits(xorBits));
+
+        if (m_prevLeading >= 0 && leading >= m_prevLeading && trailing >= m_prevTrailing) {
+            // Fits the previous window: no need to repeat its bounds
+            writeBits(0b10, 2);
+            writeBits(xorBits >> m_prevTrailing, 64 - m_prevLeading - m_prevTrailing);
+        }
+        else {
+            const int meaningful = 64 - leading - trailing;
+            writeBits(0b11, 2);
+            writeBits(static_cast<quint64>(leading), 5);
+            writeBits(static_cast<quint64>(meaningful - 1), 6);
+            writeBits(xorBits >> trailing, meaningful);
+            m_prevLeading = leading;
+            m_prevTrailing = trailing;
+        }
+    }
+
+    m_prevDelta = delta;
+    m_prevBits = bits;
+
+    m_open.lastTime = timeSec;
+    m_open.min = qMin(m_open.min, value);
+    m_open.max = qMax(m_open.max, value);
+    ++m_open.count;
+
+    if (m_open.count == BLOCK_SAMPLES) {
+        seal();
+    }
+}
+
+void CompressedSeries::clear()
+{
+    m_sealed.clear();
+    m_open = Block();
+    m_prevLeading = -1;
+}
+
+void CompressedSeries::writeBits(quint64 value, int bits)
+{
+    while (bits > 0) {
+        const int used = m_open.bitCount & 63;
+        if (used == 0) {
+            m_open.words.append(0);
+        }
+
+        const int room = 64 - used;
+        const int take = qMin(room, bits);
+        const quint64 chunk = (value >> (bits - take)) & lowMask(take);
+
+        m_open.words.last() |= chunk << (room - take);
+        m_open.bitCount += take;
+        bits -= take;
+    }
+}
+
+void CompressedSeries::seal()
+{
+    m_open.words.squeeze();
+    m_sealed.append(std::make_shared<const Block>(std::move(m_open)));
+    m_open = Block();
+
+    // Retention is enforced a block at a time, at the same moment
+    const qint64 horizon = m_sealed.last()->lastTime - m_retentionSec;
+    int expired = 0;
+    while (expired < m_sealed.size() && m_sealed.at(expired)->lastTime < horizon) {
+        ++expired;
+    }
+    m_sealed.remove(0, expired);
+}
+
+// ==================== Queries ====================
+
+int CompressedSeries::size() const
+{
+    int total = m_open.count;
+    for (const std::shared_ptr<const Block>& sealed : m_sealed) {
+        total += sealed->count;
+    }
+    return total;
+}
+
+qint64 CompressedSeries::firstTime() const
+{
+    return isEmpty() ? 0 : block(0).firstTime;
+}
+
+qint64 CompressedSeries::lastTime() const
+{
+    return isEmpty() ? 0 : block(blockCount() - 1).lastTime;
+}
+
+qint64 CompressedSeries::memoryUsage() const
+{
+    qint64 bytes = static_cast<qint64>(m_sealed.capacity()) * static_cast<qint64>(sizeof(m_sealed.first()));
+    for (int i = 0; i < blockCount(); ++i) {
+        bytes += static_cast<qint64>(sizeof(Block))
+               + static_cast<qint64>(block(i).words.capacity()) * static_cast<qint64>(sizeof(quint64));
+    }
+    return bytes;
+}
+
+CompressedSeries::const_iterator CompressedSeries::lowerBound(qint64 fromSec) const
+{
+    // Blocks are in time order: binary search the first that reaches fromSec
+    int low = 0;
+    int high = blockCount();
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        if (block(middle).lastTime < fromSec) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    const_iterator it(this, low);
+    const const_iterator last = end();
+    while (it != last && it->timeSec < fromSec) {
+        ++it;
+    }
+    return it;
+}
+
+bool CompressedSeries::minMax(qint64 fromSec, qint64 toSec, double& min, double& max) const
+{
+    bool found = false;
+    auto fold = [&](double low, double high) {
+        min = found ? qMin(min, low) : low;
+        max = found ? qMax(max, high) : high;
+        found = true;
+    };
+
+    for (int i = 0; i < blockCount(); ++i) {
+        const Block& current = block(i);
+        if (current.lastTime < fromSec) {
+            continue;
+        }
+        if (current.firstTime > toSec) {
+            break;
+        }
+
+        if (current.firstTime >= fromSec && current.lastTime <= toSec) {
+            // Wholly inside: the index answers
+            fold(current.min, current.max);
+            continue;
+        }
+
+        // Straddles an end of the range: decode this block only
+        for (const_iterator it(this, i); it.m_block == i && it->timeSec <= toSec; ++it) {
+            if (it->timeSec >= fromSec) {
+                fold(it->value, it->value);
+            }
+        }
+    }
+    return found;
+}
+
+// ==================== Decoding ====================
+
+CompressedSeries::const_iterator::const_iterator(const CompressedSeries* series, int block)
+    : m_series(series)
+    , m_data(nullptr)
+    , m_block(block)
+    , m_index(0)
+    , m_bitPos(0)
+    , m_delta(0)
+    , m_valueBits(0)
+    , m_leading(0)
+    , m_trailing(0)
+{
+    startBlock();
+}
+
+void CompressedSeries::const_iterator::startBlock()
+{
+    m_index = 0;
+    if (m_block >= m_series->blockCount()) {
+        m_data = nullptr;
+        return;
+    }
+
+    m_data = &m_series->block(m_block);
+    m_bitPos = 0;
+    m_delta = 0;
+    m_valueBits = doubleBits(m_data->firstValue);
+    m_leading = 0;
+    m_trailing = 0;
+    m_sample.timeSec = m_data->firstTime;
+    m_sample.value = m_data->firstValue;
+}
+
+CompressedSeries::const_iterator& CompressedSeries::const_iterator::operator++()
+{
+    if (!m_data) {
+        return *this;
+    }
+
+    if (++m_index >= m_data->count) {
+        ++m_block;
+        startBlock();
+        return *this;
+    }
+
+    const QVector<quint64>& words = m_data->words;
+
+    // Timestamp
+    qint64 dod = 0;
+    if (readBits(words, m_bitPos, 1) != 0) {
+        for (const DodBucket& bucket : DOD_BUCKETS) {
+            // Prefixes are unary: each further 1 bit moves to the next bucket
+            const bool lastBucket = (bucket.payloadBits == 64);
+            if (lastBucket || readBits(words, m_bitPos, 1) == 0) {
+                const quint64 payload = readBits(words, m_bitPos, bucket.payloadBits);
+                dod = lastBucket ? static_cast<qint64>(payload) : signExtend(payload, bucket.payloadBits);
+                break;
+            }
+        }
+    }
+    m_delta += dod;
+    m_sample.timeSec += m_delta;
+
+    // Value
+    if (readBits(words, m_bitPos, 1) != 0) {
+        if (readBits(words, m_bitPos, 1) != 0) {
+            m_leading = static_cast<int>(readBits(words, m_bitPos, 5));
+            m_trailing = 64 - m_leading - (static_cast<int>(readBits(words, m_bitPos, 6)) + 1);
+        }
+        const int meaningful = 64 - m_leading - m_trailing;
+        m_valueBits ^= readBits(words, m_bitPos, meaningful) << m_trailing;
+        m_sample.value = bitsDouble(m_valueBits);
+    }
+
+    return *this;
+}
@@ -0,0 +1,187 @@
+/**
+ * ============================================
+ * File: src/common/CompressedSeries.h
+ * Description: Gorilla-compressed in-memory time series
+ * ============================================
+ */
+
+#ifndef COMPRESSEDSERIES_H
+#define COMPRESSEDSERIES_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <iterator>
+#include <memory>
+#include "Constants.h"
+
+/**
+ * @class CompressedSeries
+ * @brief Long (timestamp, value) history at a couple of bits per sample
+ *
+ * Samples are packed as in Facebook's Gorilla: timestamps as the
+ * difference between consecutive deltas (one bit when the period is
+ * steady), values as the XOR with the previous value (one bit when it
+ * repeats, otherwise only the bits that changed). Appending is streaming;
+ * nothing already written is touched again.
+ *
+ * Samples are grouped into blocks of BLOCK_SAMPLES. Each block records its
+ * time span and value min/max, which is the index for range queries:
+ * whole blocks outside a range are skipped, whole blocks inside it answer
+ * minMax() without decoding. Full blocks are sealed and shared, so a copy
+ * of the series (e.g. into a MetricsSnapshot) costs a reference count plus
+ * the open block, and blocks older than the retention are dropped whole.
+ *
+ * Timestamps are whole seconds and never go backwards: an earlier time
+ * (wall clock stepped back) is recorded as the latest one.
+ *
+ * Not thread-safe; hand copies to other threads.
+ */
+class CompressedSeries
+{
+public:
+    /**
+     * @brief One decoded sample
+     */
+    struct Sample {
+        qint64 timeSec = 0;
+        double value = 0.0;
+    };
+
+private:
+    struct Block;
+
+public:
+    /**
+     * @brief Forward decoder, oldest sample first
+     *
+     * Decodes one sample per increment; holds no allocation of its own.
+     * Invalidated by append() on the series it came from.
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Sample;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Sample*;
+        using reference = const Sample&;
+
+        reference operator*() const { return m_sample; }
+        pointer operator->() const { return &m_sample; }
+
+        const_iterator& operator++();
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return m_block == other.m_block && m_index == other.m_index;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class CompressedSeries;
+
+        const_iterator(const CompressedSeries* series, int block);
+        void startBlock();
+
+        const CompressedSeries* m_series;
+        const Block* m_data;
+        int m_block;
+        int m_index;            // Sample within the block
+        int m_bitPos;
+        qint64 m_delta;
+        quint64 m_valueBits;
+        int m_leading;
+        int m_trailing;
+        Sample m_sample;
+    };
+
+    /**
+     * @param retentionSec Samples older than this (relative to the newest)
+     *        are dropped, a block at a time
+     * @param quantum Values are rounded to a multiple of this before being
+     *        stored, 0 = exact. Rounding noisy rates keeps the XOR short.
+     */
+    explicit CompressedSeries(qint64 retentionSec = App::History::SERIES_RETENTION_SEC,
+                              double quantum = 0.0);
+
+    /**
+     * @brief Append one sample (O(1), amortised; allocates only per block)
+     */
+    void append(qint64 timeSec, double value);
+
+    void clear();
+
+    int size() const;
+    bool isEmpty() const { return m_open.count == 0 && m_sealed.isEmpty(); }
+
+    /**
+     * @brief Oldest and newest timestamps; 0 when empty
+     */
+    qint64 firstTime() const;
+    qint64 lastTime() const;
+
+    /**
+     * @brief Heap bytes held by the encoded samples and block index
+     */
+    qint64 memoryUsage() const;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, blockCount()); }
+
+    /**
+     * @brief First sample at or after fromSec, skipping whole blocks
+     */
+    const_iterator lowerBound(qint64 fromSec) const;
+
+    /**
+     * @brief Min and max of the values in [fromSec, toSec]
+     * @return false if no sample falls in the range
+     */
+    bool minMax(qint64 fromSec, qint64 toSec, double& min, double& max) const;
+
+private:
+    struct Block {
+        qint64 firstTime = 0;
+        qint64 lastTime = 0;
+        double firstValue = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        int count = 0;
+        int bitCount = 0;
+        QVector<quint64> words;     // Samples after the first, MSB first
+    };
+
+    int blockCount() const { return m_sealed.size() + (m_open.count > 0 ? 1 : 0); }
+    const Block& block(int index) const
+    {
+        return index < m_sealed.size() ? *m_sealed.at(index) : m_open;
+    }
+
+    void writeBits(quint64 value, int bits);
+    void seal();
+
+private:
+    qint64 m_retentionSec;
+    double m_quantum;
+
+    QVector<std::shared_ptr<const Block>> m_sealed;  // Oldest first
+    Block m_open;
+
+    // Encoder state for the open block
+    qint64 m_prevDelta;
+    quint64 m_prevBits;
+    int m_prevLeading;          // -1 = no XOR window yet
+    int m_prevTrailing;
+
+    // Constants
+    static constexpr int BLOCK_SAMPLES = 512;
+};
+
+#endif // COMPRESSEDSERIES_H
@@ -26,11 +26,14 @@ namespace Info {
 // ============================================================================
 // Update Intervals (milliseconds)
 // ============================================================================
+// Collector tiers at a 1 s update interval; the user setting (2 s by
+// default) scales every tier but FAST together (see MetricsSampler::setInterval)
 namespace Interval {
-    constexpr int FAST = 500;       // CPU, RAM real-time
-    constexpr int NORMAL = 1000;    // Default update
-    constexpr int SLOW = 2000;      // Network, Storage
-    constexpr int VERY_SLOW = 5000; // System info 
+    constexpr int FAST = 500;           // CPU, RAM real-time
+    constexpr int NORMAL = 1000;        // Default update, chart histories
+    constexpr int SLOW = 2000;          // Clock, load average, process table
+    constexpr int VERY_SLOW = 5000;     // GPU (vcgencmd), TCP connection count
+    constexpr int BACKGROUND = 10000;   // Filesystem capacity (statvfs)
 }
 
 // ============================================================================
@@ -42,15 +45,22 @@ namespace Path {
     constexpr const char* PROC_STAT = "/proc/stat";
     constexpr const char* CPU_TEMP = "/sys/class/thermal/thermal_zone0/temp";
     constexpr const char* CPU_FREQ = "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq";
+    constexpr const char* PROC_LOADAVG = "/proc/loadavg";
 
     // Memory
     constexpr const char* PROC_MEMINFO = "/proc/meminfo";
 
+    // Storage
+    constexpr const char* PROC_DISKSTATS = "/proc/diskstats";
+
     // Network
     constexpr const char* PROC_NET_DEV = "/proc/net/dev";
     constexpr const char* PROC_NET_TCP = "/proc/net/tcp";
     constexpr const char* PROC_NET_TCP6 = "/proc/net/tcp6";
 
+    // Processes (/proc/[pid]/stat)
+    constexpr const char* PROC = "/proc";
+
     // System
     constexpr const char* PROC_UPTIME = "/proc/uptime";
     constexpr const char* PROC_VERSION = "/proc/version";
@@ -58,6 +68,52 @@ namespace Path {
     constexpr const char* ETC_OS_RELEASE = "/etc/os-release";
 }   
 
+// ============================================================================
+// History Sizes
+// ============================================================================
+namespace History {
+    constexpr int CHART_SAMPLES = 60;   // Samples kept for each chart
+
+    // On-disk archives (HistoryStore), bucket seconds x rows
+    constexpr int ARCHIVE_FINE_STEP = 1;        // 1 h at 1 s
+    constexpr int ARCHIVE_FINE_ROWS = 3600;
+    constexpr int ARCHIVE_MEDIUM_STEP = 10;     // 24 h at 10 s
+    constexpr int ARCHIVE_MEDIUM_ROWS = 8640;
+    constexpr int ARCHIVE_COARSE_STEP = 300;    // 30 d at 5 min
+    constexpr int ARCHIVE_COARSE_ROWS = 8640;
+    constexpr const char* ARCHIVE_DIR = "history";  // Under the app data location
+
+    // In-memory compressed series (CompressedSeries) kept by the monitors
+    constexpr qint64 SERIES_RETENTION_SEC = 24 * 3600;
+    constexpr double SERIES_RATE_QUANTUM = 1024.0;  // Rates stored to 1 KB/s
+}
+
+// ============================================================================
+// Percentiles
+// ============================================================================
+namespace Quantile {
+    constexpr double RELATIVE_ACCURACY = 0.01;  // Sketch error bound, relative
+    constexpr int MAX_BINS = 512;               // Per sketch, ~3e4:1 value range at 1%
+    constexpr int SLICE_SEC = 10;               // Window granularity
+    constexpr int SLICE_COUNT = 360;            // Longest window: 1 h
+}
+
+// ============================================================================
+// Process Table
+// ============================================================================
+namespace Process {
+    constexpr int TOP_COUNT = 8;        // Rows ranked by CPU and by RSS
+    constexpr int SCAN_BUDGET = 1024;   // /proc/[pid] reads per update at most
+}
+
+// ============================================================================
+// Tracing (opt-in, SYSMON_TRACE)
+// ============================================================================
+namespace Trace {
+    constexpr int BUFFER_EVENTS = 16384;            // Per thread, newest kept (512 KB)
+    constexpr const char* FILE_NAME = "trace.json"; // Under the app data location
+}
+
 // ============================================================================
 // Default Thresholds
 // ============================================================================
@@ -89,6 +145,7 @@ namespace NavIndex {
     constexpr int STORAGE = 3;
     constexpr int NETWORK = 4;
     constexpr int SETTINGS = 5;
+    constexpr int PROCESSES = 6;
 }
 
 
@@ -11,6 +11,222 @@
 #include <QProcess>
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Per-thread cache of open handles, closed when the thread exits
+ */
+struct HandleCache {
+    struct Entry {
+        ProcFileHandle* handle;
+        quint64 lastUse;
+    };
+
+    QHash<QString, Entry> handles;
+    quint64 uses = 0;
+
+    ~HandleCache() { clear(); }
+
+    void clear()
+    {
+        for (const Entry& entry : std::as_const(handles)) {
+            delete entry.handle;
+        }
+        handles.clear();
+    }
+};
+
+HandleCache& handleCache()
+{
+    thread_local HandleCache cache;
+    return cache;
+}
+
+constexpr qsizetype INITIAL_READ_BUFFER = 4096;
+
+// The per-tick paths are a handful; more than this means paths that are
+// read once and never again (e.g. per-process files)
+constexpr int MAX_CACHED_HANDLES = 64;
+
+} // namespace
+
+// ============================================================================
+// ProcFileHandle
+// ============================================================================
+
+ProcFileHandle::ProcFileHandle(const QString &path)
+    : m_path(QFile::encodeName(path))
+{
+}
+
+ProcFileHandle::~ProcFileHandle()
+{
+    close();
+}
+
+ProcFileHandle::ProcFileHandle(ProcFileHandle &&other) noexcept
+    : m_fd(other.m_fd)
+    , m_path(std::move(other.m_path))
+{
+    other.m_fd = -1;
+}
+
+ProcFileHandle &ProcFileHandle::operator=(ProcFileHandle &&other) noexcept
+{
+    if (this != &other) {
+        close();
+        m_fd = other.m_fd;
+        m_path = std::move(other.m_path);
+        other.m_fd = -1;
+    }
+    return *this;
+}
+
+void ProcFileHandle::setPath(const QString &path)
+{
+    close();
+    m_path = QFile::encodeName(path);
+}
+
+QString ProcFileHandle::path() const
+{
+    return QFile::decodeName(m_path);
+}
+
+void ProcFileHandle::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool ProcFileHandle::open()
+{
+    if (m_fd >= 0) {
+        return true;
+    }
+    if (m_path.isEmpty()) {
+        return false;
+    }
+
+    m_fd = ::open(m_path.constData(), O_RDONLY | O_CLOEXEC);
+    return m_fd >= 0;
+}
+
+qsizetype ProcFileHandle::preadOnce(char *buffer, qsizetype capacity, qint64 offset)
+{
+    ssize_t n;
+    do {
+        n = ::pread(m_fd, buffer, static_cast<size_t>(capacity), static_cast<off_t>(offset));
+    } while (n < 0 && errno == EINTR);
+
+    return static_cast<qsizetype>(n);
+}
+
+qsizetype ProcFileHandle::read(char *buffer, qsizetype capacity)
+{
+    // Second attempt re-opens a descriptor that went stale
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!open()) {
+            return -1;
+        }
+
+        qsizetype total = 0;
+        bool failed = false;
+
+        while (total < capacity) {
+            qsizetype n = preadOnce(buffer + total, capacity - total, total);
+            if (n < 0) {
+                failed = true;
+                break;
+            }
+            if (n == 0) {
+                break;
+            }
+            total += n;
+        }
+
+        if (!failed) {
+            return total;
+        }
+        close();
+    }
+
+    return -1;
+}
+
+bool ProcFileHandle::read(QByteArray &buffer)
+{
+    if (buffer.capacity() < INITIAL_READ_BUFFER) {
+        buffer.reserve(INITIAL_READ_BUFFER);
+    }
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!open()) {
+            break;
+        }
+
+        // Use the whole existing capacity, only grow when the file outgrows it
+        buffer.resize(buffer.capacity());
+        qsizetype total = 0;
+        bool failed = false;
+
+        for (;;) {
+            if (total == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+
+            qsizetype n = preadOnce(buffer.data() + total, buffer.size() - total, total);
+            if (n < 0) {
+                failed = true;
+                break;
+            }
+            if (n == 0) {
+                break;
+            }
+            total += n;
+        }
+
+        if (!failed) {
+            buffer.resize(total);
+            return true;
+        }
+        close();
+    }
+
+    buffer.resize(0);
+    return false;
+}
+
+long long ProcFileHandle::readInt64(long long defaultValue)
+{
+    char buffer[64];
+    qsizetype n = read(buffer, sizeof(buffer));
+    if (n <= 0) {
+        return defaultValue;
+    }
+
+    bool ok;
+    long long value = FileReader::parseInt64(QByteArrayView(buffer, n), &ok);
+    return ok ? value : defaultValue;
+}
+
+int ProcFileHandle::readInt(int defaultValue)
+{
+    return static_cast<int>(readInt64(defaultValue));
+}
+
+// ============================================================================
+// FileReader
+// ============================================================================
 
 QString FileReader::readAll(const QString &path)
 {
@@ -77,27 +293,103 @@ QMap<QString, QString> FileReader::readKeyValueFile(const QString &path, const Q
 
 int FileReader::readInt(const QString &path, int defaultValue)
 {
-    QString content = readFirstLine(path);
-    if (content.isEmpty()) {
+    return handle(path).readInt(defaultValue);
+}
+
+double FileReader::readDouble(const QString &path, double defaultValue)
+{
+    char buffer[64];
+    qsizetype n = handle(path).read(buffer, sizeof(buffer) - 1);
+    if (n <= 0) {
         return defaultValue;
     }
+    buffer[n] = '\0';
 
-    bool ok;
-    int value = content.toInt(&ok);
+    char* end = nullptr;
+    double value = std::strtod(buffer, &end);
+    return (end != buffer) ? value : defaultValue;
+}
 
-    return ok ? value : defaultValue;
+ProcFileHandle &FileReader::handle(const QString &path)
+{
+    HandleCache& cache = handleCache();
+
+    auto it = cache.handles.find(path);
+    if (it != cache.handles.end()) {
+        it->lastUse = ++cache.uses;
+        return *it->handle;
+    }
+
+    // Full: close the least recently used path. A miss pays for an open()
+    // anyway, next to which scanning the entries is cheap
+    if (cache.handles.size() >= MAX_CACHED_HANDLES) {
+        auto oldest = cache.handles.begin();
+        for (auto entry = cache.handles.begin(); entry != cache.handles.end(); ++entry) {
+            if (entry->lastUse < oldest->lastUse) {
+                oldest = entry;
+            }
+        }
+        delete oldest->handle;
+        cache.handles.erase(oldest);
+    }
+
+    ProcFileHandle* fileHandle = new ProcFileHandle(path);
+    cache.handles.insert(path, { fileHandle, ++cache.uses });
+    return *fileHandle;
 }
 
-double FileReader::readDouble(const QString &path, double defaultValue)
+bool FileReader::readBytes(const QString &path, QByteArray &buffer)
 {
-    QString content = readFirstLine(path);
-    if (content.isEmpty()) {
-        return defaultValue;
+    return handle(path).read(buffer);
+}
+
+long long FileReader::readInt64(const QString &path, long long defaultValue)
+{
+    return handle(path).readInt64(defaultValue);
+}
+
+void FileReader::closeCachedHandles()
+{
+    handleCache().clear();
+}
+
+QByteArrayView FileReader::firstLine(QByteArrayView content)
+{
+    const char* data = content.data();
+    const void* newline = memchr(data, '\n', static_cast<size_t>(content.size()));
+
+    if (!newline) {
+        return content;
     }
+    return QByteArrayView(data, static_cast<const char*>(newline) - data);
+}
 
-    bool ok;
-    double value = content.toDouble(&ok);
-    return ok ? value : defaultValue;
+long long FileReader::parseInt64(QByteArrayView text, bool *ok)
+{
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n')) {
+        ++p;
+    }
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    const char* digits = p;
+    long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        ++p;
+    }
+
+    if (ok) {
+        *ok = (p != digits);
+    }
+    return negative ? -value : value;
 }
 
 QString FileReader::executeCommand(const QString &command)
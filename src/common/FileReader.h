@@ -10,7 +10,86 @@
 
 #include <QString>
 #include <QStringList>
+#include <QByteArray>
+#include <QByteArrayView>
 #include <QMap>
+#include <cstring>
+
+/**
+ * @class ProcFileHandle
+ * @brief Keeps a /proc or /sys file descriptor open between reads
+ *
+ * Each read() re-reads the file from offset 0 with pread(), so the kernel
+ * regenerates the content without an open/close per sample. If a read
+ * fails (e.g. the sysfs node was removed and re-created) the file is
+ * re-opened once before giving up.
+ */
+class ProcFileHandle
+{
+public:
+    ProcFileHandle() = default;
+    explicit ProcFileHandle(const QString& path);
+    ~ProcFileHandle();
+
+    ProcFileHandle(const ProcFileHandle&) = delete;
+    ProcFileHandle& operator=(const ProcFileHandle&) = delete;
+    ProcFileHandle(ProcFileHandle&& other) noexcept;
+    ProcFileHandle& operator=(ProcFileHandle&& other) noexcept;
+
+    /**
+     * @brief Point the handle at a new path (closes the current descriptor)
+     */
+    void setPath(const QString& path);
+    QString path() const;
+
+    bool isOpen() const { return m_fd >= 0; }
+    void close();
+
+    /**
+     * @brief Read the whole file into a caller-owned buffer
+     * @param buffer Resized to the content length; its capacity is reused
+     * @return true on success
+     */
+    bool read(QByteArray& buffer);
+
+    /**
+     * @brief Read up to capacity bytes into a caller-owned span
+     * @return Number of bytes read, or -1 on error
+     */
+    qsizetype read(char* buffer, qsizetype capacity);
+
+    /**
+     * @brief Read the file as a single integer value (e.g. sysfs attributes)
+     */
+    long long readInt64(long long defaultValue = 0);
+    int readInt(int defaultValue = 0);
+
+    /**
+     * @brief Stream the file line by line through a fixed-size chunk
+     *
+     * For large generated files (e.g. /proc/net/tcp) that should not be
+     * held in memory at once. Lines are handed over in place as views
+     * into the chunk; only an incomplete tail is moved between reads.
+     * A line longer than the chunk is delivered in pieces.
+     *
+     * @param chunk Caller-owned scratch buffer, sized on first use
+     * @param handler Called as handler(QByteArrayView line) without '\n'
+     * @return false if the file could not be read
+     */
+    template <typename Handler>
+    bool forEachLine(QByteArray& chunk, Handler&& handler);
+
+private:
+    bool open();
+    qsizetype preadOnce(char* buffer, qsizetype capacity, qint64 offset);
+
+private:
+    int m_fd = -1;
+    QByteArray m_path;  // Encoded file name, ready for open()
+
+    // Constants
+    static constexpr qsizetype STREAM_CHUNK_SIZE = 16 * 1024;
+};
 
 /**
  * @class FileReader
@@ -20,6 +99,9 @@
  * - /proc filesystem
  * - /sys filesystem
  * - Configuration files
+ *
+ * The QString helpers are convenient for one-off reads. Anything read on
+ * every tick should use the byte-level API, which keeps descriptors open.
  */
 
 class FileReader
@@ -72,6 +154,36 @@ public:
      * @return Double value
      */
     static double readDouble(const QString& path, double defaultValue = 0.0);
+
+    // ==================== Byte-level API (cached descriptors) ====================
+
+    /**
+     * @brief Re-read path into a caller-owned buffer through the handle cache
+     * @return true on success
+     */
+    static bool readBytes(const QString& path, QByteArray& buffer);
+
+    /**
+     * @brief Read a 64-bit integer through the handle cache
+     */
+    static long long readInt64(const QString& path, long long defaultValue = 0);
+
+    /**
+     * @brief Close every cached descriptor owned by the calling thread
+     */
+    static void closeCachedHandles();
+
+    /**
+     * @brief Return the first line of a byte buffer (no copy)
+     */
+    static QByteArrayView firstLine(QByteArrayView content);
+
+    /**
+     * @brief Parse a leading (optionally signed) decimal integer
+     * @param text Input bytes, leading whitespace is skipped
+     * @param ok Set to false if no digits were found
+     */
+    static long long parseInt64(QByteArrayView text, bool* ok = nullptr);
     
     /**
      * @brief Execute command and get output
@@ -100,9 +212,75 @@ public:
     static QString getPrimaryInterface();
 
 private:
+    /**
+     * @brief Get a cached, already-open handle for path
+     *
+     * Handles are cached per thread, so monitors running on a worker thread
+     * never contend with the GUI thread. The cache holds a bounded number
+     * of paths and closes the least recently used one to make room, so the
+     * reference is only used for the one read that asked for it.
+     */
+    static ProcFileHandle& handle(const QString& path);
+
     // Prevent instantiation
     FileReader() = default;
     ~FileReader() = default;
 };
 
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template <typename Handler>
+bool ProcFileHandle::forEachLine(QByteArray& chunk, Handler&& handler)
+{
+    if (chunk.size() < STREAM_CHUNK_SIZE) {
+        chunk.resize(STREAM_CHUNK_SIZE);
+    }
+    if (!open()) {
+        return false;
+    }
+
+    char* data = chunk.data();
+    const qsizetype capacity = chunk.size();
+    qsizetype pending = 0;   // Incomplete line carried over from the last read
+    qint64 offset = 0;
+
+    for (;;) {
+        qsizetype n = preadOnce(data + pending, capacity - pending, offset);
+        if (n < 0) {
+            // Cannot replay lines already delivered; re-open on the next call
+            close();
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        offset += n;
+
+        const char* lineStart = data;
+        const char* end = data + pending + n;
+        const char* newline;
+
+        while ((newline = static_cast<const char*>(memchr(lineStart, '\n', static_cast<size_t>(end - lineStart))))) {
+            handler(QByteArrayView(lineStart, newline - lineStart));
+            lineStart = newline + 1;
+        }
+
+        pending = end - lineStart;
+        if (pending == capacity) {
+            handler(QByteArrayView(data, pending));
+            pending = 0;
+        }
+        else if (pending > 0 && lineStart != data) {
+            memmove(data, lineStart, static_cast<size_t>(pending));
+        }
+    }
+
+    if (pending > 0) {
+        handler(QByteArrayView(data, pending));
+    }
+    return true;
+}
+
 #endif // FILEREADER_H
@@ -0,0 +1,271 @@
+/**
+ * ============================================
+ * File: src/common/FlatHashMap.h
+ * Description: Open-addressing hash map for small integer keys
+ * ============================================
+ */
+
+#ifndef FLATHASHMAP_H
+#define FLATHASHMAP_H
+
+#include <QtGlobal>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class FlatHashMap
+ * @brief Integer-keyed map in one flat array (linear probing)
+ *
+ * Meant for keys such as pids that are looked up every tick: entries live
+ * inline in a power-of-two slot array, so a lookup is a multiply, a shift
+ * and usually one cache line, and steady-state use never allocates.
+ * Erasing shifts the rest of the probe run back instead of leaving
+ * tombstones, so long-running maps with churn do not slow down.
+ *
+ * References returned by find()/insert() stay valid until the next
+ * insert() or erase().
+ *
+ * @tparam Key Integral key type
+ * @tparam Value Default-constructible, movable
+ */
+template <typename Key, typename Value>
+class FlatHashMap
+{
+    static_assert(std::is_integral<Key>::value, "FlatHashMap keys are integers");
+
+public:
+    FlatHashMap() = default;
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    /**
+     * @brief Make room for count entries without rehashing
+     */
+    void reserve(int count);
+
+    /**
+     * @return The value for key, nullptr if absent
+     */
+    Value* find(Key key);
+    const Value* find(Key key) const;
+
+    /**
+     * @brief The value for key, default-constructed if absent
+     * @param inserted Set to whether the key was new
+     */
+    Value& insert(Key key, bool* inserted = nullptr);
+
+    bool erase(Key key);
+
+    void clear();
+
+    /**
+     * @brief Call f(key, value) for every entry, in slot order
+     */
+    template <typename Function>
+    void forEach(Function f) const;
+
+    /**
+     * @brief Erase every entry for which pred(key, value) is true
+     */
+    template <typename Predicate>
+    int removeIf(Predicate pred);
+
+private:
+    struct Slot {
+        Key key = Key();
+        bool used = false;
+        Value value = Value();
+    };
+
+    int home(Key key) const;
+    int probe(Key key) const;
+    void eraseSlot(int index);
+    void rehash(int capacity);
+
+private:
+    std::vector<Slot> m_slots;
+    int m_size = 0;
+    int m_shift = 64;       // 64 - log2(capacity), for the multiplicative hash
+
+    // Constants
+    static constexpr int MIN_CAPACITY = 16;
+};
+
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template <typename Key, typename Value>
+void FlatHashMap<Key, Value>::reserve(int count)
+{
+    // Keep the load factor at or below 1/2
+    int capacity = MIN_CAPACITY;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    if (capacity > static_cast<int>(m_slots.size())) {
+        rehash(capacity);
+    }
+}
+
+template <typename Key, typename Value>
+Value* FlatHashMap<Key, Value>::find(Key key)
+{
+    const int index = probe(key);
+    return (index >= 0 && m_slots[index].used) ? &m_slots[index].value : nullptr;
+}
+
+template <typename Key, typename Value>
+const Value* FlatHashMap<Key, Value>::find(Key key) const
+{
+    const int index = probe(key);
+    return (index >= 0 && m_slots[index].used) ? &m_slots[index].value : nullptr;
+}
+
+template <typename Key, typename Value>
+Value& FlatHashMap<Key, Value>::insert(Key key, bool* inserted)
+{
+    if ((m_size + 1) * 2 > static_cast<int>(m_slots.size())) {
+        rehash(qMax(MIN_CAPACITY, static_cast<int>(m_slots.size()) * 2));
+    }
+
+    const int index = probe(key);
+    Slot& slot = m_slots[index];
+    if (inserted) {
+        *inserted = !slot.used;
+    }
+    if (!slot.used) {
+        slot.key = key;
+        slot.used = true;
+        slot.value = Value();
+        ++m_size;
+    }
+    return slot.value;
+}
+
+template <typename Key, typename Value>
+bool FlatHashMap<Key, Value>::erase(Key key)
+{
+    const int index = probe(key);
+    if (index < 0 || !m_slots[index].used) {
+        return false;
+    }
+    eraseSlot(index);
+    return true;
+}
+
+template <typename Key, typename Value>
+void FlatHashMap<Key, Value>::clear()
+{
+    for (Slot& slot : m_slots) {
+        slot.used = false;
+        slot.value = Value();
+    }
+    m_size = 0;
+}
+
+template <typename Key, typename Value>
+template <typename Function>
+void FlatHashMap<Key, Value>::forEach(Function f) const
+{
+    for (const Slot& slot : m_slots) {
+        if (slot.used) {
+            f(slot.key, slot.value);
+        }
+    }
+}
+
+template <typename Key, typename Value>
+template <typename Predicate>
+int FlatHashMap<Key, Value>::removeIf(Predicate pred)
+{
+    int removed = 0;
+    int index = 0;
+    while (index < static_cast<int>(m_slots.size())) {
+        const Slot& slot = m_slots[index];
+        if (slot.used && pred(slot.key, slot.value)) {
+            // The shift may have moved a later entry here: look again
+            eraseSlot(index);
+            ++removed;
+        }
+        else {
+            ++index;
+        }
+    }
+    return removed;
+}
+
+template <typename Key, typename Value>
+int FlatHashMap<Key, Value>::home(Key key) const
+{
+    // Fibonacci hashing spreads sequential keys (pids) over the table
+    return static_cast<int>((static_cast<quint64>(key) * 11400714819323198485ULL) >> m_shift);
+}
+
+template <typename Key, typename Value>
+int FlatHashMap<Key, Value>::probe(Key key) const
+{
+    if (m_slots.empty()) {
+        return -1;
+    }
+
+    // Slot holding key, or the free slot ending its run
+    const int mask = static_cast<int>(m_slots.size()) - 1;
+    int index = home(key);
+    while (m_slots[index].used && m_slots[index].key != key) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+template <typename Key, typename Value>
+void FlatHashMap<Key, Value>::eraseSlot(int index)
+{
+    const int mask = static_cast<int>(m_slots.size()) - 1;
+
+    // Backward shift: pull later entries of the run into the hole unless
+    // that would move them before their home slot
+    int hole = index;
+    int next = (hole + 1) & mask;
+    while (m_slots[next].used) {
+        const int wanted = home(m_slots[next].key);
+        const bool movable = ((next - wanted) & mask) >= ((next - hole) & mask);
+        if (movable) {
+            m_slots[hole] = std::move(m_slots[next]);
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    m_slots[hole].used = false;
+    m_slots[hole].value = Value();
+    --m_size;
+}
+
+template <typename Key, typename Value>
+void FlatHashMap<Key, Value>::rehash(int capacity)
+{
+    std::vector<Slot> old;
+    old.swap(m_slots);
+    m_slots.resize(static_cast<size_t>(capacity));
+
+    m_shift = 64;
+    for (int bits = capacity; bits > 1; bits >>= 1) {
+        --m_shift;
+    }
+
+    m_size = 0;
+    for (Slot& slot : old) {
+        if (slot.used) {
+            Slot& target = m_slots[probe(slot.key)];
+            target.key = slot.key;
+            target.used = true;
+            target.value = std::move(slot.value);
+            ++m_size;
+        }
+    }
+}
+
+#endif // FLATHASHMAP_H
@@ -0,0 +1,206 @@
+/**
+ * ============================================
+ * File: src/common/Instrumentation.cpp
+ * Description: Self-instrumentation implementation
+ * ============================================
+ */
+
+#include "Instrumentation.h"
+#include "TraceRecorder.h"
+#include <QVariantMap>
+#include <ctime>
+
+#ifdef SYSMON_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace {
+
+#ifdef SYSMON_COUNT_ALLOCATIONS
+// Constant-initialized, so operator new can touch it from any thread at any time
+thread_local quint64 t_allocations = 0;
+#endif
+
+qint64 clockNs(clockid_t clock)
+{
+    timespec now;
+    clock_gettime(clock, &now);
+    return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+} // namespace
+
+// ==================== Allocation hook ====================
+
+#ifdef SYSMON_COUNT_ALLOCATIONS
+
+void* operator new(std::size_t size)
+{
+    ++t_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++t_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#endif // SYSMON_COUNT_ALLOCATIONS
+
+// ==================== Probe ====================
+
+Probe::Probe(const QString& name)
+    : m_name(name)
+    , m_traceName(TraceRecorder::instance().intern(name))
+    , m_allocations(0)
+{
+}
+
+void Probe::record(qint64 wallNs, qint64 cpuNs, quint64 allocations)
+{
+    m_wall.record(static_cast<quint64>(qMax<qint64>(0, wallNs)) / 1000);
+    m_cpu.record(static_cast<quint64>(qMax<qint64>(0, cpuNs)) / 1000);
+    m_allocations.fetch_add(allocations, std::memory_order_relaxed);
+}
+
+void Probe::clear()
+{
+    m_wall.clear();
+    m_cpu.clear();
+    m_allocations.store(0, std::memory_order_relaxed);
+}
+
+// ==================== ScopeTimer ====================
+
+ScopeTimer::ScopeTimer(Probe* probe)
+    : m_probe(probe)
+    , m_wallStart(0)
+    , m_cpuStart(0)
+    , m_allocationsStart(0)
+{
+    if (m_probe) {
+        m_allocationsStart = Instrumentation::threadAllocations();
+        m_cpuStart = Instrumentation::threadCpuNs();
+        m_wallStart = Instrumentation::monotonicNs();
+
+        if (TraceRecorder::isEnabled()) {
+            TraceRecorder::instance().begin(m_probe->traceName(), "stage", m_wallStart);
+        }
+    }
+}
+
+ScopeTimer::~ScopeTimer()
+{
+    if (m_probe) {
+        // Reverse order, so each clock brackets as little of the other as possible
+        const qint64 wallEnd = Instrumentation::monotonicNs();
+        const qint64 wall = wallEnd - m_wallStart;
+        const qint64 cpu = Instrumentation::threadCpuNs() - m_cpuStart;
+
+        if (TraceRecorder::isEnabled()) {
+            TraceRecorder::instance().end(m_probe->traceName(), "stage", wallEnd);
+        }
+        m_probe->record(wall, cpu, Instrumentation::threadAllocations() - m_allocationsStart);
+    }
+}
+
+// ==================== Instrumentation ====================
+
+Probe* Instrumentation::probe(const QString& name)
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (const std::shared_ptr<Probe>& probe : m_probes) {
+        if (probe->name() == name) {
+            return probe.get();
+        }
+    }
+
+    m_probes.append(std::make_shared<Probe>(name));
+    return m_probes.last().get();
+}
+
+QVariantList Instrumentation::report() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QVariantList rows;
+    rows.reserve(m_probes.size());
+
+    for (const std::shared_ptr<Probe>& probe : m_probes) {
+        const quint64 calls = probe->calls();
+
+        QVariantMap row;
+        row["name"] = probe->name();
+        row["calls"] = calls;
+        row["wallP50"] = probe->wall().quantile(0.50);
+        row["wallP99"] = probe->wall().quantile(0.99);
+        row["wallMax"] = probe->wall().max();
+        row["cpuP50"] = probe->cpu().quantile(0.50);
+        row["cpuP99"] = probe->cpu().quantile(0.99);
+        row["allocations"] = countsAllocations() && calls > 0
+                             ? static_cast<double>(probe->allocations()) / calls
+                             : -1.0;
+        rows.append(row);
+    }
+
+    return rows;
+}
+
+void Instrumentation::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    for (const std::shared_ptr<Probe>& probe : m_probes) {
+        probe->clear();
+    }
+}
+
+quint64 Instrumentation::threadAllocations()
+{
+#ifdef SYSMON_COUNT_ALLOCATIONS
+    return t_allocations;
+#else
+    return 0;
+#endif
+}
+
+bool Instrumentation::countsAllocations()
+{
+#ifdef SYSMON_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+qint64 Instrumentation::monotonicNs()
+{
+    return clockNs(CLOCK_MONOTONIC);
+}
+
+qint64 Instrumentation::threadCpuNs()
+{
+    return clockNs(CLOCK_THREAD_CPUTIME_ID);
+}
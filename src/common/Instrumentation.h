@@ -0,0 +1,134 @@
+/**
+ * ============================================
+ * File: src/common/Instrumentation.h
+ * Description: Self-instrumentation: per-stage timing and allocation counts
+ * ============================================
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <QMutex>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include "LatencyHistogram.h"
+
+/**
+ * @class Probe
+ * @brief Timings of one instrumented stage (a collector, publish, notify)
+ *
+ * Keeps two histograms: wall time (CLOCK_MONOTONIC), which includes
+ * waiting on I/O, forks and being preempted, and thread CPU time
+ * (CLOCK_THREAD_CPUTIME_ID), which is only the work done. A stage whose
+ * wall time is far above its CPU time is blocked, not busy.
+ *
+ * Recorded from one thread at a time; read from any.
+ *
+ * While tracing, each timed call is also a begin/end pair in the
+ * TraceRecorder (category "stage"), on the same clock readings.
+ */
+class Probe
+{
+public:
+    explicit Probe(const QString& name);
+
+    void record(qint64 wallNs, qint64 cpuNs, quint64 allocations);
+    void clear();
+
+    const QString& name() const { return m_name; }
+    const char* traceName() const { return m_traceName; }
+    quint64 calls() const { return m_wall.count(); }
+    const LatencyHistogram& wall() const { return m_wall; }
+    const LatencyHistogram& cpu() const { return m_cpu; }
+
+    /**
+     * @brief Heap allocations over all calls (0 unless counting is built in)
+     */
+    quint64 allocations() const { return m_allocations.load(std::memory_order_relaxed); }
+
+private:
+    QString m_name;
+    const char* m_traceName;
+    LatencyHistogram m_wall;
+    LatencyHistogram m_cpu;
+    std::atomic<quint64> m_allocations;
+};
+
+/**
+ * @class ScopeTimer
+ * @brief Times the enclosing scope into a Probe
+ *
+ * Reads both clocks (and the thread's allocation count) on construction
+ * and again on destruction. A null probe makes it a no-op.
+ */
+class ScopeTimer
+{
+public:
+    explicit ScopeTimer(Probe* probe);
+    ~ScopeTimer();
+
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
+
+private:
+    Probe* m_probe;
+    qint64 m_wallStart;
+    qint64 m_cpuStart;
+    quint64 m_allocationsStart;
+};
+
+/**
+ * @class Instrumentation
+ * @brief The set of probes, and a report of them for QML
+ *
+ * Heap allocations are counted per thread by a replacement global
+ * operator new, compiled in only with SYSMON_COUNT_ALLOCATIONS
+ * (CMake option COUNT_ALLOCATIONS): the counter is one thread_local
+ * increment per allocation, but replacing operator new is not something
+ * a release image should do unasked.
+ */
+class Instrumentation
+{
+public:
+    Instrumentation() = default;
+
+    Instrumentation(const Instrumentation&) = delete;
+    Instrumentation& operator=(const Instrumentation&) = delete;
+
+    /**
+     * @brief Probe for a stage, created on first use (thread-safe)
+     *
+     * The pointer stays valid for the lifetime of this object.
+     */
+    Probe* probe(const QString& name);
+
+    /**
+     * @brief One map per probe, in creation order: name, calls, wallP50,
+     *        wallP99, wallMax, cpuP50, cpuP99 (microseconds), allocations
+     *        (per call, -1 when not counted)
+     */
+    QVariantList report() const;
+
+    /**
+     * @brief Forget everything recorded so far
+     */
+    void clear();
+
+    /**
+     * @brief Allocations made by the calling thread (0 without counting)
+     */
+    static quint64 threadAllocations();
+    static bool countsAllocations();
+
+    static qint64 monotonicNs();
+    static qint64 threadCpuNs();
+
+private:
+    mutable QMutex m_mutex;
+    QVector<std::shared_ptr<Probe>> m_probes;
+};
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,83 @@
+/**
+ * ============================================
+ * File: src/common/LatencyHistogram.cpp
+ * Description: Latency histogram implementation
+ * ============================================
+ */
+
+#include "LatencyHistogram.h"
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+    : m_count(0)
+    , m_max(0)
+{
+    for (std::atomic<quint32>& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(quint64 micros)
+{
+    micros = qMin(micros, MAX_VALUE);
+
+    m_buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    // Single writer: a plain compare is enough
+    if (micros > m_max.load(std::memory_order_relaxed)) {
+        m_max.store(micros, std::memory_order_relaxed);
+    }
+}
+
+quint64 LatencyHistogram::quantile(double q) const
+{
+    const quint64 total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the wanted value, 1-based
+    const quint64 rank = qMax<quint64>(1, static_cast<quint64>(std::ceil(qBound(0.0, q, 1.0) * total)));
+
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return qMin(bucketTop(i), max());
+        }
+    }
+    return max();
+}
+
+void LatencyHistogram::clear()
+{
+    for (std::atomic<quint32>& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketFor(quint64 micros)
+{
+    if (micros < SUB_COUNT) {
+        return static_cast<int>(micros);
+    }
+
+    // Power of two, then which of its SUB_COUNT slices
+    const int magnitude = 63 - __builtin_clzll(micros);
+    const int sub = static_cast<int>((micros >> (magnitude - SUB_BITS)) & (SUB_COUNT - 1));
+    return (magnitude - SUB_BITS + 1) * SUB_COUNT + sub;
+}
+
+quint64 LatencyHistogram::bucketTop(int bucket)
+{
+    if (bucket < SUB_COUNT) {
+        return static_cast<quint64>(bucket);
+    }
+
+    const int shift = bucket / SUB_COUNT - 1;
+    const quint64 lower = static_cast<quint64>(SUB_COUNT + bucket % SUB_COUNT) << shift;
+    return lower + (quint64(1) << shift) - 1;
+}
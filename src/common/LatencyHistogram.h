@@ -0,0 +1,70 @@
+/**
+ * ============================================
+ * File: src/common/LatencyHistogram.h
+ * Description: Fixed-bucket log-linear histogram of durations
+ * ============================================
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @class LatencyHistogram
+ * @brief HDR-style histogram of microsecond durations
+ *
+ * Values below 2^SUB_BITS have a bucket each; above that, every power of
+ * two is split into 2^SUB_BITS equal buckets, so any value read back is
+ * within 1/2^SUB_BITS (12.5%) of one recorded, from 1 us up to about a
+ * minute. The buckets are a fixed array: recording is a bit scan and one
+ * relaxed increment, with no allocation and no lock.
+ *
+ * One thread records; any thread may read. A reader racing a writer can
+ * see a count one short, which does not matter for a display.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Count one duration (clamped to MAX_VALUE)
+     */
+    void record(quint64 micros);
+
+    /**
+     * @brief Duration at quantile q (0..1): the top of its bucket, 0 when empty
+     */
+    quint64 quantile(double q) const;
+
+    /**
+     * @brief Largest duration recorded (exact, not bucketed)
+     */
+    quint64 max() const { return m_max.load(std::memory_order_relaxed); }
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+
+    void clear();
+
+    static constexpr int SUB_BITS = 3;
+    static constexpr int MAX_MAGNITUDE = 26;                        // 2^26 us = 67 s
+    static constexpr quint64 MAX_VALUE = (quint64(1) << (MAX_MAGNITUDE + 1)) - 1;
+
+private:
+    static int bucketFor(quint64 micros);
+    static quint64 bucketTop(int bucket);
+
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BITS + 2) * SUB_COUNT;
+
+    std::atomic<quint32> m_buckets[BUCKET_COUNT];
+    std::atomic<quint64> m_count;
+    std::atomic<quint64> m_max;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -15,10 +15,75 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QThread>
+#include <csignal>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Fixed-width level tag used in console and file lines
+ */
+const char* levelName(int level)
+{
+    switch (level) {
+        case LOG_LEVEL_CRITICAL: return "CRIT";
+        case LOG_LEVEL_ERROR:    return "ERROR";
+        case LOG_LEVEL_WARNING:  return "WARN";
+        case LOG_LEVEL_INFO:     return "INFO";
+        default:                 return "DEBUG";
+    }
+}
+
+/**
+ * @brief Category names, in LogCategory bit order
+ */
+const char* const CATEGORY_NAMES[] = {
+    "general", "cpu", "memory", "storage", "network", "process", "history", "ui"
+};
+constexpr int CATEGORY_COUNT = sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]);
+
+const char* categoryName(quint32 category)
+{
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        if (category & (1u << i)) {
+            return CATEGORY_NAMES[i];
+        }
+    }
+    return "general";
+}
+
+/**
+ * @brief Level from "0".."5" or a name ("debug", "warn", ...), -1 if neither
+ */
+int parseLevel(const QString& text)
+{
+    bool isNumber = false;
+    const int number = text.toInt(&isNumber);
+    if (isNumber) {
+        return number;
+    }
+
+    const QString name = text.trimmed().toUpper();
+    if (name == "OFF")                         return LOG_LEVEL_OFF;
+    if (name == "CRIT" || name == "CRITICAL")  return LOG_LEVEL_CRITICAL;
+    if (name == "ERROR")                       return LOG_LEVEL_ERROR;
+    if (name == "WARN" || name == "WARNING")   return LOG_LEVEL_WARNING;
+    if (name == "INFO")                        return LOG_LEVEL_INFO;
+    if (name == "DEBUG")                       return LOG_LEVEL_DEBUG;
+    return -1;
+}
+
+} // namespace
 
 Logger::Logger()
     : QObject(nullptr)
-    , m_logLevel(LOG_LEVEL)
+    , m_flushThread(nullptr)
+    , m_signalNotifier(nullptr)
     , m_maxLogEntries(DEFAULT_MAX_ENTRIES)
     , m_logToFile(false)
     , m_logFilePath("")
@@ -27,10 +92,20 @@ Logger::Logger()
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(appDataPath);
     m_logFilePath = appDataPath + "/system-monitor.log";
+
+    m_flushThread = QThread::create([this]() { run(); });
+    m_flushThread->setObjectName("LoggerFlush");
+    m_flushThread->start(QThread::LowPriority);
 }
 
 Logger::~Logger()
 {
+    // Let the flush thread write out whatever is still queued
+    m_running.store(false, std::memory_order_release);
+    wakeFlushThread();
+    m_flushThread->wait();
+    delete m_flushThread;
+
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
@@ -42,103 +117,133 @@ Logger& Logger::instance()
     return inst;
 }
 
-void Logger::debug(const QString& message)
+qint64 Logger::currentTimeMs()
 {
-    if (m_logLevel >= LOG_LEVEL_DEBUG) {
-        log("DEBUG", message);
-    }
+    // clock_gettime() goes through the vDSO: no syscall, no allocation
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<qint64>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
 }
 
-void Logger::info(const QString& message)
+void Logger::run()
 {
-    if (m_logLevel >= LOG_LEVEL_INFO) {
-        log("INFO", message);
+    while (m_running.load(std::memory_order_acquire)) {
+        drain();
+
+        // A wakeup sent while draining is still pending here, not lost
+        QMutexLocker locker(&m_wakeMutex);
+        if (!m_wakePending) {
+            m_wake.wait(&m_wakeMutex, FLUSH_INTERVAL_MS);
+        }
+        m_wakePending = false;
     }
+
+    drain();
 }
 
-void Logger::warning(const QString& message)
+void Logger::wakeFlushThread()
 {
-    if (m_logLevel >= LOG_LEVEL_WARNING) {
-        log("WARN", message);
-    }
+    QMutexLocker locker(&m_wakeMutex);
+    m_wakePending = true;
+    m_wake.wakeOne();
 }
 
-void Logger::error(const QString& message)
+void Logger::drain()
 {
-    if (m_logLevel >= LOG_LEVEL_ERROR) {
-        log("ERROR", message);
+    QVector<Entry> batch;
+
+    while (m_queue.tryPop([&](Record& record) {
+        Entry entry;
+        entry.timeMs = record.timeMs;
+        entry.category = record.category;
+        entry.level = record.level;
+        entry.message = formatRecord(record);
+        batch.append(entry);
+
+        // Release string references held by the slot
+        for (int i = 0; i < record.argCount; ++i) {
+            record.args[i].text.clear();
+        }
+    })) {
     }
-}
 
-void Logger::critical(const QString& message)
-{
-    if (m_logLevel >= LOG_LEVEL_CRITICAL) {
-        log("CRIT", message);
+    const quint64 dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDrops) {
+        Entry entry;
+        entry.timeMs = currentTimeMs();
+        entry.category = LogCategory::General;
+        entry.level = LOG_LEVEL_WARNING;
+        entry.message = QString("Logger: queue full, %1 messages dropped").arg(dropped - m_reportedDrops);
+        batch.append(entry);
+        m_reportedDrops = dropped;
     }
-}
 
-void Logger::log(const QString& level, const QString& message)
-{
-    QMutexLocker locker(&m_mutex);
-    
-    QString formatted = formatMessage(level, message);
-    
-    // Console output
-#if LOG_LEVEL >= LOG_LEVEL_DEBUG
-    if (level == "DEBUG") {
-        qDebug().noquote() << formatted;
-    } else
-#endif
-#if LOG_LEVEL >= LOG_LEVEL_INFO
-    if (level == "INFO") {
-        qInfo().noquote() << formatted;
-    } else
-#endif
-#if LOG_LEVEL >= LOG_LEVEL_WARNING
-    if (level == "WARN") {
-        qWarning().noquote() << formatted;
-    } else
-#endif
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    for (const Entry& entry : batch) {
+        const QString line = QString("[%1] [%2] [%3] %4")
+            .arg(QDateTime::fromMSecsSinceEpoch(entry.timeMs).toString("yyyy-MM-dd hh:mm:ss.zzz"))
+            .arg(QString::fromLatin1(levelName(entry.level)), -5)
+            .arg(QString::fromLatin1(categoryName(entry.category)), -7)
+            .arg(entry.message);
+
+        m_fileBatch.append(line.toUtf8());
+        m_fileBatch.append('\n');
+    }
+
+    // Console output straight to stderr, one write per batch. Not through
+    // qDebug()/qInfo(): Release compiles those out, and a level raised at
+    // runtime must still be visible.
+    fwrite(m_fileBatch.constData(), 1, static_cast<size_t>(m_fileBatch.size()), stderr);
+
     {
-        qCritical().noquote() << formatted;
-    }
-    
-    // File output
-    if (m_logToFile) {
-        writeToFile(formatted);
-    }
-    
-    // Store in memory for QML access
-    QVariantMap entry;
-    entry["time"] = QTime::currentTime().toString("hh:mm:ss");
-    entry["level"] = level;
-    entry["message"] = message;
-    
-    m_logs.prepend(entry);
-    
-    while (m_logs.size() > m_maxLogEntries) {
-        m_logs.removeLast();
-    }
-    
+        QMutexLocker locker(&m_mutex);
+
+        // File output, one write and one flush per batch
+        if (m_logToFile) {
+            writeToFile(m_fileBatch);
+        }
+
+        // Store in memory for QML access
+        for (const Entry& entry : batch) {
+            m_entries.push(entry);
+        }
+    }
+    m_fileBatch.clear();
+
     emit logsChanged();
-    emit newLogEntry(level, message);
+    for (const Entry& entry : batch) {
+        emit newLogEntry(QString::fromLatin1(levelName(entry.level)), entry.message);
+    }
 }
 
-QString Logger::formatMessage(const QString& level, const QString& message)
+QString Logger::formatRecord(const Record& record) const
 {
-    return QString("[%1] [%2] %3")
-        .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz"))
-        .arg(level, -5)
-        .arg(message);
+    QString message = QString::fromUtf8(record.format);
+
+    for (int i = 0; i < record.argCount; ++i) {
+        const Arg& arg = record.args[i];
+        switch (arg.type) {
+            case Arg::Int:     message = message.arg(arg.i); break;
+            case Arg::UInt:    message = message.arg(arg.u); break;
+            case Arg::Double:  message = message.arg(arg.d); break;
+            case Arg::Literal: message = message.arg(QString::fromUtf8(arg.literal)); break;
+            case Arg::Text:    message = message.arg(arg.text); break;
+        }
+    }
+
+    return message;
 }
 
-void Logger::writeToFile(const QString& formattedMessage)
+void Logger::writeToFile(const QByteArray& lines)
 {
     // Check file size and rotate if needed
     if (m_logFile.isOpen() && m_logFile.size() > MAX_FILE_SIZE) {
         rotateLogFile();
     }
-    
+
     // Open file if not open
     if (!m_logFile.isOpen()) {
         m_logFile.setFileName(m_logFilePath);
@@ -148,10 +253,9 @@ void Logger::writeToFile(const QString& formattedMessage)
             return;
         }
     }
-    
-    QTextStream stream(&m_logFile);
-    stream << formattedMessage << "\n";
-    stream.flush();
+
+    m_logFile.write(lines);
+    m_logFile.flush();
 }
 
 void Logger::rotateLogFile()
@@ -159,12 +263,12 @@ void Logger::rotateLogFile()
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
-    
+
     // Rename old file
     QString backupPath = m_logFilePath + ".old";
     QFile::remove(backupPath);
     QFile::rename(m_logFilePath, backupPath);
-    
+
     // Open new file
     m_logFile.setFileName(m_logFilePath);
     if (!m_logFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
@@ -176,49 +280,152 @@ void Logger::setLogToFile(bool enabled)
 {
     QMutexLocker locker(&m_mutex);
     m_logToFile = enabled;
-    
+
     if (!enabled && m_logFile.isOpen()) {
         m_logFile.close();
     }
 }
 
+bool Logger::isLogToFile() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_logToFile;
+}
+
 void Logger::setLogFilePath(const QString& path)
 {
     QMutexLocker locker(&m_mutex);
-    
+
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
-    
+
     m_logFilePath = path;
 }
 
 void Logger::setMaxLogEntries(int max)
 {
     QMutexLocker locker(&m_mutex);
-    m_maxLogEntries = qMax(10, max);
-    
-    while (m_logs.size() > m_maxLogEntries) {
-        m_logs.removeLast();
-    }
+    m_maxLogEntries = qBound(10, max, ENTRY_CAPACITY);
 }
 
 void Logger::setLogLevel(int level)
+{
+    const int bounded = qBound(LOG_LEVEL_OFF, level, maxLogLevel());
+    if (s_level.exchange(bounded, std::memory_order_relaxed) != bounded) {
+        emit logLevelChanged(bounded);
+    }
+}
+
+void Logger::setCategories(quint32 mask)
+{
+    s_categories.store(mask & LogCategory::All, std::memory_order_relaxed);
+}
+
+void Logger::configureFromEnvironment()
+{
+    const QString level = qEnvironmentVariable("SYSMON_LOG_LEVEL");
+    if (!level.isEmpty()) {
+        const int parsed = parseLevel(level);
+        if (parsed >= 0) {
+            setLogLevel(parsed);
+        }
+    }
+
+    const QString categories = qEnvironmentVariable("SYSMON_LOG_CATEGORIES");
+    if (!categories.isEmpty()) {
+        quint32 mask = 0;
+        for (const QString& part : categories.split(',', Qt::SkipEmptyParts)) {
+            const QString name = part.trimmed().toLower();
+            if (name == "all") {
+                mask = LogCategory::All;
+                break;
+            }
+            for (int i = 0; i < CATEGORY_COUNT; ++i) {
+                if (name == QLatin1String(CATEGORY_NAMES[i])) {
+                    mask |= 1u << i;
+                }
+            }
+        }
+        setCategories(mask);
+    }
+}
+
+void Logger::installSignalHandlers()
+{
+    if (m_signalNotifier || pipe2(s_signalPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        return;
+    }
+
+    m_signalNotifier = new QSocketNotifier(s_signalPipe[0], QSocketNotifier::Read, this);
+    connect(m_signalNotifier, &QSocketNotifier::activated, this, &Logger::onSignalPipe);
+
+    struct sigaction action = {};
+    action.sa_handler = &Logger::onSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &action, nullptr);
+    sigaction(SIGUSR2, &action, nullptr);
+}
+
+void Logger::onSignal(int signal)
+{
+    // Async-signal context: atomics and write() only
+    const int step = signal == SIGUSR1 ? 1 : -1;
+    const int level = qBound(LOG_LEVEL_OFF, s_level.load(std::memory_order_relaxed) + step, maxLogLevel());
+    s_level.store(level, std::memory_order_relaxed);
+
+    const char byte = static_cast<char>(level);
+    const ssize_t written = write(s_signalPipe[1], &byte, 1);
+    (void)written;
+}
+
+void Logger::onSignalPipe()
+{
+    char bytes[16];
+    while (read(s_signalPipe[0], bytes, sizeof(bytes)) > 0) {
+    }
+
+    const int level = logLevel();
+    LOG_INFO("Logger: level set to %1 by signal", getLogLevelName());
+    emit logLevelChanged(level);
+}
+
+QVariantList Logger::logs() const
 {
     QMutexLocker locker(&m_mutex);
-    m_logLevel = qBound(LOG_LEVEL_OFF, level, LOG_LEVEL_DEBUG);
+
+    // Newest first, built only when QML asks
+    QVariantList list;
+    const int count = qMin(m_entries.size(), m_maxLogEntries);
+    list.reserve(count);
+
+    for (int i = m_entries.size() - 1; i >= m_entries.size() - count; --i) {
+        const Entry& entry = m_entries.at(i);
+
+        QVariantMap item;
+        item["time"] = QDateTime::fromMSecsSinceEpoch(entry.timeMs).toString("hh:mm:ss");
+        item["level"] = QString::fromLatin1(levelName(entry.level));
+        item["category"] = QString::fromLatin1(categoryName(entry.category));
+        item["message"] = entry.message;
+        list.append(item);
+    }
+
+    return list;
 }
 
 void Logger::clearLogs()
 {
-    QMutexLocker locker(&m_mutex);
-    m_logs.clear();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.clear();
+    }
     emit logsChanged();
 }
 
 QString Logger::getLogLevelName() const
 {
-    switch (m_logLevel) {
+    switch (logLevel()) {
         case LOG_LEVEL_OFF:      return "OFF";
         case LOG_LEVEL_CRITICAL: return "CRITICAL";
         case LOG_LEVEL_ERROR:    return "ERROR";
@@ -229,4 +436,4 @@ QString Logger::getLogLevelName() const
     }
 }
 
-#endif  // LOG_LEVEL > LOG_LEVEL_OFF
\ No newline at end of file
+#endif  // LOG_LEVEL > LOG_LEVEL_OFF
@@ -3,18 +3,25 @@
  * File: src/common/Logger.h
  * Description: High-performance logging system with compile-time optimization
  * 
- * LOG_LEVEL (defined in CMakeLists.txt):
- *   0 = OFF      - No logging (Release)
+ * LOG_LEVEL (defined in CMakeLists.txt) is the compiled-in ceiling:
+ *   0 = OFF      - No logging
  *   1 = CRITICAL - Critical errors only
  *   2 = ERROR    - Errors and above
  *   3 = WARNING  - Warnings and above
- *   4 = INFO     - Info and above
+ *   4 = INFO     - Info and above (Release)
  *   5 = DEBUG    - All messages (Debug)
+ * Call sites above the ceiling compile to nothing. Below it, the level
+ * and category mask are checked at runtime before any argument is
+ * evaluated; LOG_DEFAULT_LEVEL is the level at startup, changed later
+ * from Settings, SIGUSR1/SIGUSR2 or SYSMON_LOG_LEVEL/SYSMON_LOG_CATEGORIES.
+ *
+ * Each .cpp may set its category before its includes:
+ *   #define LOG_CATEGORY LogCategory::Cpu
  * 
- * Usage:
+ * Usage (format is a string literal, %1..%4 are filled in later):
  *   LOG_DEBUG("Debug message");
- *   LOG_INFO("Info message");
- *   LOG_WARNING("Warning message");
+ *   LOG_INFO("Mount point changed to: %1", path);
+ *   LOG_WARNING("RrdArchive: cannot open %1: %2", path, reason);
  *   LOG_ERROR("Error message");
  *   LOG_CRITICAL("Critical message");
  * ============================================================================
@@ -40,42 +47,77 @@
     #define LOG_LEVEL LOG_LEVEL_OFF
 #endif
 
+// Runtime level at startup, at most the ceiling
+#ifndef LOG_DEFAULT_LEVEL
+    #define LOG_DEFAULT_LEVEL LOG_LEVEL
+#endif
+
+// ============================================================================
+// Log Categories (bit mask, runtime-filterable)
+// ============================================================================
+namespace LogCategory {
+enum : quint32 {
+    General = 1u << 0,      // Sampler, scheduler, anything unassigned
+    Cpu     = 1u << 1,      // CPU and GPU
+    Memory  = 1u << 2,
+    Storage = 1u << 3,
+    Network = 1u << 4,
+    Process = 1u << 5,
+    History = 1u << 6,      // Archives, percentiles
+    Ui      = 1u << 7,      // Controllers, settings, QML glue
+
+    All     = (1u << 8) - 1
+};
+}
+
+#ifndef LOG_CATEGORY
+    #define LOG_CATEGORY LogCategory::General
+#endif
+
 // ============================================================================
-// Compile-Time Log Macros (Zero overhead when disabled)
+// Log Macros (compiled out above LOG_LEVEL, runtime-checked below it)
 // ============================================================================
 
+// Arguments are only evaluated when the message passes both filters
+#define LOG_AT(level, ...) \
+    do { \
+        if (Logger::isEnabled(level, LOG_CATEGORY)) { \
+            Logger::instance().log(level, LOG_CATEGORY, __VA_ARGS__); \
+        } \
+    } while (0)
+
 #if LOG_LEVEL >= LOG_LEVEL_DEBUG
-    #define LOG_DEBUG(msg)    Logger::instance().debug(msg)
+    #define LOG_DEBUG(...)    LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
 #else
-    #define LOG_DEBUG(msg)    ((void)0)
+    #define LOG_DEBUG(...)    ((void)0)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_INFO
-    #define LOG_INFO(msg)     Logger::instance().info(msg)
+    #define LOG_INFO(...)     LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
 #else
-    #define LOG_INFO(msg)     ((void)0)
+    #define LOG_INFO(...)     ((void)0)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_WARNING
-    #define LOG_WARNING(msg)  Logger::instance().warning(msg)
-    #define LOG_WARN(msg)     Logger::instance().warning(msg)
+    #define LOG_WARNING(...)  LOG_AT(LOG_LEVEL_WARNING, __VA_ARGS__)
+    #define LOG_WARN(...)     LOG_AT(LOG_LEVEL_WARNING, __VA_ARGS__)
 #else
-    #define LOG_WARNING(msg)  ((void)0)
-    #define LOG_WARN(msg)     ((void)0)
+    #define LOG_WARNING(...)  ((void)0)
+    #define LOG_WARN(...)     ((void)0)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_ERROR
-    #define LOG_ERROR(msg)    Logger::instance().error(msg)
+    #define LOG_ERROR(...)    LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
 #else
-    #define LOG_ERROR(msg)    ((void)0)
+    #define LOG_ERROR(...)    ((void)0)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_CRITICAL
-    #define LOG_CRITICAL(msg) Logger::instance().critical(msg)
-    #define LOG_CRIT(msg)     Logger::instance().critical(msg)
+    #define LOG_CRITICAL(...) LOG_AT(LOG_LEVEL_CRITICAL, __VA_ARGS__)
+    #define LOG_CRIT(...)     LOG_AT(LOG_LEVEL_CRITICAL, __VA_ARGS__)
 #else
-    #define LOG_CRITICAL(msg) ((void)0)
-    #define LOG_CRIT(msg)     ((void)0)
+    #define LOG_CRITICAL(...) ((void)0)
+    #define LOG_CRIT(...)     ((void)0)
 #endif
 
 // ============================================================================
@@ -86,12 +128,40 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QFile>
 #include <QVariantList>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include "MpscQueue.h"
+#include "RingBuffer.h"
+
+class QThread;
+class QSocketNotifier;
 
 /**
  * @class Logger
- * @brief Thread-safe singleton logger with file and console output
+ * @brief Asynchronous singleton logger with file and console output
+ *
+ * A LOG_* call only captures what it was given: it reserves a fixed-size
+ * record in a lock-free MpscQueue and stores the time, level, format
+ * literal and up to MAX_ARGS arguments (numbers by value, QStrings by
+ * implicitly shared copy), without formatting or allocating. The format
+ * literal's address serves as its interned id, so it is never copied.
+ *
+ * A background flush thread wakes every FLUSH_INTERVAL_MS (at once for
+ * errors), formats the queued records, prints them, writes them to the
+ * log file in one batch with one flush, rotates the file, and appends to
+ * the in-memory list QML reads. If the queue fills up, records are
+ * dropped and counted rather than blocking the caller; the count is
+ * logged once the flush thread catches up.
+ *
+ * The runtime level and category mask are plain atomics read by the
+ * LOG_* macros, so a filtered-out call costs two relaxed loads and a
+ * branch. SIGUSR1/SIGUSR2 step the level up/down from a signal handler
+ * (only atomics are touched there); a self-pipe then reports the change
+ * on the GUI thread through logLevelChanged().
  */
 class Logger : public QObject
 {
@@ -110,58 +180,230 @@ public:
     Logger(Logger&&) = delete;
     Logger& operator=(Logger&&) = delete;
 
-    // ==================== Logging Methods ====================
-    void debug(const QString& message);
-    void info(const QString& message);
-    void warning(const QString& message);
-    void error(const QString& message);
-    void critical(const QString& message);
+    // ==================== Logging ====================
+
+    /**
+     * @brief Whether a message at level in category would be kept
+     */
+    static bool isEnabled(int level, quint32 category)
+    {
+        return level <= s_level.load(std::memory_order_relaxed)
+            && (category & s_categories.load(std::memory_order_relaxed)) != 0;
+    }
+
+    /**
+     * @brief Queue one message (what the LOG_* macros call)
+     * @param format String literal with %1..%n placeholders
+     * @param args Integers, floating point, QStrings or string literals
+     */
+    template <size_t N, typename... Args>
+    void log(int level, quint32 category, const char (&format)[N], const Args&... args);
 
     // ==================== Configuration ====================
     void setLogToFile(bool enabled);
     void setLogFilePath(const QString& path);
     void setMaxLogEntries(int max);
+
+    /**
+     * @brief Set the runtime level, clamped to OFF..LOG_LEVEL
+     */
     void setLogLevel(int level);
-    
-    int logLevel() const { return m_logLevel; }
-    bool isLogToFile() const { return m_logToFile; }
+    void setCategories(quint32 mask);
+
+    static int logLevel() { return s_level.load(std::memory_order_relaxed); }
+    static quint32 categories() { return s_categories.load(std::memory_order_relaxed); }
+    static constexpr int maxLogLevel() { return LOG_LEVEL; }
+    bool isLogToFile() const;
+
+    /**
+     * @brief Apply SYSMON_LOG_LEVEL (0-5 or a name) and SYSMON_LOG_CATEGORIES
+     *        (comma-separated names, or "all")
+     */
+    void configureFromEnvironment();
+
+    /**
+     * @brief SIGUSR1 = one level more verbose, SIGUSR2 = one level less
+     *
+     * Call once from the GUI thread.
+     */
+    void installSignalHandlers();
 
     // ==================== QML Access ====================
-    QVariantList logs() const { return m_logs; }
+    QVariantList logs() const;
     Q_INVOKABLE void clearLogs();
     Q_INVOKABLE QString getLogLevelName() const;
 
 signals:
     void logsChanged();
     void newLogEntry(const QString& level, const QString& message);
+    void logLevelChanged(int level);
 
 private:
+    static constexpr int MAX_ARGS = 4;
+
+    /**
+     * @brief One captured argument
+     */
+    struct Arg {
+        enum Type : quint8 { Int, UInt, Double, Literal, Text };
+
+        Type type = Int;
+        union {
+            qint64 i = 0;
+            quint64 u;
+            double d;
+            const char* literal;
+        };
+        QString text;
+    };
+
+    /**
+     * @brief What a LOG_* call leaves in the queue
+     */
+    struct Record {
+        qint64 timeMs = 0;          // Wall clock, ms since the epoch
+        const char* format = nullptr;
+        quint32 category = 0;
+        quint8 level = 0;
+        quint8 argCount = 0;
+        Arg args[MAX_ARGS];
+    };
+
+    /**
+     * @brief A formatted message kept for QML
+     */
+    struct Entry {
+        qint64 timeMs = 0;
+        quint32 category = 0;
+        quint8 level = 0;
+        QString message;
+    };
+
     Logger();
     ~Logger() override;
 
-    void log(const QString& level, const QString& message);
-    void writeToFile(const QString& formattedMessage);
+    static qint64 currentTimeMs();
+    static void onSignal(int signal);
+    void onSignalPipe();
+
+    // Argument capture, one overload per accepted type
+    template <typename T>
+    static typename std::enable_if<std::is_arithmetic<T>::value>::type capture(Arg& arg, T value);
+    static void capture(Arg& arg, const QString& value);
+    template <size_t N>
+    static void capture(Arg& arg, const char (&value)[N]);
+
+    // Flush thread
+    void run();
+    void wakeFlushThread();
+    void drain();
+    QString formatRecord(const Record& record) const;
+    void writeToFile(const QByteArray& lines);
     void rotateLogFile();
-    QString formatMessage(const QString& level, const QString& message);
 
 private:
-    QMutex m_mutex;
-    QVariantList m_logs;
+    static constexpr int QUEUE_CAPACITY = 512;
+    static constexpr int ENTRY_CAPACITY = 256;
+
+    // Hot path state; static so the macros reach them without instance()
+    static inline std::atomic<int> s_level{LOG_DEFAULT_LEVEL};
+    static inline std::atomic<quint32> s_categories{LogCategory::All};
+    MpscQueue<Record, QUEUE_CAPACITY> m_queue;
+    std::atomic<quint64> m_dropped{0};
+
+    // Flush thread and its wakeup
+    QThread* m_flushThread;
+    QMutex m_wakeMutex;
+    QWaitCondition m_wake;
+    bool m_wakePending = false;     // Guarded by m_wakeMutex
+    std::atomic<bool> m_running{true};
+    quint64 m_reportedDrops = 0;
+
+    // Signal handler -> GUI thread (self-pipe)
+    static inline int s_signalPipe[2] = { -1, -1 };
+    QSocketNotifier* m_signalNotifier;
+
+    // File and QML state, guarded by m_mutex
+    mutable QMutex m_mutex;
+    RingBuffer<Entry, ENTRY_CAPACITY> m_entries;
     QFile m_logFile;
-    
-    int m_logLevel;
+    QByteArray m_fileBatch;
     int m_maxLogEntries;
     bool m_logToFile;
     QString m_logFilePath;
-    
+
     static constexpr int DEFAULT_MAX_ENTRIES = 100;
     static constexpr qint64 MAX_FILE_SIZE = 1024 * 1024;  // 1MB
+    static constexpr int FLUSH_INTERVAL_MS = 100;
 };
 
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template <size_t N, typename... Args>
+void Logger::log(int level, quint32 category, const char (&format)[N], const Args&... args)
+{
+    static_assert(sizeof...(Args) <= MAX_ARGS, "LOG_* takes at most MAX_ARGS arguments");
+
+    const qint64 timeMs = currentTimeMs();
+    const bool pushed = m_queue.tryPush([&](Record& record) {
+        record.timeMs = timeMs;
+        record.format = format;
+        record.category = category;
+        record.level = static_cast<quint8>(level);
+        record.argCount = static_cast<quint8>(sizeof...(Args));
+
+        int index = 0;
+        (void)index;
+        (capture(record.args[index++], args), ...);
+    });
+
+    if (!pushed) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Errors are written out at once, not at the next flush interval
+    if (level <= LOG_LEVEL_ERROR) {
+        wakeFlushThread();
+    }
+}
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type Logger::capture(Arg& arg, T value)
+{
+    if constexpr (std::is_floating_point<T>::value) {
+        arg.type = Arg::Double;
+        arg.d = static_cast<double>(value);
+    }
+    else if constexpr (std::is_signed<T>::value) {
+        arg.type = Arg::Int;
+        arg.i = static_cast<qint64>(value);
+    }
+    else {
+        arg.type = Arg::UInt;
+        arg.u = static_cast<quint64>(value);
+    }
+}
+
+inline void Logger::capture(Arg& arg, const QString& value)
+{
+    arg.type = Arg::Text;
+    arg.text = value;
+}
+
+template <size_t N>
+void Logger::capture(Arg& arg, const char (&value)[N])
+{
+    arg.type = Arg::Literal;
+    arg.literal = value;
+}
+
 #else  // LOG_LEVEL == LOG_LEVEL_OFF
 
 /**
- * @brief Stub Logger class for Release builds
+ * @brief Stub Logger class for builds with LOG_LEVEL=0
  * Provides minimal interface with zero overhead
  */
 class Logger
@@ -171,23 +413,29 @@ public:
         static Logger inst;
         return inst;
     }
-    
+
     // Empty implementations - will be optimized out
-    inline void debug(const QString&) {}
-    inline void info(const QString&) {}
-    inline void warning(const QString&) {}
-    inline void error(const QString&) {}
-    inline void critical(const QString&) {}
-    
+    static bool isEnabled(int, quint32) { return false; }
+
+    template <typename... Args>
+    inline void log(int, quint32, const Args&...) {}
+
     inline void setLogToFile(bool) {}
     inline void setLogFilePath(const QString&) {}
     inline void setMaxLogEntries(int) {}
     inline void setLogLevel(int) {}
-    
+    inline void setCategories(quint32) {}
+    inline void configureFromEnvironment() {}
+    inline void installSignalHandlers() {}
+
+    static int logLevel() { return LOG_LEVEL_OFF; }
+    static quint32 categories() { return 0; }
+    static constexpr int maxLogLevel() { return LOG_LEVEL_OFF; }
+
 private:
     Logger() = default;
 };
 
 #endif  // LOG_LEVEL > LOG_LEVEL_OFF
 
-#endif  // LOGGER_H
\ No newline at end of file
+#endif  // LOGGER_H
@@ -0,0 +1,134 @@
+/**
+ * ============================================
+ * File: src/common/MpscQueue.h
+ * Description: Bounded lock-free multi-producer/single-consumer queue
+ * ============================================
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+/**
+ * @class MpscQueue
+ * @brief Fixed-capacity queue any thread can push to, one thread pops
+ *
+ * Each slot carries a sequence number (Vyukov's bounded queue): a
+ * producer claims a position with one compare-and-swap, fills the slot
+ * in place and publishes it by bumping the sequence; the consumer sees a
+ * slot as ready once its sequence says so. Nothing locks or allocates,
+ * and a full queue makes tryPush() fail instead of waiting, so producers
+ * never block on a slow consumer.
+ *
+ * Slots are reused, not destroyed: the consumer should release what a
+ * slot holds (e.g. reset its strings) before returning it.
+ *
+ * @tparam T Slot payload (default-constructible)
+ * @tparam N Capacity, a power of two
+ */
+template <typename T, int N>
+class MpscQueue
+{
+    static_assert(N > 1 && (N & (N - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue();
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    static constexpr int capacity() { return N; }
+
+    /**
+     * @brief Producer side: claim a slot and fill it in place
+     * @param fill Called as fill(T&) on the claimed slot
+     * @return false if the queue is full (fill is not called)
+     */
+    template <typename Fill>
+    bool tryPush(Fill&& fill);
+
+    /**
+     * @brief Consumer side: hand the oldest slot to consume, then free it
+     * @param consume Called as consume(T&)
+     * @return false if the queue is empty
+     */
+    template <typename Consume>
+    bool tryPop(Consume&& consume);
+
+private:
+    struct Slot {
+        std::atomic<quint64> sequence;
+        T value;
+    };
+
+    static constexpr quint64 MASK = static_cast<quint64>(N) - 1;
+
+    std::array<Slot, N> m_slots;
+
+    // Producers and the consumer on separate cache lines
+    alignas(64) std::atomic<quint64> m_enqueue{0};
+    alignas(64) quint64 m_dequeue = 0;
+};
+
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template <typename T, int N>
+MpscQueue<T, N>::MpscQueue()
+{
+    for (int i = 0; i < N; ++i) {
+        m_slots[i].sequence.store(static_cast<quint64>(i), std::memory_order_relaxed);
+    }
+}
+
+template <typename T, int N>
+template <typename Fill>
+bool MpscQueue<T, N>::tryPush(Fill&& fill)
+{
+    quint64 position = m_enqueue.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;) {
+        slot = &m_slots[position & MASK];
+        const quint64 sequence = slot->sequence.load(std::memory_order_acquire);
+        const qint64 lag = static_cast<qint64>(sequence - position);
+
+        if (lag == 0) {
+            // Slot is free for this position: try to claim it
+            if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (lag < 0) {
+            return false;   // A lap ahead of the consumer: full
+        }
+        else {
+            position = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    fill(slot->value);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, int N>
+template <typename Consume>
+bool MpscQueue<T, N>::tryPop(Consume&& consume)
+{
+    Slot& slot = m_slots[m_dequeue & MASK];
+    if (slot.sequence.load(std::memory_order_acquire) != m_dequeue + 1) {
+        return false;   // Empty, or the producer has not finished filling it
+    }
+
+    consume(slot.value);
+    slot.sequence.store(m_dequeue + N, std::memory_order_release);
+    ++m_dequeue;
+    return true;
+}
+
+#endif // MPSCQUEUE_H
@@ -0,0 +1,118 @@
+/**
+ * ============================================
+ * File: src/common/NetlinkSocket.cpp
+ * Description: NetlinkSocket implementation
+ * ============================================
+ */
+
+#include "NetlinkSocket.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/time.h>
+#include <unistd.h>
+
+NetlinkSocket::~NetlinkSocket()
+{
+    close();
+}
+
+bool NetlinkSocket::open(int protocol, quint32 groups, bool nonBlocking)
+{
+    close();
+
+    int type = SOCK_RAW | SOCK_CLOEXEC;
+    if (nonBlocking) {
+        type |= SOCK_NONBLOCK;
+    }
+
+    m_fd = ::socket(AF_NETLINK, type, protocol);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    sockaddr_nl local;
+    memset(&local, 0, sizeof(local));
+    local.nl_family = AF_NETLINK;
+    local.nl_groups = groups;
+
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+        close();
+        return false;
+    }
+
+    // Never let a lost reply block the sampler forever
+    timeval timeout;
+    timeout.tv_sec = RECEIVE_TIMEOUT_MS / 1000;
+    timeout.tv_usec = (RECEIVE_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    m_buffer.resize(RECEIVE_BUFFER_SIZE);
+    return true;
+}
+
+void NetlinkSocket::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool NetlinkSocket::sendRequest(quint16 type, quint16 flags, const void *payload, size_t payloadLength)
+{
+    if (m_fd < 0) {
+        return false;
+    }
+
+    // Header and payload are sent as one datagram through an iovec pair,
+    // so callers can keep their request structs on the stack
+    nlmsghdr header;
+    memset(&header, 0, sizeof(header));
+    header.nlmsg_len = NLMSG_LENGTH(payloadLength);
+    header.nlmsg_type = type;
+    header.nlmsg_flags = static_cast<quint16>(flags | NLM_F_REQUEST);
+    header.nlmsg_seq = ++m_sequence;
+
+    iovec parts[2];
+    parts[0].iov_base = &header;
+    parts[0].iov_len = NLMSG_HDRLEN;
+    parts[1].iov_base = const_cast<void*>(payload);
+    parts[1].iov_len = payloadLength;
+
+    sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_name = &kernel;
+    message.msg_namelen = sizeof(kernel);
+    message.msg_iov = parts;
+    message.msg_iovlen = 2;
+
+    ssize_t sent;
+    do {
+        sent = ::sendmsg(m_fd, &message, 0);
+    } while (sent < 0 && errno == EINTR);
+
+    return sent == static_cast<ssize_t>(header.nlmsg_len);
+}
+
+qsizetype NetlinkSocket::receive(bool wait)
+{
+    ssize_t length;
+    do {
+        length = ::recv(m_fd, m_buffer.data(), static_cast<size_t>(m_buffer.size()), wait ? 0 : MSG_DONTWAIT);
+    } while (length < 0 && errno == EINTR);
+
+    if (length < 0) {
+        // Nothing pending is not an error for a non-blocking drain;
+        // ENOBUFS (dropped notifications) is, so callers can resync
+        if (!wait && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        }
+        return -1;
+    }
+
+    return static_cast<qsizetype>(length);
+}
@@ -0,0 +1,150 @@
+/**
+ * ============================================
+ * File: src/common/NetlinkSocket.h
+ * Description: Minimal RAII wrapper around a Linux netlink socket
+ * ============================================
+ */
+
+#ifndef NETLINKSOCKET_H
+#define NETLINKSOCKET_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+/**
+ * @class NetlinkSocket
+ * @brief Sends netlink requests and walks the replies without copying
+ *
+ * Used for rtnetlink address/link queries and notifications. Replies are
+ * received into a reusable buffer and each nlmsghdr is passed to a
+ * handler in place, so walking a dump does not allocate per message.
+ */
+class NetlinkSocket
+{
+public:
+    NetlinkSocket() = default;
+    ~NetlinkSocket();
+
+    NetlinkSocket(const NetlinkSocket&) = delete;
+    NetlinkSocket& operator=(const NetlinkSocket&) = delete;
+
+    /**
+     * @brief Open and bind the socket
+     * @param protocol Netlink family (e.g. NETLINK_ROUTE)
+     * @param groups Multicast groups to subscribe to (0 = none)
+     * @param nonBlocking Open with SOCK_NONBLOCK (for event sockets)
+     * @return true on success
+     */
+    bool open(int protocol, quint32 groups = 0, bool nonBlocking = false);
+    void close();
+
+    bool isOpen() const { return m_fd >= 0; }
+    int fd() const { return m_fd; }
+
+    /**
+     * @brief Send a request made of a netlink header plus payload
+     * @param type Message type (e.g. RTM_GETADDR)
+     * @param flags NLM_F_* flags, NLM_F_REQUEST is always added
+     * @return true if the whole message was sent
+     */
+    bool sendRequest(quint16 type, quint16 flags, const void* payload, size_t payloadLength);
+
+    /**
+     * @brief Receive replies to the last request until NLMSG_DONE
+     * @param handler Called as handler(const nlmsghdr*) for every data message
+     * @return false on socket error, timeout or NLMSG_ERROR
+     */
+    template <typename Handler>
+    bool receiveDump(Handler&& handler);
+
+    /**
+     * @brief Process every message already queued on a non-blocking socket
+     * @param handler Called as handler(const nlmsghdr*) for every message
+     * @return Number of messages handled, -1 on error
+     */
+    template <typename Handler>
+    int drain(Handler&& handler);
+
+private:
+    /**
+     * @brief Receive one datagram into m_buffer
+     * @return Bytes received, 0 if nothing is pending, -1 on error
+     */
+    qsizetype receive(bool wait);
+
+private:
+    int m_fd = -1;
+    quint32 m_sequence = 0;
+    QByteArray m_buffer;
+
+    static constexpr int RECEIVE_BUFFER_SIZE = 32 * 1024;
+    static constexpr int RECEIVE_TIMEOUT_MS = 1000;
+};
+
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template <typename Handler>
+bool NetlinkSocket::receiveDump(Handler&& handler)
+{
+    for (;;) {
+        qsizetype length = receive(true);
+        if (length <= 0) {
+            return false;
+        }
+
+        int remaining = static_cast<int>(length);
+        for (const nlmsghdr* msg = reinterpret_cast<const nlmsghdr*>(m_buffer.constData());
+             NLMSG_OK(msg, remaining);
+             msg = NLMSG_NEXT(msg, remaining)) {
+
+            // Skip unsolicited messages (e.g. multicast) interleaved with the dump
+            if (msg->nlmsg_seq != m_sequence) {
+                continue;
+            }
+            if (msg->nlmsg_type == NLMSG_DONE) {
+                return true;
+            }
+            if (msg->nlmsg_type == NLMSG_ERROR) {
+                const nlmsgerr* err = static_cast<const nlmsgerr*>(NLMSG_DATA(msg));
+                return err->error == 0;
+            }
+
+            handler(msg);
+        }
+    }
+}
+
+template <typename Handler>
+int NetlinkSocket::drain(Handler&& handler)
+{
+    int handled = 0;
+
+    for (;;) {
+        qsizetype length = receive(false);
+        if (length < 0) {
+            return -1;
+        }
+        if (length == 0) {
+            return handled;
+        }
+
+        int remaining = static_cast<int>(length);
+        for (const nlmsghdr* msg = reinterpret_cast<const nlmsghdr*>(m_buffer.constData());
+             NLMSG_OK(msg, remaining);
+             msg = NLMSG_NEXT(msg, remaining)) {
+
+            if (msg->nlmsg_type == NLMSG_DONE || msg->nlmsg_type == NLMSG_ERROR) {
+                continue;
+            }
+
+            handler(msg);
+            ++handled;
+        }
+    }
+}
+
+#endif // NETLINKSOCKET_H
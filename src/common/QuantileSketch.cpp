@@ -0,0 +1,133 @@
+/**
+ * ============================================
+ * File: src/common/QuantileSketch.cpp
+ * Description: DDSketch implementation
+ * ============================================
+ */
+
+#include "QuantileSketch.h"
+#include <cmath>
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, int maxBins)
+    : m_gamma((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy))
+    , m_logGamma(std::log(m_gamma))
+    , m_maxBins(qMax(1, maxBins))
+    , m_minKey(0)
+    , m_zeroCount(0)
+    , m_count(0)
+{
+}
+
+void QuantileSketch::add(double value)
+{
+    ++m_count;
+
+    if (!(value > MIN_VALUE)) {
+        ++m_zeroCount;
+        return;
+    }
+
+    const int key = keyFor(value);
+    include(key);
+    ++m_bins[qMax(key, m_minKey) - m_minKey];
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+    if (other.isEmpty()) {
+        return;
+    }
+
+    m_count += other.m_count;
+    m_zeroCount += other.m_zeroCount;
+
+    if (other.m_bins.isEmpty()) {
+        return;
+    }
+
+    include(other.m_minKey);
+    include(other.m_minKey + other.m_bins.size() - 1);
+
+    for (int i = 0; i < other.m_bins.size(); ++i) {
+        // Keys folded away on this side land in the lowest bin
+        const int key = qMax(other.m_minKey + i, m_minKey);
+        m_bins[key - m_minKey] += other.m_bins.at(i);
+    }
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    if (m_count == 0) {
+        return 0.0;
+    }
+
+    // Rank of the wanted value, 0-based
+    const quint64 rank = static_cast<quint64>(qBound(0.0, q, 1.0) * static_cast<double>(m_count - 1));
+    if (rank < m_zeroCount) {
+        return 0.0;
+    }
+
+    quint64 seen = m_zeroCount;
+    for (int i = 0; i < m_bins.size(); ++i) {
+        seen += m_bins.at(i);
+        if (seen > rank) {
+            return valueFor(m_minKey + i);
+        }
+    }
+    return valueFor(m_minKey + m_bins.size() - 1);
+}
+
+void QuantileSketch::clear()
+{
+    // Keeps the capacity: slices are cleared and refilled all the time
+    m_bins.clear();
+    m_zeroCount = 0;
+    m_count = 0;
+}
+
+int QuantileSketch::keyFor(double value) const
+{
+    return static_cast<int>(std::ceil(std::log(value) / m_logGamma));
+}
+
+double QuantileSketch::valueFor(int key) const
+{
+    // Midpoint (in relative terms) of (gamma^(key-1), gamma^key]
+    return 2.0 * std::pow(m_gamma, key) / (m_gamma + 1.0);
+}
+
+void QuantileSketch::include(int key)
+{
+    if (m_bins.isEmpty()) {
+        m_minKey = key;
+        m_bins.append(0);
+        return;
+    }
+
+    const int maxKey = m_minKey + m_bins.size() - 1;
+
+    if (key > maxKey) {
+        const int grow = key - maxKey;
+        m_bins.insert(m_bins.size(), grow, 0);
+
+        // Over the cap: fold the lowest bins into the new lowest
+        const int excess = m_bins.size() - m_maxBins;
+        if (excess > 0) {
+            quint32 folded = 0;
+            for (int i = 0; i < excess; ++i) {
+                folded += m_bins.at(i);
+            }
+            m_bins.remove(0, excess);
+            m_bins[0] += folded;
+            m_minKey += excess;
+        }
+    }
+    else if (key < m_minKey) {
+        // Below the span: grow downwards while the cap allows
+        const int grow = qMin(m_minKey - key, m_maxBins - static_cast<int>(m_bins.size()));
+        if (grow > 0) {
+            m_bins.insert(0, grow, 0);
+            m_minKey -= grow;
+        }
+    }
+}
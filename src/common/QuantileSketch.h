@@ -0,0 +1,76 @@
+/**
+ * ============================================
+ * File: src/common/QuantileSketch.h
+ * Description: Mergeable quantile sketch (DDSketch)
+ * ============================================
+ */
+
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "Constants.h"
+
+/**
+ * @class QuantileSketch
+ * @brief Streaming quantiles with a relative error bound (DDSketch)
+ *
+ * A positive value x is counted in bin ceil(log_gamma(x)), with
+ * gamma = (1 + a) / (1 - a), so any quantile read back is within a
+ * relative error a of a value actually seen. Zero (and anything below
+ * MIN_VALUE) has its own counter; negative values count as zero, since
+ * every metric fed here is a usage, temperature or rate.
+ *
+ * The bins are a dense array over the span of keys seen so far, so an
+ * update is one log() and an increment. The span is capped at maxBins:
+ * past that, the lowest bins are folded together, which only degrades
+ * quantiles below the folded range; the high ones (p95, p99) stay exact
+ * to the bound. Sketches with the same accuracy merge by adding bins.
+ */
+class QuantileSketch
+{
+public:
+    explicit QuantileSketch(double relativeAccuracy = App::Quantile::RELATIVE_ACCURACY,
+                            int maxBins = App::Quantile::MAX_BINS);
+
+    /**
+     * @brief Count one value (O(1); allocates only when the span grows)
+     */
+    void add(double value);
+
+    /**
+     * @brief Add another sketch's counts; both must share the accuracy
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @brief Value at quantile q (0..1), 0 when empty
+     */
+    double quantile(double q) const;
+
+    void clear();
+
+    quint64 count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+
+private:
+    int keyFor(double value) const;
+    double valueFor(int key) const;
+    void include(int key);
+
+private:
+    double m_gamma;
+    double m_logGamma;
+    int m_maxBins;
+
+    QVector<quint32> m_bins;    // m_bins[i] counts key m_minKey + i
+    int m_minKey;
+    quint64 m_zeroCount;
+    quint64 m_count;
+
+    // Constants
+    static constexpr double MIN_VALUE = 1e-9;
+};
+
+#endif // QUANTILESKETCH_H
@@ -0,0 +1,248 @@
+/**
+ * ============================================
+ * File: src/common/RingBuffer.h
+ * Description: Fixed-capacity ring buffer for metric histories
+ * ============================================
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+
+/**
+ * @class RingBuffer
+ * @brief Fixed-capacity circular buffer, oldest element first
+ *
+ * Storage is a std::array, so pushing never allocates and never moves
+ * existing elements. Two ways to use it:
+ *
+ * - History mode: push() overwrites the oldest sample once full. Reads
+ *   (at(), spans, iteration) must happen on the same thread or be
+ *   otherwise synchronised.
+ * - Single-producer/single-consumer mode: one thread calls tryPush(),
+ *   another calls tryPop(); neither blocks nor locks. tryPush() fails
+ *   instead of overwriting, so the consumer never sees a torn slot.
+ *
+ * The content is at most two contiguous runs (before and after the wrap
+ * point), exposed by firstSpan()/secondSpan() for copy-free bulk access.
+ *
+ * @tparam T Element type (cheap to copy, default-constructible)
+ * @tparam N Capacity
+ */
+template <typename T, int N>
+class RingBuffer
+{
+    static_assert(N > 0, "RingBuffer capacity must be positive");
+
+public:
+    /**
+     * @brief A contiguous run of elements
+     */
+    struct Span {
+        const T* data = nullptr;
+        int size = 0;
+
+        const T* begin() const { return data; }
+        const T* end() const { return data + size; }
+    };
+
+    /**
+     * @brief Forward iterator, oldest to newest
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const RingBuffer* buffer, int index)
+            : m_buffer(buffer)
+            , m_index(index)
+        {
+        }
+
+        reference operator*() const { return m_buffer->at(m_index); }
+        pointer operator->() const { return &m_buffer->at(m_index); }
+
+        const_iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++m_index;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const RingBuffer* m_buffer;
+        int m_index;
+    };
+
+    RingBuffer() = default;
+
+    // Copies are snapshots; do not copy while a producer is pushing
+    RingBuffer(const RingBuffer& other)
+        : m_data(other.m_data)
+        , m_head(other.m_head.load(std::memory_order_acquire))
+        , m_tail(other.m_tail.load(std::memory_order_acquire))
+    {
+    }
+
+    RingBuffer& operator=(const RingBuffer& other)
+    {
+        if (this != &other) {
+            m_data = other.m_data;
+            m_head.store(other.m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+            m_tail.store(other.m_tail.load(std::memory_order_acquire), std::memory_order_release);
+        }
+        return *this;
+    }
+
+    static constexpr int capacity() { return N; }
+
+    int size() const
+    {
+        return static_cast<int>(m_tail.load(std::memory_order_acquire)
+                                - m_head.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Elements ever pushed, including overwritten ones
+     *
+     * Lets a reader holding a copy tell how many samples are new since
+     * it last looked.
+     */
+    quint64 totalPushed() const { return m_tail.load(std::memory_order_acquire); }
+
+    bool isEmpty() const { return size() == 0; }
+    bool isFull() const { return size() == N; }
+
+    void clear() { m_head.store(m_tail.load(std::memory_order_relaxed), std::memory_order_release); }
+
+    // ==================== History mode ====================
+
+    /**
+     * @brief Append a value, dropping the oldest one when full (O(1))
+     */
+    void push(const T& value)
+    {
+        const quint64 tail = m_tail.load(std::memory_order_relaxed);
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+
+        if (tail - head == static_cast<quint64>(N)) {
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        m_data[slot(tail)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Element i, 0 being the oldest
+     */
+    const T& at(int i) const
+    {
+        Q_ASSERT(i >= 0 && i < size());
+        return m_data[slot(m_head.load(std::memory_order_acquire) + static_cast<quint64>(i))];
+    }
+
+    const T& operator[](int i) const { return at(i); }
+
+    const T& first() const { return at(0); }
+    const T& last() const { return at(size() - 1); }
+
+    /**
+     * @brief Oldest contiguous run (up to the end of storage)
+     */
+    Span firstSpan() const
+    {
+        const quint64 head = m_head.load(std::memory_order_acquire);
+        const int count = static_cast<int>(m_tail.load(std::memory_order_acquire) - head);
+        const int start = slot(head);
+
+        Span span;
+        span.data = m_data.data() + start;
+        span.size = qMin(count, N - start);
+        return span;
+    }
+
+    /**
+     * @brief Newest run after the wrap point, empty if not wrapped
+     */
+    Span secondSpan() const
+    {
+        const quint64 head = m_head.load(std::memory_order_acquire);
+        const int count = static_cast<int>(m_tail.load(std::memory_order_acquire) - head);
+        const int start = slot(head);
+
+        Span span;
+        span.data = m_data.data();
+        span.size = qMax(0, count - (N - start));
+        return span;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // ==================== SPSC mode ====================
+
+    /**
+     * @brief Producer side: append unless full
+     * @return false if the consumer has not caught up
+     */
+    bool tryPush(const T& value)
+    {
+        const quint64 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == static_cast<quint64>(N)) {
+            return false;
+        }
+
+        m_data[slot(tail)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: take the oldest element
+     * @return false if empty
+     */
+    bool tryPop(T& value)
+    {
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = m_data[slot(head)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static int slot(quint64 position) { return static_cast<int>(position % static_cast<quint64>(N)); }
+
+private:
+    std::array<T, N> m_data{};
+
+    // Monotonic read/write positions; size is their difference, so a full
+    // buffer and an empty one never look alike
+    std::atomic<quint64> m_head{0};
+    std::atomic<quint64> m_tail{0};
+};
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,217 @@
+/**
+ * ============================================
+ * File: src/common/TraceRecorder.cpp
+ * Description: Trace recorder implementation
+ * ============================================
+ */
+
+#include "TraceRecorder.h"
+#include "Constants.h"
+#include <QFile>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <ctime>
+#include <unistd.h>
+
+namespace {
+
+constexpr quint64 CAPACITY = App::Trace::BUFFER_EVENTS;
+static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Trace buffer size must be a power of two");
+
+/**
+ * @brief JSON string body; names are our own, so only quotes and backslashes
+ */
+void appendEscaped(QByteArray& json, const char* text)
+{
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            json.append('\\');
+        }
+        json.append(*c);
+    }
+}
+
+} // namespace
+
+TraceRecorder& TraceRecorder::instance()
+{
+    static TraceRecorder inst;
+    return inst;
+}
+
+void TraceRecorder::enable(const QString& path)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_path = path;
+    }
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+QString TraceRecorder::path() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_path;
+}
+
+const char* TraceRecorder::intern(const QString& name)
+{
+    QMutexLocker locker(&m_mutex);
+
+    const QByteArray utf8 = name.toUtf8();
+    for (const QByteArray& existing : m_names) {
+        if (existing == utf8) {
+            return existing.constData();
+        }
+    }
+
+    m_names.append(utf8);
+    return m_names.last().constData();
+}
+
+void TraceRecorder::begin(const char* name, const char* category, qint64 timeNs)
+{
+    record('B', name, category, timeNs);
+}
+
+void TraceRecorder::end(const char* name, const char* category, qint64 timeNs)
+{
+    record('E', name, category, timeNs);
+}
+
+void TraceRecorder::instant(const char* name, const char* category, qint64 timeNs)
+{
+    record('i', name, category, timeNs);
+}
+
+qint64 TraceRecorder::nowNs()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+void TraceRecorder::record(char phase, const char* name, const char* category, qint64 timeNs)
+{
+    ThreadBuffer* buffer = threadBuffer();
+
+    const quint64 head = buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[head & (CAPACITY - 1)];
+    event.name = name;
+    event.category = category;
+    event.timeNs = timeNs;
+    event.phase = phase;
+
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::threadBuffer()
+{
+    // Owned by m_buffers, so a dump after the thread exited still sees it
+    static thread_local ThreadBuffer* t_buffer = nullptr;
+    if (t_buffer) {
+        return t_buffer;
+    }
+
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->tid = static_cast<int>(syscall(SYS_gettid));
+    buffer->events.reset(new Event[CAPACITY]);
+
+    char name[16] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0]) {
+        buffer->threadName = name;
+    } else {
+        buffer->threadName = QByteArray::number(buffer->tid);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_buffers.append(buffer);
+    t_buffer = buffer.get();
+    return t_buffer;
+}
+
+bool TraceRecorder::dump(const QString& path) const
+{
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    const int pid = static_cast<int>(getpid());
+
+    QByteArray json;
+    json.reserve(1024 * 1024);
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const std::shared_ptr<ThreadBuffer>& buffer : m_buffers) {
+            appendThread(json, *buffer, pid);
+        }
+    }
+
+    // Drop the separator after the last event
+    if (json.endsWith(",\n")) {
+        json.chop(2);
+        json.append('\n');
+    }
+    json.append("]}\n");
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}
+
+void TraceRecorder::appendThread(QByteArray& json, const ThreadBuffer& buffer, int pid) const
+{
+    const QByteArray ids = ",\"pid\":" + QByteArray::number(pid)
+                         + ",\"tid\":" + QByteArray::number(buffer.tid);
+
+    json.append("{\"name\":\"thread_name\",\"ph\":\"M\"" + ids + ",\"args\":{\"name\":\"");
+    appendEscaped(json, buffer.threadName.constData());
+    json.append("\"}},\n");
+
+    // Copy what the ring holds, then drop whatever the owning thread
+    // overwrote while we were copying
+    const quint64 head = buffer.head.load(std::memory_order_acquire);
+    const quint64 first = head > CAPACITY ? head - CAPACITY : 0;
+
+    QVector<Event> events;
+    events.reserve(static_cast<int>(head - first));
+    for (quint64 i = first; i < head; ++i) {
+        events.append(buffer.events[i & (CAPACITY - 1)]);
+    }
+
+    const quint64 after = buffer.head.load(std::memory_order_acquire);
+    const quint64 valid = after > CAPACITY ? after - CAPACITY : 0;
+    const int skip = valid > first ? static_cast<int>(qMin(valid - first, head - first)) : 0;
+
+    // An end whose begin was overwritten would confuse the viewer
+    int depth = 0;
+    for (int i = skip; i < events.size(); ++i) {
+        const Event& event = events.at(i);
+        if (event.phase == 'E') {
+            if (depth == 0) {
+                continue;
+            }
+            --depth;
+        } else if (event.phase == 'B') {
+            ++depth;
+        }
+
+        json.append("{\"name\":\"");
+        appendEscaped(json, event.name);
+        json.append("\",\"cat\":\"");
+        appendEscaped(json, event.category);
+        json.append("\",\"ph\":\"");
+        json.append(event.phase);
+        json.append("\",\"ts\":");
+        json.append(QByteArray::number(event.timeNs / 1000.0, 'f', 3));
+        json.append(ids);
+        if (event.phase == 'i') {
+            json.append(",\"s\":\"t\"");
+        }
+        json.append("},\n");
+    }
+}
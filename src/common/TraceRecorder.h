@@ -0,0 +1,140 @@
+/**
+ * ============================================
+ * File: src/common/TraceRecorder.h
+ * Description: Opt-in timeline tracing, exported as Chrome trace-event JSON
+ * ============================================
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+/**
+ * @class TraceRecorder
+ * @brief Records begin/end/instant events per thread for offline viewing
+ *
+ * Off unless enable() is called (main() does so when SYSMON_TRACE is
+ * set); while off, every hook costs one relaxed load. Each thread that
+ * records gets a preallocated ring of App::Trace::BUFFER_EVENTS events on
+ * its first event, and only ever writes to its own ring: no lock, no
+ * allocation, the oldest events overwritten. An event is a name and
+ * category (string literals or intern()ed), a CLOCK_MONOTONIC time and a
+ * phase.
+ *
+ * dump() writes every ring as Chrome "traceEvents" JSON, which
+ * chrome://tracing and ui.perfetto.dev open directly. Threads are named
+ * after their native names (e.g. MetricsSampler).
+ */
+class TraceRecorder
+{
+public:
+    static TraceRecorder& instance();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start recording
+     * @param path Where dump() writes by default
+     */
+    void enable(const QString& path);
+    QString path() const;
+
+    /**
+     * @brief Stable copy of a dynamic name, for begin()/end()
+     */
+    const char* intern(const QString& name);
+
+    // Hooks; names and categories must outlive the recorder
+    void begin(const char* name, const char* category, qint64 timeNs);
+    void end(const char* name, const char* category, qint64 timeNs);
+    void instant(const char* name, const char* category, qint64 timeNs);
+
+    /**
+     * @brief Write everything still in the rings as trace-event JSON
+     * @return false if the file could not be written
+     */
+    bool dump(const QString& path) const;
+    bool dump() const { return dump(path()); }
+
+    /**
+     * @brief CLOCK_MONOTONIC, the time base of every event
+     */
+    static qint64 nowNs();
+
+private:
+    struct Event {
+        const char* name;
+        const char* category;
+        qint64 timeNs;
+        char phase;             // 'B', 'E' or 'i'
+    };
+
+    /**
+     * @brief One thread's ring; written by that thread only
+     */
+    struct ThreadBuffer {
+        int tid = 0;
+        QByteArray threadName;
+        std::atomic<quint64> head{0};   // Events ever written
+        std::unique_ptr<Event[]> events;
+    };
+
+    TraceRecorder() = default;
+
+    void record(char phase, const char* name, const char* category, qint64 timeNs);
+    ThreadBuffer* threadBuffer();
+    void appendThread(QByteArray& json, const ThreadBuffer& buffer, int pid) const;
+
+private:
+    static inline std::atomic<bool> s_enabled{false};
+
+    mutable QMutex m_mutex;
+    QVector<std::shared_ptr<ThreadBuffer>> m_buffers;
+    QList<QByteArray> m_names;      // intern()ed names; their data never moves
+    QString m_path;
+};
+
+/**
+ * @class TraceScope
+ * @brief Begin event now, end event when the scope exits (if tracing)
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category)
+        : m_name(name)
+        , m_category(category)
+        , m_active(TraceRecorder::isEnabled())
+    {
+        if (m_active) {
+            TraceRecorder::instance().begin(m_name, m_category, TraceRecorder::nowNs());
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_active) {
+            TraceRecorder::instance().end(m_name, m_category, TraceRecorder::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    bool m_active;
+};
+
+#endif // TRACERECORDER_H
@@ -0,0 +1,232 @@
+/**
+ * ============================================================================
+ * File: src/controller/CollectorScheduler.cpp
+ * Description: Collector scheduler implementation
+ * ============================================================================
+ */
+
+#include "CollectorScheduler.h"
+#include "Logger.h"
+#include "TraceRecorder.h"
+#include <QTimer>
+
+CollectorScheduler::CollectorScheduler(QObject* parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &CollectorScheduler::onTimeout);
+}
+
+int CollectorScheduler::addCollector(const QString& name, int periodMs, Collect collect)
+{
+    Collector collector;
+    collector.name = name;
+    collector.periodMs = qMax(1, periodMs);
+    collector.idlePeriodMs = 0;
+    collector.idle = false;
+    collector.dueMs = 0;
+    collector.collect = std::move(collect);
+
+    m_collectors.append(std::move(collector));
+
+    if (m_clock.isValid()) {
+        reschedule(m_collectors.last(), m_clock.elapsed());
+        arm();
+    }
+    return m_collectors.size() - 1;
+}
+
+void CollectorScheduler::setPeriod(int id, int periodMs)
+{
+    if (id < 0 || id >= m_collectors.size()) {
+        return;
+    }
+
+    Collector& collector = m_collectors[id];
+    periodMs = qMax(1, periodMs);
+    if (collector.periodMs == periodMs) {
+        return;
+    }
+
+    collector.periodMs = periodMs;
+
+    if (m_clock.isValid() && !collector.idle) {
+        reschedule(collector, m_clock.elapsed());
+        arm();
+    }
+}
+
+int CollectorScheduler::period(int id) const
+{
+    if (id < 0 || id >= m_collectors.size()) {
+        return 0;
+    }
+    return m_collectors.at(id).periodMs;
+}
+
+void CollectorScheduler::setIdleBehaviour(int id, int idlePeriodMs, Collect baseline)
+{
+    if (id < 0 || id >= m_collectors.size()) {
+        return;
+    }
+
+    m_collectors[id].baseline = std::move(baseline);
+    setIdlePeriod(id, idlePeriodMs);
+}
+
+void CollectorScheduler::setIdlePeriod(int id, int idlePeriodMs)
+{
+    if (id < 0 || id >= m_collectors.size()) {
+        return;
+    }
+
+    Collector& collector = m_collectors[id];
+    idlePeriodMs = qMax(0, idlePeriodMs);
+    if (collector.idlePeriodMs == idlePeriodMs) {
+        return;
+    }
+
+    collector.idlePeriodMs = idlePeriodMs;
+
+    if (m_clock.isValid() && collector.idle) {
+        reschedule(collector, m_clock.elapsed());
+        arm();
+    }
+}
+
+void CollectorScheduler::setIdle(int id, bool idle)
+{
+    if (id < 0 || id >= m_collectors.size()) {
+        return;
+    }
+
+    Collector& collector = m_collectors[id];
+    if (collector.idle == idle) {
+        return;
+    }
+
+    collector.idle = idle;
+
+    if (!m_clock.isValid()) {
+        return;
+    }
+
+    if (idle) {
+        reschedule(collector, m_clock.elapsed());
+    } else {
+        // Due now: picked up by the next wakeup, then back on its grid
+        collector.dueMs = m_clock.elapsed();
+    }
+    arm();
+}
+
+bool CollectorScheduler::isIdle(int id) const
+{
+    if (id < 0 || id >= m_collectors.size()) {
+        return false;
+    }
+    return m_collectors.at(id).idle;
+}
+
+void CollectorScheduler::start()
+{
+    m_clock.start();
+
+    // Everything that runs at all is due at time 0, so the first pass
+    // runs each collector (or its baseline) once
+    for (Collector& collector : m_collectors) {
+        collector.dueMs = currentPeriod(collector) > 0 ? 0 : SUSPENDED;
+    }
+    onTimeout();
+
+    for (const Collector& collector : m_collectors) {
+        LOG_INFO("CollectorScheduler: %1 every %2 ms", collector.name, collector.periodMs);
+    }
+}
+
+void CollectorScheduler::stop()
+{
+    m_timer->stop();
+    m_clock.invalidate();
+}
+
+void CollectorScheduler::onTimeout()
+{
+    if (!m_clock.isValid()) {
+        return;
+    }
+
+    TraceScope trace("tick", "sampler");
+
+    const qint64 now = m_clock.elapsed();
+    bool ran = false;
+
+    for (Collector& collector : m_collectors) {
+        if (collector.dueMs == SUSPENDED || collector.dueMs > now + COALESCE_MS) {
+            continue;
+        }
+
+        if (collector.idle && collector.baseline) {
+            collector.baseline();
+        } else {
+            collector.collect();
+            ran = true;
+        }
+
+        // Stay on the period grid; a late wakeup skips missed slots
+        // instead of running the collector several times back to back
+        const int period = currentPeriod(collector);
+        if (period == 0) {
+            collector.dueMs = SUSPENDED;
+            continue;
+        }
+
+        collector.dueMs = (collector.dueMs / period + 1) * period;
+        if (collector.dueMs <= now) {
+            collector.dueMs = nextDeadline(now, period);
+        }
+    }
+
+    if (ran) {
+        emit collected();
+    }
+
+    arm();
+}
+
+void CollectorScheduler::arm()
+{
+    if (!m_clock.isValid()) {
+        return;
+    }
+
+    qint64 earliest = SUSPENDED;
+    for (const Collector& collector : m_collectors) {
+        earliest = qMin(earliest, collector.dueMs);
+    }
+
+    if (earliest == SUSPENDED) {
+        m_timer->stop();
+        return;
+    }
+
+    const qint64 delay = qMax<qint64>(0, earliest - m_clock.elapsed());
+    m_timer->start(static_cast<int>(delay));
+}
+
+void CollectorScheduler::reschedule(Collector& collector, qint64 nowMs)
+{
+    const int period = currentPeriod(collector);
+    collector.dueMs = period > 0 ? nextDeadline(nowMs, period) : SUSPENDED;
+}
+
+int CollectorScheduler::currentPeriod(const Collector& collector)
+{
+    return collector.idle ? collector.idlePeriodMs : collector.periodMs;
+}
+
+qint64 CollectorScheduler::nextDeadline(qint64 nowMs, int periodMs)
+{
+    return (nowMs / periodMs + 1) * periodMs;
+}
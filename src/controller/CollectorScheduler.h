@@ -0,0 +1,122 @@
+/**
+ * ============================================================================
+ * File: src/controller/CollectorScheduler.h
+ * Description: Runs metric collectors at their own periods on one timer
+ * ============================================================================
+ */
+
+#ifndef COLLECTORSCHEDULER_H
+#define COLLECTORSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVector>
+#include <functional>
+#include <limits>
+
+// Forward declarations
+class QTimer;
+
+/**
+ * @class CollectorScheduler
+ * @brief Per-collector periods, coalesced onto a single timer
+ *
+ * Every collector declares its own period. Deadlines are multiples of the
+ * period counted from a shared start time, so collectors whose periods
+ * divide each other (the App::Interval tiers) come due together. The one
+ * single-shot timer is armed for the earliest deadline, and everything due
+ * within COALESCE_MS of it runs in that same wakeup, followed by a single
+ * collected() signal. Idle periods cost no wakeups at all.
+ *
+ * A collector can be marked idle when nothing on screen consumes it. Idle
+ * collectors either stop completely or run a cheap baseline callback on a
+ * slower period (to keep rate counters fresh), and run once right away
+ * when they become active again.
+ *
+ * Not thread-safe: use from the thread the scheduler lives in.
+ */
+class CollectorScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Collect = std::function<void()>;
+
+    explicit CollectorScheduler(QObject* parent = nullptr);
+    ~CollectorScheduler() override = default;
+
+    /**
+     * @brief Register a collector
+     * @param name Short name for logs
+     * @param periodMs How often it runs
+     * @param collect Work to do when due
+     * @return Collector id for setPeriod()
+     */
+    int addCollector(const QString& name, int periodMs, Collect collect);
+
+    /**
+     * @brief Change one collector's period, realigned to the shared start
+     */
+    void setPeriod(int id, int periodMs);
+    int period(int id) const;
+
+    /**
+     * @brief What a collector does while idle
+     * @param idlePeriodMs Period while idle, 0 to suspend it entirely
+     * @param baseline Run instead of the collector while idle (no collected()
+     *        signal); empty to run the collector itself at the idle period
+     */
+    void setIdleBehaviour(int id, int idlePeriodMs, Collect baseline = Collect());
+    void setIdlePeriod(int id, int idlePeriodMs);
+
+    /**
+     * @brief Switch a collector between its active and idle schedule
+     *
+     * Becoming active runs the collector in the next wakeup, so a page
+     * that just opened does not wait a full period for its first value.
+     */
+    void setIdle(int id, bool idle);
+    bool isIdle(int id) const;
+
+    /**
+     * @brief Run every collector (or its idle baseline) once and start the timer
+     */
+    void start();
+    void stop();
+
+signals:
+    /**
+     * @brief One wakeup ran at least one collector
+     */
+    void collected();
+
+private slots:
+    void onTimeout();
+
+private:
+    struct Collector {
+        QString name;
+        int periodMs;
+        int idlePeriodMs;   // 0 = suspended while idle
+        bool idle;
+        qint64 dueMs;       // Next deadline, ms since m_clock started
+        Collect collect;
+        Collect baseline;
+    };
+
+    void arm();
+    void reschedule(Collector& collector, qint64 nowMs);
+    static int currentPeriod(const Collector& collector);
+    static qint64 nextDeadline(qint64 nowMs, int periodMs);
+
+private:
+    QVector<Collector> m_collectors;
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+
+    // Constants
+    static constexpr int COALESCE_MS = 50;      // Deadlines this close share a wakeup
+    static constexpr qint64 SUSPENDED = std::numeric_limits<qint64>::max();
+};
+
+#endif // COLLECTORSCHEDULER_H
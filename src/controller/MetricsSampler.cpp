@@ -0,0 +1,395 @@
+/**
+ * ============================================================================
+ * File: src/controller/MetricsSampler.cpp
+ * Description: Sampler worker implementation
+ * ============================================================================
+ */
+
+#include "MetricsSampler.h"
+
+#include "CollectorScheduler.h"
+#include "Instrumentation.h"
+#include "TraceRecorder.h"
+#include "QuantileStore.h"
+#include "CpuMonitor.h"
+#include "GpuMonitor.h"
+#include "MemoryMonitor.h"
+#include "StorageMonitor.h"
+#include "NetworkMonitor.h"
+#include "ProcessMonitor.h"
+
+#include "Constants.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+/**
+ * @brief Copy a monitor's ring into a snapshot series
+ */
+template <int N>
+void copyHistory(const RingBuffer<int, N>& history, HistorySeries& series)
+{
+    series.values.resize(history.size());
+
+    // At most two memcpy-able runs, no per-element indexing
+    const typename RingBuffer<int, N>::Span first = history.firstSpan();
+    const typename RingBuffer<int, N>::Span second = history.secondSpan();
+    std::copy(first.begin(), first.end(), series.values.begin());
+    std::copy(second.begin(), second.end(), series.values.begin() + first.size);
+
+    series.total = history.totalPushed();
+}
+
+} // namespace
+
+MetricsSampler::MetricsSampler(int intervalMs, HistoryStore* historyStore, QuantileStore* quantileStore,
+                               Instrumentation* instrumentation, QObject* parent)
+    : QObject(parent)
+    , m_cpuMonitor(nullptr)
+    , m_gpuMonitor(nullptr)
+    , m_memMonitor(nullptr)
+    , m_storageMonitor(nullptr)
+    , m_networkMonitor(nullptr)
+    , m_processMonitor(nullptr)
+    , m_historyStore(historyStore)
+    , m_quantileStore(quantileStore)
+    , m_instrumentation(instrumentation)
+    , m_publishProbe(nullptr)
+    , m_scheduler(nullptr)
+    , m_intervalMs(intervalMs)
+    , m_visiblePage(App::NavIndex::DASHBOARD)
+    , m_processesCollector(-1)
+{
+}
+
+MetricsSampler::~MetricsSampler()
+{
+    if (m_scheduler) {
+        m_scheduler->stop();
+    }
+}
+
+std::shared_ptr<const MetricsSnapshot> MetricsSampler::latestSnapshot() const
+{
+    return std::atomic_load(&m_latest);
+}
+
+void MetricsSampler::start()
+{
+    // Monitors are created here so they belong to the worker thread
+    m_cpuMonitor = new CpuMonitor(this);
+    m_gpuMonitor = new GpuMonitor(this);
+    m_memMonitor = new MemoryMonitor(this);
+    m_storageMonitor = new StorageMonitor(this);
+    m_networkMonitor = new NetworkMonitor(this);
+    m_processMonitor = new ProcessMonitor(this);
+
+    connect(m_networkMonitor, &NetworkMonitor::linkStateChanged, this, &MetricsSampler::onNetworkChanged);
+
+    m_scheduler = new CollectorScheduler(this);
+    connect(m_scheduler, &CollectorScheduler::collected, this, &MetricsSampler::publish);
+
+    if (m_instrumentation) {
+        m_publishProbe = m_instrumentation->probe("publish");
+    }
+
+    using namespace App::NavIndex;
+
+    // Cheap, fast-moving values on the fast tier; chart histories at the
+    // nominal rate so a chart still spans CHART_SAMPLES update intervals;
+    // subprocesses, socket dumps and statvfs() well below that.
+    // CPU and RAM usage feed the threshold alerts, so they never idle;
+    // temperature is one sysfs read and the archive's key metric, so it
+    // does not idle either.
+    addCollector("cpu", App::Interval::FAST, &MetricsSampler::sampleCpu);
+    addCollector("memory", App::Interval::FAST, &MetricsSampler::sampleMemory);
+
+    const int cores = addCollector("cores", App::Interval::FAST, &MetricsSampler::sampleCores,
+                                   page(CPU));
+    setIdleBaseline(cores, App::Interval::FAST, &MetricsSampler::sampleCoresBaseline);
+
+    addCollector("thermal", App::Interval::NORMAL, &MetricsSampler::sampleThermal);
+
+    const int diskIo = addCollector("diskio", App::Interval::NORMAL, &MetricsSampler::sampleDiskIo,
+                                    page(STORAGE));
+    setIdleBaseline(diskIo, App::Interval::SLOW, &MetricsSampler::sampleDiskIoBaseline);
+
+    const int network = addCollector("network", App::Interval::NORMAL, &MetricsSampler::sampleNetwork,
+                                     page(DASHBOARD) | page(NETWORK));
+    setIdleBaseline(network, App::Interval::SLOW, &MetricsSampler::sampleNetworkBaseline);
+
+    addCollector("cpuinfo", App::Interval::SLOW, &MetricsSampler::sampleCpuInfo,
+                 page(DASHBOARD) | page(CPU));
+    addCollector("gpu", App::Interval::VERY_SLOW, &MetricsSampler::sampleGpu,
+                 page(DASHBOARD));
+    addCollector("connections", App::Interval::VERY_SLOW, &MetricsSampler::sampleConnections,
+                 page(NETWORK));
+    m_processesCollector = addCollector("processes", App::Interval::SLOW, &MetricsSampler::sampleProcesses,
+                                        page(PROCESSES));
+    addCollector("filesystem", App::Interval::BACKGROUND, &MetricsSampler::sampleFilesystem,
+                 page(DASHBOARD) | page(STORAGE));
+
+    applyVisibility();
+
+    // Runs every collector (or its baseline) once, then publishes
+    m_scheduler->start();
+
+    LOG_INFO("MetricsSampler started - interval: %1 ms", m_intervalMs);
+}
+
+void MetricsSampler::setInterval(int intervalMs)
+{
+    m_intervalMs = intervalMs;
+
+    if (m_scheduler) {
+        for (int id = 0; id < m_tiers.size(); ++id) {
+            m_scheduler->setPeriod(id, scaledPeriod(m_tiers.at(id).tierMs));
+            m_scheduler->setIdlePeriod(id, scaledPeriod(m_tiers.at(id).idleTierMs));
+        }
+    }
+}
+
+void MetricsSampler::setVisiblePage(int navIndex)
+{
+    if (m_visiblePage == navIndex) {
+        return;
+    }
+
+    m_visiblePage = navIndex;
+    applyVisibility();
+}
+
+int MetricsSampler::addCollector(const QString& name, int tierMs, void (MetricsSampler::*collect)(),
+                                 quint32 pages)
+{
+    Probe* probe = m_instrumentation ? m_instrumentation->probe(name) : nullptr;
+    const int id = m_scheduler->addCollector(name, scaledPeriod(tierMs), [this, collect, probe]() {
+        ScopeTimer timer(probe);
+        (this->*collect)();
+    });
+
+    Q_ASSERT(id == m_tiers.size());
+    m_tiers.append({ name, tierMs, 0, pages });
+    return id;
+}
+
+void MetricsSampler::setIdleBaseline(int id, int idleTierMs, void (MetricsSampler::*baseline)())
+{
+    m_tiers[id].idleTierMs = idleTierMs;
+
+    Probe* probe = m_instrumentation ? m_instrumentation->probe(m_tiers.at(id).name + " idle") : nullptr;
+    m_scheduler->setIdleBehaviour(id, scaledPeriod(idleTierMs), [this, baseline, probe]() {
+        ScopeTimer timer(probe);
+        (this->*baseline)();
+    });
+}
+
+void MetricsSampler::applyVisibility()
+{
+    if (!m_scheduler) {
+        return;
+    }
+
+    const quint32 visible = page(m_visiblePage);
+    for (int id = 0; id < m_tiers.size(); ++id) {
+        const bool idle = !(m_tiers.at(id).pages & visible);
+        m_scheduler->setIdle(id, idle);
+
+        // Suspended outright, so process events stop waking this thread
+        if (id == m_processesCollector) {
+            m_processMonitor->setSuspended(idle);
+        }
+    }
+}
+
+int MetricsSampler::scaledPeriod(int tierMs) const
+{
+    // The fast tier is real-time whatever the setting
+    if (tierMs <= App::Interval::FAST) {
+        return tierMs;
+    }
+    return static_cast<int>(static_cast<qint64>(tierMs) * m_intervalMs / App::Interval::NORMAL);
+}
+
+void MetricsSampler::sampleCpu()
+{
+    m_working.cpuUsage = m_cpuMonitor->parseUsage();
+    record(HistoryStore::CpuUsage, m_working.cpuUsage);
+
+    // GPU usage = CPU usage for Pi (shared)
+    m_working.gpuUsage = m_working.cpuUsage;
+}
+
+void MetricsSampler::sampleCores()
+{
+    // Same tier as sampleCpu(), so this reuses its /proc/stat read
+    m_working.coreUsages = m_cpuMonitor->parsePerCoreUsage();
+}
+
+void MetricsSampler::sampleCoresBaseline()
+{
+    m_cpuMonitor->updateCoreBaseline();
+}
+
+void MetricsSampler::sampleCpuInfo()
+{
+    m_working.cpuClock = m_cpuMonitor->parseClock();
+    m_working.loadAverage = m_cpuMonitor->parseLoadAverage();
+}
+
+void MetricsSampler::sampleThermal()
+{
+    m_working.cpuTemp = m_cpuMonitor->parseTemp();
+    m_cpuMonitor->updateTempHistory(m_working.cpuTemp);
+    copyHistory(m_cpuMonitor->getTempHistory(), m_working.tempHistory);
+    m_working.tempSeries = m_cpuMonitor->getTempSeries();
+    record(HistoryStore::CpuTemp, m_working.cpuTemp);
+
+    m_working.hddTemp = m_storageMonitor->parseTemp();
+}
+
+void MetricsSampler::sampleGpu()
+{
+    m_working.gpuTemp = m_gpuMonitor->parseTemp();
+
+    // vcgencmd reports the GPU memory split in MB
+    const int gpuMemMb = m_gpuMonitor->parseMemUsage();
+    m_working.gpuMemUsage = gpuMemMb >= 0 ? qint64(gpuMemMb) * 1024 * 1024 : -1;
+}
+
+void MetricsSampler::sampleMemory()
+{
+    // One /proc/meminfo parse per tick, shared with the swap figures
+    m_memMonitor->update();
+
+    m_working.ramUsage = m_memMonitor->parseUsage();
+    record(HistoryStore::RamUsage, m_working.ramUsage);
+    m_working.ramUsed = static_cast<qint64>(m_memMonitor->getUsedBytes());
+    m_working.ramFree = static_cast<qint64>(m_memMonitor->getFreeBytes());
+    m_working.ramCache = static_cast<qint64>(m_memMonitor->getCachedBytes());
+    m_working.ramTotal = static_cast<qint64>(m_memMonitor->getTotalBytes());
+
+    m_storageMonitor->updateSwap(m_memMonitor->snapshot());
+    m_working.swapUsage = m_storageMonitor->getSwapUsage();
+    m_working.swapTotal = static_cast<qint64>(m_storageMonitor->getSwapTotal());
+    m_working.swapUsed = static_cast<qint64>(m_storageMonitor->getSwapUsed());
+    m_working.swapFree = static_cast<qint64>(m_storageMonitor->getSwapFree());
+}
+
+void MetricsSampler::sampleDiskIo()
+{
+    m_storageMonitor->updateIoStats();
+    m_working.ioRead = m_storageMonitor->getIoRead();
+    m_working.ioWrite = m_storageMonitor->getIoWrite();
+    copyHistory(m_storageMonitor->getIoHistory(), m_working.ioHistory);
+    m_working.ioSeries = m_storageMonitor->getIoSeries();
+    m_working.diskDevices = m_storageMonitor->getDeviceStats();
+    record(HistoryStore::DiskIo, m_working.ioRead + m_working.ioWrite);
+}
+
+void MetricsSampler::sampleDiskIoBaseline()
+{
+    if (m_storageMonitor->updateIoBaseline()) {
+        m_working.ioSeries = m_storageMonitor->getIoSeries();
+        record(HistoryStore::DiskIo,
+               m_storageMonitor->getIoRead() + m_storageMonitor->getIoWrite());
+    }
+}
+
+void MetricsSampler::sampleFilesystem()
+{
+    m_working.hddUsage = m_storageMonitor->parseUsage();
+
+    // Root partition
+    m_storageMonitor->updateRootPartition();
+    m_working.hddTotal = static_cast<qint64>(m_storageMonitor->getRootTotal());
+    m_working.hddUsed = static_cast<qint64>(m_storageMonitor->getRootUsed());
+    m_working.hddFree = static_cast<qint64>(m_storageMonitor->getRootFree());
+}
+
+void MetricsSampler::sampleNetwork()
+{
+    m_networkMonitor->update();
+
+    m_working.networkInterface = m_networkMonitor->getInterface();
+    m_working.ipAddress = m_networkMonitor->getIpAddress();
+    m_working.macAddress = m_networkMonitor->getMacAddress();
+    m_working.netUpSpeed = m_networkMonitor->getUpSpeed();
+    m_working.netDownSpeed = m_networkMonitor->getDownSpeed();
+    m_working.packetRate = m_networkMonitor->getPacketRate();
+    copyHistory(m_networkMonitor->getUpHistory(), m_working.netUpHistory);
+    copyHistory(m_networkMonitor->getDownHistory(), m_working.netDownHistory);
+    m_working.netUpSeries = m_networkMonitor->getUpSeries();
+    m_working.netDownSeries = m_networkMonitor->getDownSeries();
+    record(HistoryStore::NetUp, m_working.netUpSpeed);
+    record(HistoryStore::NetDown, m_working.netDownSpeed);
+}
+
+void MetricsSampler::sampleNetworkBaseline()
+{
+    if (m_networkMonitor->updateBaseline()) {
+        m_working.netUpSeries = m_networkMonitor->getUpSeries();
+        m_working.netDownSeries = m_networkMonitor->getDownSeries();
+        record(HistoryStore::NetUp, m_networkMonitor->getUpSpeed());
+        record(HistoryStore::NetDown, m_networkMonitor->getDownSpeed());
+    }
+}
+
+void MetricsSampler::sampleConnections()
+{
+    m_networkMonitor->updateConnections();
+    m_working.activeConnections = m_networkMonitor->getActiveConnections();
+}
+
+void MetricsSampler::sampleProcesses()
+{
+    m_processMonitor->update();
+    m_working.topCpuProcesses = m_processMonitor->getTopByCpu();
+    m_working.topMemoryProcesses = m_processMonitor->getTopByMemory();
+    m_working.processCount = m_processMonitor->getProcessCount();
+    m_working.forkRate = m_processMonitor->getForkRate();
+    m_working.execRate = m_processMonitor->getExecRate();
+    m_working.exitRate = m_processMonitor->getExitRate();
+    m_working.processEvents = m_processMonitor->isEventDriven();
+}
+
+void MetricsSampler::onNetworkChanged()
+{
+    m_working.networkInterface = m_networkMonitor->getInterface();
+    m_working.ipAddress = m_networkMonitor->getIpAddress();
+    m_working.macAddress = m_networkMonitor->getMacAddress();
+    publish();
+}
+
+void MetricsSampler::record(HistoryStore::Metric metric, double value)
+{
+    if (m_historyStore) {
+        m_historyStore->append(metric, value);
+    }
+    if (m_quantileStore) {
+        m_quantileStore->add(metric, value);
+    }
+}
+
+void MetricsSampler::publish()
+{
+    ScopeTimer timer(m_publishProbe);
+
+    // Diff here, off the GUI thread; the controller only emits what changed
+    const std::shared_ptr<const MetricsSnapshot> previous = std::atomic_load(&m_latest);
+    m_working.changed = previous ? diffSnapshots(*previous, m_working) : quint64(MetricField::All);
+    ++m_working.sequence;
+
+    // Copy into an immutable snapshot and swap it in atomically; readers
+    // holding the previous one keep it alive until they are done
+    std::atomic_store(&m_latest, std::shared_ptr<const MetricsSnapshot>(
+        std::make_shared<MetricsSnapshot>(m_working)));
+
+    // Start of the queued hand-over to the GUI thread (onSnapshotReady)
+    if (TraceRecorder::isEnabled()) {
+        TraceRecorder::instance().instant("snapshotReady", "sampler", TraceRecorder::nowNs());
+    }
+    emit snapshotReady();
+}
@@ -0,0 +1,193 @@
+/**
+ * ============================================================================
+ * File: src/controller/MetricsSampler.h
+ * Description: Worker that owns the monitors and samples off the GUI thread
+ * ============================================================================
+ */
+
+#ifndef METRICSSAMPLER_H
+#define METRICSSAMPLER_H
+
+#include <QObject>
+#include <QVector>
+#include <memory>
+
+#include "MetricsSnapshot.h"
+#include "HistoryStore.h"
+
+// Forward declarations
+class CollectorScheduler;
+class Instrumentation;
+class Probe;
+class QuantileStore;
+class CpuMonitor;
+class GpuMonitor;
+class MemoryMonitor;
+class StorageMonitor;
+class NetworkMonitor;
+class ProcessMonitor;
+
+/**
+ * @class MetricsSampler
+ * @brief Collects all metrics on a dedicated thread
+ *
+ * Lives in its own QThread and owns every monitor, so blocking reads,
+ * statvfs() and vcgencmd never run on the GUI thread. Collectors run on
+ * their own App::Interval tier through a CollectorScheduler and update
+ * their part of a working MetricsSnapshot; after each wakeup the result
+ * is diffed against the previous one (MetricsSnapshot::changed), published
+ * with an atomic shared_ptr swap and snapshotReady() is emitted. The GUI
+ * side picks up whatever is latest, so a slow consumer skips stale
+ * snapshots instead of queueing them.
+ *
+ * Each collector also lists the pages that show its data. While none of
+ * them is visible it is suspended, or for rate collectors reduced to a
+ * cheap counter baseline, so opening the page shows a correct rate at once.
+ *
+ * Collectors of archived metrics (CPU, temperature, RAM, disk I/O and
+ * network rates) also append to the HistoryStore and the QuantileStore,
+ * from their baseline too, so the long-range history and the percentiles
+ * keep going whichever page is on screen.
+ *
+ * With an Instrumentation, every collector, idle baseline and publish()
+ * is timed into its own Probe.
+ */
+class MetricsSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param historyStore Long-range archive to append to, nullptr for none
+     * @param quantileStore Percentile sketches to feed, nullptr for none
+     * @param instrumentation Where to time collectors, nullptr for nowhere
+     *
+     * All three must outlive the sampler.
+     */
+    MetricsSampler(int intervalMs, HistoryStore* historyStore, QuantileStore* quantileStore,
+                   Instrumentation* instrumentation = nullptr, QObject* parent = nullptr);
+    ~MetricsSampler() override;
+
+    /**
+     * @brief Latest published snapshot (thread-safe)
+     * @return nullptr until the first pass completed
+     */
+    std::shared_ptr<const MetricsSnapshot> latestSnapshot() const;
+
+    /**
+     * @brief Bit for one App::NavIndex page in a consumer mask
+     */
+    static constexpr quint32 page(int navIndex) { return 1u << navIndex; }
+
+public slots:
+    /**
+     * @brief Create monitors and start sampling (call in the worker thread)
+     */
+    void start();
+
+    /**
+     * @brief Change the user update interval
+     *
+     * Every tier slower than App::Interval::FAST is scaled by
+     * intervalMs / App::Interval::NORMAL, so the ratios between them stay
+     * the same; the fast tier (CPU, RAM) keeps its own period.
+     */
+    void setInterval(int intervalMs);
+
+    /**
+     * @brief Idle collectors that no App::NavIndex page on screen consumes
+     */
+    void setVisiblePage(int navIndex);
+
+signals:
+    /**
+     * @brief A new snapshot is available via latestSnapshot()
+     */
+    void snapshotReady();
+
+private slots:
+    /**
+     * @brief Publish interface/address changes without waiting for a tick
+     */
+    void onNetworkChanged();
+
+private:
+    /**
+     * @brief Register a collector on a base tier (period at the default interval)
+     * @param pages Pages showing its data (page() bits), ALL_PAGES if always needed
+     * @return Scheduler id
+     */
+    int addCollector(const QString& name, int tierMs, void (MetricsSampler::*collect)(),
+                     quint32 pages = ALL_PAGES);
+
+    /**
+     * @brief Keep a rate baseline on idleTierMs while the collector is idle
+     */
+    void setIdleBaseline(int id, int idleTierMs, void (MetricsSampler::*baseline)());
+
+    void applyVisibility();
+    int scaledPeriod(int tierMs) const;
+
+    // Collectors, one per tier of data
+    void sampleCpu();
+    void sampleCores();
+    void sampleCoresBaseline();
+    void sampleCpuInfo();
+    void sampleThermal();
+    void sampleGpu();
+    void sampleMemory();
+    void sampleDiskIo();
+    void sampleDiskIoBaseline();
+    void sampleFilesystem();
+    void sampleNetwork();
+    void sampleNetworkBaseline();
+    void sampleConnections();
+    void sampleProcesses();
+
+    /**
+     * @brief Feed one archived metric to the history and percentile stores
+     */
+    void record(HistoryStore::Metric metric, double value);
+
+    void publish();
+
+private:
+    // Monitors (created in the worker thread by start())
+    CpuMonitor* m_cpuMonitor;
+    GpuMonitor* m_gpuMonitor;
+    MemoryMonitor* m_memMonitor;
+    StorageMonitor* m_storageMonitor;
+    NetworkMonitor* m_networkMonitor;
+    ProcessMonitor* m_processMonitor;
+
+    // Long-range archive, percentiles and timings (not owned)
+    HistoryStore* m_historyStore;
+    QuantileStore* m_quantileStore;
+    Instrumentation* m_instrumentation;
+    Probe* m_publishProbe;
+
+    CollectorScheduler* m_scheduler;
+    int m_intervalMs;
+
+    // Schedule of each collector, indexed by scheduler id
+    struct CollectorTier {
+        QString name;
+        int tierMs;
+        int idleTierMs;     // 0 = suspended while idle
+        quint32 pages;
+    };
+    QVector<CollectorTier> m_tiers;
+    int m_visiblePage;
+    int m_processesCollector;   // Scheduler id, to suspend ProcessMonitor with it
+
+    // Snapshot being filled by the current pass (sampler thread only)
+    MetricsSnapshot m_working;
+
+    // Published snapshot, accessed with std::atomic_load/atomic_store
+    std::shared_ptr<const MetricsSnapshot> m_latest;
+
+    // Constants
+    static constexpr quint32 ALL_PAGES = 0xFFFFFFFFu;
+};
+
+#endif // METRICSSAMPLER_H
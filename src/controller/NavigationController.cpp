@@ -18,7 +18,7 @@ NavigationController::NavigationController(QObject* parent)
 
 void NavigationController::setCurrentIndex(int index)
 {
-    if (m_currentIndex != index && index >= 0 && index <= App::NavIndex::SETTINGS) {
+    if (m_currentIndex != index && index >= 0 && index <= App::NavIndex::PROCESSES) {
         m_previousIndex = m_currentIndex;
         m_currentIndex = index;
         m_currentPage = indexToPageName(index);
@@ -72,6 +72,7 @@ QString NavigationController::indexToPageName(int index) const
         case App::NavIndex::STORAGE:   return "Storage Detail";
         case App::NavIndex::NETWORK:   return "Network Detail";
         case App::NavIndex::SETTINGS:  return "Settings";
+        case App::NavIndex::PROCESSES: return "Processes";
         default:                       return "Unknown";
     }
 }
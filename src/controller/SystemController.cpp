@@ -5,63 +5,41 @@
  * ============================================================================
  */
 
+#define LOG_CATEGORY LogCategory::Ui
+
 #include "SystemController.h"
 
-#include "CpuMonitor.h"
-#include "GpuMonitor.h"
-#include "MemoryMonitor.h"
-#include "StorageMonitor.h"
-#include "NetworkMonitor.h"
+#include "MetricsSampler.h"
+#include "HistoryStore.h"
+#include "Instrumentation.h"
+#include "TraceRecorder.h"
+#include "QuantileStore.h"
+#include "NavigationController.h"
+#include "MetricsSnapshot.h"
 #include "SettingsManager.h"
 
 #include "Constants.h"
 #include "Logger.h"
+#include <QDateTime>
 #include <QDebug>
+#include <QStandardPaths>
+#include <QThread>
+#include <algorithm>
 
 SystemController::SystemController(QObject* parent) 
     : QObject(parent)
-    , m_cpuMonitor(nullptr)
-    , m_gpuMonitor(nullptr)
-    , m_memMonitor(nullptr)
-    , m_storageMonitor(nullptr)
-    , m_networkMonitor(nullptr)
+    , m_samplerThread(nullptr)
+    , m_sampler(nullptr)
+    , m_notifyProbe(nullptr)
     , m_settingsManager(nullptr)
-    , m_updateTimer(nullptr)
-    // Initialize CPU
-    , m_cpuUsage(0)
-    , m_cpuTemp(0)
-    , m_cpuClock("N/A")
-    , m_loadAverage("N/A")
-    // Initialize GPU
-    , m_gpuUsage(0)
-    , m_gpuTemp(0)
-    , m_gpuMemUsage(-1)
-    // Initialize RAM
-    , m_ramUsage(0)
-    , m_ramUsed("0M")
-    , m_ramFree("0M")
-    , m_ramCache("0M")
-    , m_ramTotal(0)
-    // Initialize Storage
-    , m_hddUsage(0)
-    , m_hddTemp(0)
-    , m_hddTotal("0GB")
-    , m_hddUsed("0GB")
-    , m_hddFree("0GB")
-    , m_swapUsage(0)
-    , m_swapTotal("0M")
-    , m_swapUsed("0M")
-    , m_swapFree("0M")
-    , m_ioRead("0 MB/s")
-    , m_ioWrite("0 MB/s")
-    // Initialize Network
-    , m_networkInterface("N/A")
-    , m_ipAddress("N/A")
-    , m_macAddress("N/A")
-    , m_netUpSpeed("0 B/s")
-    , m_netDownSpeed("0 B/s")
-    , m_packetRate("0 pps")
-    , m_activeConnections(0)
+    // Defaults until the first sampler pass
+    , m_snapshot(std::make_shared<MetricsSnapshot>())
+    // Initialize models
+    , m_coreUsageModel(new CoreUsageModel(this))
+    , m_tempHistoryModel(new HistoryModel(this))
+    , m_ioHistoryModel(new HistoryModel(this))
+    , m_netUpHistoryModel(new HistoryModel(this))
+    , m_netDownHistoryModel(new HistoryModel(this))
     // Initialize System
     , m_hostname("unknown")
     , m_osVersion("Unknown")
@@ -72,11 +50,12 @@ SystemController::SystemController(QObject* parent)
     , m_updateInterval(2)
     , m_darkMode(true)
     , m_soundAlert(false)
+    , m_logLevel(LOG_DEFAULT_LEVEL)
     , m_cpuWarnThreshold(App::Threshold::CPU_WARNING)
     , m_cpuCritThreshold(App::Threshold::CPU_CRITICAL)
     , m_ramWarnThreshold(App::Threshold::RAM_WARNING)
 {
-    initializeMonitors();
+    m_settingsManager = new SettingsManager(this);
     connectSignals();
 
     // Load system info from settings
@@ -88,43 +67,68 @@ SystemController::SystemController(QObject* parent)
     m_updateInterval = m_settingsManager->updateInterval();
     m_darkMode = m_settingsManager->darkMode();
     m_soundAlert = m_settingsManager->soundAlert();
+    m_logLevel = qMin(m_settingsManager->logLevel(), maxLogLevel());
+    Logger::instance().setLogLevel(m_logLevel);
     m_cpuWarnThreshold = m_settingsManager->cpuWarnThreshold();
     m_cpuCritThreshold = m_settingsManager->cpuCritThreshold();
     m_ramWarnThreshold = m_settingsManager->ramWarnThreshold();
 
-    // Create update timer
-    m_updateTimer = new QTimer(this);
-    m_updateTimer->setInterval(m_updateInterval * 1000);
-    connect(m_updateTimer, &QTimer::timeout, this, &SystemController::updateAllMetrics);
-
-    // Initial update
-    updateAllMetrics();
-
-    // Start timer
-    m_updateTimer->start();
+    // Start sampling on the worker thread
+    initializeSampler();
 
     LOG_INFO("SystemController initialized");
-    LOG_INFO(QString("Update interval: %1 seconds").arg(m_updateInterval));
-    LOG_INFO(QString("Hostname: %1").arg(m_hostname));
-    LOG_INFO(QString("OS: %1").arg(m_osVersion));
-    LOG_INFO(QString("Kernel: %1").arg(m_kernelVersion));
+    LOG_INFO("Update interval: %1 seconds", m_updateInterval);
+    LOG_INFO("Hostname: %1", m_hostname);
+    LOG_INFO("OS: %1", m_osVersion);
+    LOG_INFO("Kernel: %1", m_kernelVersion);
 }
 
 SystemController::~SystemController()
 {
-    if (m_updateTimer) {
-        m_updateTimer->stop();
+    if (m_samplerThread) {
+        m_samplerThread->quit();
+        m_samplerThread->wait();
     }
 }
 
-void SystemController::initializeMonitors()
+void SystemController::initializeSampler()
 {
-    m_cpuMonitor = new CpuMonitor(this);
-    m_gpuMonitor = new GpuMonitor(this);
-    m_memMonitor = new MemoryMonitor(this);
-    m_storageMonitor = new StorageMonitor(this);
-    m_networkMonitor = new NetworkMonitor(this);
-    m_settingsManager = new SettingsManager(this);
+    m_historyStore = std::make_unique<HistoryStore>(
+        QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+        + '/' + QLatin1String(App::History::ARCHIVE_DIR));
+    m_quantileStore = std::make_unique<QuantileStore>();
+    m_instrumentation = std::make_unique<Instrumentation>();
+    m_notifyProbe = m_instrumentation->probe("notify");
+    m_instrumentationRefresh.start();
+
+    m_samplerThread = new QThread(this);
+    m_samplerThread->setObjectName("MetricsSampler");
+
+    // No parent: the sampler is moved to the worker thread and deleted there
+    m_sampler = new MetricsSampler(m_updateInterval * 1000, m_historyStore.get(), m_quantileStore.get(),
+                                   m_instrumentation.get());
+    m_sampler->moveToThread(m_samplerThread);
+
+    connect(m_samplerThread, &QThread::started, m_sampler, &MetricsSampler::start);
+    connect(m_samplerThread, &QThread::finished, m_sampler, &QObject::deleteLater);
+    connect(m_sampler, &MetricsSampler::snapshotReady,
+            this, &SystemController::onSnapshotReady, Qt::QueuedConnection);
+
+    m_samplerThread->start();
+}
+
+void SystemController::setNavigation(NavigationController* navigation)
+{
+    auto forwardPage = [this, navigation]() {
+        const int index = navigation->currentIndex();
+        MetricsSampler* sampler = m_sampler;
+        QMetaObject::invokeMethod(sampler, [sampler, index]() {
+            sampler->setVisiblePage(index);
+        }, Qt::QueuedConnection);
+    };
+
+    connect(navigation, &NavigationController::currentIndexChanged, this, forwardPage);
+    forwardPage();
 }
 
 void SystemController::connectSignals()
@@ -137,198 +141,158 @@ void SystemController::connectSignals()
 
     // Load initial logs
     m_systemLogs = m_settingsManager->systemLogs();
+
+#if LOG_LEVEL > LOG_LEVEL_OFF
+    // Level changes from SIGUSR1/SIGUSR2 or the environment; not saved
+    connect(&Logger::instance(), &Logger::logLevelChanged, this, [this](int level) {
+        if (m_logLevel != level) {
+            m_logLevel = level;
+            emit logLevelChanged();
+        }
+    });
+#endif
 }
 
-void SystemController::updateAllMetrics() 
-{
-    // ==================== CPU ====================
-    int newCpuUsage = m_cpuMonitor->parseUsage();
-    if (m_cpuUsage != newCpuUsage) {
-        m_cpuUsage = newCpuUsage;
-        emit cpuUsageChanged();
-    }
-    
-    int newCpuTemp = m_cpuMonitor->parseTemp();
-    if (m_cpuTemp != newCpuTemp) {
-        m_cpuTemp = newCpuTemp;
-        emit cpuTempChanged();
-    }
+namespace {
 
-    QString newCpuClock = m_cpuMonitor->parseClock();
-    if (m_cpuClock != newCpuClock) {
-        m_cpuClock = newCpuClock;
-        emit cpuClockChanged();
-    }
-
-    // Per-core usage
-    m_coreUsages = m_cpuMonitor->parsePerCoreUsage();
-    emit coreUsagesChanged();
+/**
+ * @brief NOTIFY signal of each MetricField bit
+ */
+struct FieldSignal {
+    quint64 field;
+    void (SystemController::*signal)();
+};
+
+const FieldSignal FIELD_SIGNALS[] = {
+    // CPU
+    { MetricField::CpuUsage, &SystemController::cpuUsageChanged },
+    { MetricField::CpuTemp, &SystemController::cpuTempChanged },
+    { MetricField::CpuClock, &SystemController::cpuClockChanged },
+    { MetricField::LoadAverage, &SystemController::loadAverageChanged },
+
+    // GPU
+    { MetricField::GpuUsage, &SystemController::gpuUsageChanged },
+    { MetricField::GpuTemp, &SystemController::gpuTempChanged },
+    { MetricField::GpuMemUsage, &SystemController::gpuMemUsageChanged },
+
+    // RAM
+    { MetricField::RamUsage, &SystemController::ramUsageChanged },
+    { MetricField::RamUsed, &SystemController::ramUsedChanged },
+    { MetricField::RamFree, &SystemController::ramFreeChanged },
+    { MetricField::RamCache, &SystemController::ramCacheChanged },
+    { MetricField::RamTotal, &SystemController::ramTotalChanged },
+
+    // Storage
+    { MetricField::HddUsage, &SystemController::hddUsageChanged },
+    { MetricField::HddTemp, &SystemController::hddTempChanged },
+    { MetricField::HddTotal, &SystemController::hddTotalChanged },
+    { MetricField::HddUsed, &SystemController::hddUsedChanged },
+    { MetricField::HddFree, &SystemController::hddFreeChanged },
+    { MetricField::SwapUsage, &SystemController::swapUsageChanged },
+    { MetricField::SwapTotal, &SystemController::swapTotalChanged },
+    { MetricField::SwapUsed, &SystemController::swapUsedChanged },
+    { MetricField::SwapFree, &SystemController::swapFreeChanged },
+    { MetricField::IoRead, &SystemController::ioReadChanged },
+    { MetricField::IoWrite, &SystemController::ioWriteChanged },
+    { MetricField::DiskDevices, &SystemController::diskDevicesChanged },
+
+    // Network
+    { MetricField::NetworkInterface, &SystemController::networkInterfaceChanged },
+    { MetricField::IpAddress, &SystemController::ipAddressChanged },
+    { MetricField::MacAddress, &SystemController::macAddressChanged },
+    { MetricField::NetUpSpeed, &SystemController::netUpSpeedChanged },
+    { MetricField::NetDownSpeed, &SystemController::netDownSpeedChanged },
+    { MetricField::PacketRate, &SystemController::packetRateChanged },
+    { MetricField::ActiveConnections, &SystemController::activeConnectionsChanged },
+
+    // Processes
+    { MetricField::Processes, &SystemController::processesChanged },
+
+    // System
+    { MetricField::Uptime, &SystemController::uptimeChanged },
+    { MetricField::SystemTime, &SystemController::systemTimeChanged },
+};
+
+} // namespace
+
+void SystemController::onSnapshotReady()
+{
+    TraceScope trace("onSnapshotReady", "gui");
 
-    // Temperature history 
-    m_cpuMonitor->updateTempHistory(m_cpuTemp);
-    m_tempHistory = m_cpuMonitor->getTempHistory();
-    emit tempHistoryChanged();
+    // Several notifications may be queued; only the newest snapshot matters
+    std::shared_ptr<const MetricsSnapshot> snapshot = m_sampler->latestSnapshot();
 
-    // Load average
-    QString newLoadAverage = m_cpuMonitor->parseLoadAverage();
-    if (m_loadAverage != newLoadAverage) {
-        m_loadAverage = newLoadAverage;
-        emit loadAverageChanged();
+    if (!snapshot || snapshot->sequence == m_snapshot->sequence) {
+        return;
     }
 
-    // ==================== GPU ====================
-    int newGpuTemp = m_gpuMonitor->parseTemp();
-    if (m_gpuTemp != newGpuTemp) {
-        m_gpuTemp = newGpuTemp;
-        emit gpuTempChanged();
-    }
+    // The sampler diffed against its previous snapshot; if we skipped some
+    // in between, that mask is incomplete and we diff against ours
+    const quint64 changed = (snapshot->sequence == m_snapshot->sequence + 1)
+                            ? snapshot->changed
+                            : diffSnapshots(*m_snapshot, *snapshot);
 
-    int newGpuMem = m_gpuMonitor->parseMemUsage();
-    if (m_gpuMemUsage != newGpuMem) {
-        m_gpuMemUsage = newGpuMem;
-        emit gpuMemUsageChanged();
-    }
+    m_snapshot = std::move(snapshot);
 
-    // GPU usage = CPU usage for Pi (shared)
-    if (m_gpuUsage != m_cpuUsage) {
-        m_gpuUsage = m_cpuUsage;
-        emit gpuUsageChanged();
+    {
+        ScopeTimer timer(m_notifyProbe);
+        applyChanges(changed);
     }
 
-    // ==================== RAM ====================
-    int newRamUsage = m_memMonitor->parseUsage();
-    if (m_ramUsage != newRamUsage) {
-        m_ramUsage = newRamUsage;
-        emit ramUsageChanged();
+    if (m_instrumentationRefresh.elapsed() >= INSTRUMENTATION_REFRESH_MS) {
+        m_instrumentationRefresh.restart();
+        emit instrumentationChanged();
     }
+}
 
-    QString newRamUsed = m_memMonitor->parseUsed();
-    if (m_ramUsed != newRamUsed) {
-        m_ramUsed = newRamUsed;
-        emit ramUsedChanged();
-    }
+void SystemController::applyChanges(quint64 changed)
+{
+    const MetricsSnapshot& snapshot = *m_snapshot;
 
-    QString newRamFree = m_memMonitor->parseFree();
-    if (m_ramFree != newRamFree) {
-        m_ramFree = newRamFree;
-        emit ramFreeChanged();
+    // ==================== Models ====================
+    if (changed & MetricField::CoreUsages) {
+        m_coreUsageModel->setUsages(snapshot.coreUsages);
     }
-
-    QString newRamCache = m_memMonitor->parseCache();
-    if (m_ramCache != newRamCache) {
-        m_ramCache = newRamCache;
-        emit ramCacheChanged();
+    if (changed & MetricField::TempHistory) {
+        m_tempHistoryModel->sync(snapshot.tempHistory.values, snapshot.tempHistory.total);
     }
-
-    int newRamTotal = m_memMonitor->parseTotal();
-    if (m_ramTotal != newRamTotal) {
-        m_ramTotal = newRamTotal;
-        emit ramTotalChanged();
+    if (changed & MetricField::IoHistory) {
+        m_ioHistoryModel->sync(snapshot.ioHistory.values, snapshot.ioHistory.total);
     }
-
-    // ==================== Storage ====================
-    int newHddUsage = m_storageMonitor->parseUsage();
-    if (m_hddUsage != newHddUsage) {
-        m_hddUsage = newHddUsage;
-        emit hddUsageChanged();
+    if (changed & MetricField::NetUpHistory) {
+        m_netUpHistoryModel->sync(snapshot.netUpHistory.values, snapshot.netUpHistory.total);
     }
-
-    int newHddTemp = m_storageMonitor->parseTemp();
-    if (m_hddTemp != newHddTemp) {
-        m_hddTemp = newHddTemp;
-        emit hddTempChanged();
+    if (changed & MetricField::NetDownHistory) {
+        m_netDownHistoryModel->sync(snapshot.netDownHistory.values, snapshot.netDownHistory.total);
     }
 
-    // Root partition
-    m_storageMonitor->updateRootPartition();
-    
-    QString newHddTotal = m_storageMonitor->getRootTotal();
-    if (m_hddTotal != newHddTotal) {
-        m_hddTotal = newHddTotal;
-        emit hddTotalChanged();
-    }
-
-    QString newHddUsed = m_storageMonitor->getRootUsed();
-    if (m_hddUsed != newHddUsed) {
-        m_hddUsed = newHddUsed;
-        emit hddUsedChanged();
+    // ==================== System ====================
+    // Cheap /proc/uptime read and clock formatting, kept on the GUI side
+    const QString uptime = m_settingsManager->uptime();
+    if (uptime != m_uptime) {
+        m_uptime = uptime;
+        changed |= MetricField::Uptime;
     }
 
-    QString newHddFree = m_storageMonitor->getRootFree();
-    if (m_hddFree != newHddFree) {
-        m_hddFree = newHddFree;
-        emit hddFreeChanged();
+    const QString systemTime = m_settingsManager->systemTime();
+    if (systemTime != m_systemTime) {
+        m_systemTime = systemTime;
+        changed |= MetricField::SystemTime;
     }
 
-    // Swap
-    m_storageMonitor->updateSwap();
-
-    int newSwapUsage = m_storageMonitor->getSwapUsage();
-    if (m_swapUsage != newSwapUsage) {
-        m_swapUsage = newSwapUsage;
-        emit swapUsageChanged();
+    // ==================== Notify ====================
+    // One pass over the mask; unchanged properties never emit
+    for (const FieldSignal& entry : FIELD_SIGNALS) {
+        if (changed & entry.field) {
+            emit (this->*entry.signal)();
+        }
     }
-
-    m_swapTotal = m_storageMonitor->getSwapTotal();
-    emit swapTotalChanged();
-    
-    m_swapUsed = m_storageMonitor->getSwapUsed();
-    emit swapUsedChanged();
-    
-    m_swapFree = m_storageMonitor->getSwapFree();
-    emit swapFreeChanged();
-
-    // I/O
-    m_storageMonitor->updateIoStats();
-    
-    m_ioRead = m_storageMonitor->getIoRead();
-    emit ioReadChanged();
-    
-    m_ioWrite = m_storageMonitor->getIoWrite();
-    emit ioWriteChanged();
-    
-    m_ioHistory = m_storageMonitor->getIoHistory();
-    emit ioHistoryChanged();
-
-    // ==================== Network ====================
-    m_networkMonitor->update();
-
-    m_networkInterface = m_networkMonitor->getInterface();
-    emit networkInterfaceChanged();
-
-    m_ipAddress = m_networkMonitor->getIpAddress();
-    emit ipAddressChanged();
-
-    m_macAddress = m_networkMonitor->getMacAddress();
-    emit macAddressChanged();
-
-    m_netUpSpeed = m_networkMonitor->getUpSpeed();
-    emit netUpSpeedChanged();
-
-    m_netDownSpeed = m_networkMonitor->getDownSpeed();
-    emit netDownSpeedChanged();
-
-    m_packetRate = m_networkMonitor->getPacketRate();
-    emit packetRateChanged();
-
-    m_activeConnections = m_networkMonitor->getActiveConnections();
-    emit activeConnectionsChanged();
-
-    m_netUpHistory = m_networkMonitor->getUpHistory();
-    emit netUpHistoryChanged();
-
-    m_netDownHistory = m_networkMonitor->getDownHistory();
-    emit netDownHistoryChanged();
-
-    // ==================== System ====================
-    m_uptime = m_settingsManager->uptime();
-    emit uptimeChanged();
-
-    m_systemTime = m_settingsManager->systemTime();
-    emit systemTimeChanged();
+    emit metricsUpdated(changed);
 
     // ==================== Check Thresholds ====================
-    checkThresholds();
+    if (changed & (MetricField::CpuUsage | MetricField::RamUsage)) {
+        checkThresholds();
+    }
 }
 
 void SystemController::checkThresholds()
@@ -338,29 +302,31 @@ void SystemController::checkThresholds()
 
     // CPU thresholds
     int cpuWarningLevel = 0;
-    if (m_cpuUsage >= m_cpuCritThreshold) {
+    const int cpuUsage = m_snapshot->cpuUsage;
+    if (cpuUsage >= m_cpuCritThreshold) {
         cpuWarningLevel = 2;
     }
-    else if (m_cpuUsage >= m_cpuWarnThreshold) {
+    else if (cpuUsage >= m_cpuWarnThreshold) {
         cpuWarningLevel = 1;
     }
 
     if (cpuWarningLevel != lastCpuWarningLevel) {
         if (cpuWarningLevel == 2) {
-            m_settingsManager->addLog("CRIT", QString("CPU usage critical: %1%").arg(m_cpuUsage));
+            m_settingsManager->addLog("CRIT", QString("CPU usage critical: %1%").arg(cpuUsage));
         }
         else if (cpuWarningLevel == 1) {
-            m_settingsManager->addLog("WARN", QString("CPU usage high: %1%").arg(m_cpuUsage));
+            m_settingsManager->addLog("WARN", QString("CPU usage high: %1%").arg(cpuUsage));
         }
         lastCpuWarningLevel = cpuWarningLevel;
     }
 
     // RAM thresholds
-    int ramWarningLevel = (m_ramUsage >= m_ramWarnThreshold) ? 1 : 0;
+    const int ramUsage = m_snapshot->ramUsage;
+    int ramWarningLevel = (ramUsage >= m_ramWarnThreshold) ? 1 : 0;
 
     if (ramWarningLevel != lastRamWarningLevel) {
         if (ramWarningLevel == 1) {
-            m_settingsManager->addLog("WARN", QString("RAM usage high: %1%").arg(m_ramUsage));
+            m_settingsManager->addLog("WARN", QString("RAM usage high: %1%").arg(ramUsage));
         }
         lastRamWarningLevel = ramWarningLevel;
     }
@@ -373,7 +339,12 @@ void SystemController::setUpdateInterval(int interval)
     if (m_updateInterval != interval && interval >= 1 && interval <= 10) {
         m_updateInterval = interval;
         m_settingsManager->setUpdateInterval(interval);
-        m_updateTimer->setInterval(interval * 1000);
+
+        // The sampler lives on its own thread; hand the change over queued
+        MetricsSampler* sampler = m_sampler;
+        QMetaObject::invokeMethod(sampler, [sampler, interval]() {
+            sampler->setInterval(interval * 1000);
+        }, Qt::QueuedConnection);
         emit updateIntervalChanged();
     }
 }
@@ -396,6 +367,22 @@ void SystemController::setSoundAlert(bool enabled)
     }
 }
 
+int SystemController::maxLogLevel() const
+{
+    return Logger::maxLogLevel();
+}
+
+void SystemController::setLogLevel(int level)
+{
+    level = qBound(LOG_LEVEL_OFF, level, maxLogLevel());
+    if (m_logLevel != level) {
+        m_logLevel = level;
+        m_settingsManager->setLogLevel(level);
+        Logger::instance().setLogLevel(level);
+        emit logLevelChanged();
+    }
+}
+
 void SystemController::setCpuWarnThreshold(int threshold)
 {
     if (m_cpuWarnThreshold != threshold) {
@@ -444,3 +431,154 @@ void SystemController::addLog(const QString& level, const QString& message)
 {
     m_settingsManager->addLog(level, message);
 }
+
+// ==================== Instrumentation ====================
+
+QVariantList SystemController::instrumentation() const
+{
+    return m_instrumentation->report();
+}
+
+bool SystemController::countsAllocations() const
+{
+    return Instrumentation::countsAllocations();
+}
+
+void SystemController::resetInstrumentation()
+{
+    m_instrumentation->clear();
+    emit instrumentationChanged();
+}
+
+bool SystemController::tracing() const
+{
+    return TraceRecorder::isEnabled();
+}
+
+bool SystemController::dumpTrace()
+{
+    const QString path = TraceRecorder::instance().path();
+    if (!TraceRecorder::instance().dump(path)) {
+        LOG_WARNING("Trace: cannot write %1", path);
+        return false;
+    }
+
+    LOG_INFO("Trace written to %1", path);
+    return true;
+}
+
+namespace {
+
+/**
+ * @brief Bucket a compressed series the way RrdArchive::read() does
+ *
+ * Only the blocks that reach into the window are decoded.
+ */
+QVector<RrdArchive::Point> seriesPoints(const CompressedSeries& series, qint64 rangeSec,
+                                        qint64 nowSec, int maxPoints)
+{
+    if (rangeSec <= 0 || maxPoints <= 0) {
+        return {};
+    }
+
+    const qint64 from = nowSec - rangeSec + 1;
+    const int points = static_cast<int>(qMin<qint64>(maxPoints, rangeSec));
+
+    QVector<RrdArchive::Point> result(points);
+    QVector<int> counts(points, 0);
+
+    for (auto it = series.lowerBound(from); it != series.end() && it->timeSec <= nowSec; ++it) {
+        const int p = static_cast<int>((it->timeSec - from) * points / rangeSec);
+        RrdArchive::Point& point = result[p];
+
+        point.min = counts[p] == 0 ? it->value : qMin(point.min, it->value);
+        point.max = counts[p] == 0 ? it->value : qMax(point.max, it->value);
+        point.avg += it->value;
+        ++counts[p];
+    }
+
+    for (int p = 0; p < points; ++p) {
+        RrdArchive::Point& point = result[p];
+        point.timeSec = from + rangeSec * p / points;
+        if (counts[p] > 0) {
+            point.avg /= counts[p];
+            point.valid = true;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+QVariantList SystemController::archivedHistory(const QString& metric, int rangeSeconds, int points) const
+{
+    const int id = HistoryStore::metricForName(metric);
+    if (id < 0) {
+        LOG_WARNING("archivedHistory: unknown metric %1", metric);
+        return {};
+    }
+
+    // Metrics the monitors also keep in memory, at full resolution
+    const CompressedSeries* series = nullptr;
+    switch (id) {
+    case HistoryStore::CpuTemp: series = &m_snapshot->tempSeries; break;
+    case HistoryStore::DiskIo:  series = &m_snapshot->ioSeries; break;
+    case HistoryStore::NetUp:   series = &m_snapshot->netUpSeries; break;
+    case HistoryStore::NetDown: series = &m_snapshot->netDownSeries; break;
+    default: break;
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    const bool seriesCovers = series && !series->isEmpty() && series->firstTime() <= now - rangeSeconds;
+
+    auto firstValid = [](const QVector<RrdArchive::Point>& points) {
+        return std::find_if(points.cbegin(), points.cend(),
+                            [](const RrdArchive::Point& point) { return point.valid; });
+    };
+
+    // The series needs no disk access; the archive outlives restarts.
+    // With no archive (unwritable data directory) a partial series still
+    // beats an empty chart.
+    QVector<RrdArchive::Point> history;
+    if (!seriesCovers) {
+        history = m_historyStore->read(static_cast<HistoryStore::Metric>(id), rangeSeconds, points);
+    }
+    if (series && (seriesCovers || firstValid(history) == history.cend())) {
+        history = seriesPoints(*series, rangeSeconds, now, points);
+    }
+
+    auto first = firstValid(history);
+    if (first == history.cend()) {
+        return {};
+    }
+
+    // The chart spaces values evenly, so gaps (sampler stopped, device
+    // off) are bridged: leading ones with the first value, the rest with
+    // the last value before them
+    QVariantList values;
+    values.reserve(history.size());
+
+    double last = first->avg;
+    for (const RrdArchive::Point& point : history) {
+        if (point.valid) {
+            last = point.avg;
+        }
+        values.append(last);
+    }
+    return values;
+}
+
+double SystemController::percentile(const QString& metric, double q, int windowSec) const
+{
+    const int id = HistoryStore::metricForName(metric);
+    if (id < 0) {
+        LOG_WARNING("percentile: unknown metric %1", metric);
+        return -1.0;
+    }
+
+    double value = 0.0;
+    if (!m_quantileStore->quantile(static_cast<HistoryStore::Metric>(id), q, windowSec, value)) {
+        return -1.0;
+    }
+    return value;
+}
@@ -9,16 +9,23 @@
 #define SYSTEMCONTROLLER_H
 
 #include <QObject>
-#include <QTimer>
+#include <QElapsedTimer>
+#include <QList>
 #include <QString>
 #include <QVariantList>
+#include <memory>
+
+#include "HistoryModel.h"
+#include "MetricsSnapshot.h"
 
 // Forward declarations
-class CpuMonitor;
-class GpuMonitor;
-class MemoryMonitor;
-class StorageMonitor;
-class NetworkMonitor;
+class QThread;
+class HistoryStore;
+class Instrumentation;
+class MetricsSampler;
+class Probe;
+class QuantileStore;
+class NavigationController;
 class SettingsManager;
 
 
@@ -27,9 +34,10 @@ class SettingsManager;
  * @brief Central controller that coordinates all monitors and settings
  * 
  * Responsibilities:
- * - Create and manage monitor instances
- * - Periodic update of all metrics
- * - Expose data to QML via Q_PROPERTY
+ * - Run the MetricsSampler on its own thread
+ * - Apply sampler snapshots and notify QML of changed values
+ * - Expose data to QML via Q_PROPERTY, as raw numbers in base units
+ *   (bytes, bytes/s, Hz); QML formats them through UnitFormatter
  * - Handle user actions (settings, reboot, shutdown)
  */
 class SystemController : public QObject
@@ -39,51 +47,61 @@ class SystemController : public QObject
     // ==================== CPU Properties ====================
     Q_PROPERTY(int cpuUsage READ cpuUsage NOTIFY cpuUsageChanged)
     Q_PROPERTY(int cpuTemp READ cpuTemp NOTIFY cpuTempChanged)
-    Q_PROPERTY(QString cpuClock READ cpuClock NOTIFY cpuClockChanged)
-    Q_PROPERTY(QVariantList coreUsages READ coreUsages NOTIFY coreUsagesChanged)
-    Q_PROPERTY(QVariantList tempHistory READ tempHistory NOTIFY tempHistoryChanged)
-    Q_PROPERTY(QString loadAverage READ loadAverage NOTIFY loadAverageChanged)
+    Q_PROPERTY(qint64 cpuClock READ cpuClock NOTIFY cpuClockChanged)
+    Q_PROPERTY(CoreUsageModel* coreUsageModel READ coreUsageModel CONSTANT)
+    Q_PROPERTY(HistoryModel* tempHistoryModel READ tempHistoryModel CONSTANT)
+    Q_PROPERTY(QList<qreal> loadAverage READ loadAverage NOTIFY loadAverageChanged)
 
     // ==================== GPU Properties ====================
     Q_PROPERTY(int gpuUsage READ gpuUsage NOTIFY gpuUsageChanged)
     Q_PROPERTY(int gpuTemp READ gpuTemp NOTIFY gpuTempChanged)
-    Q_PROPERTY(int gpuMemUsage READ gpuMemUsage NOTIFY gpuMemUsageChanged)
+    Q_PROPERTY(qint64 gpuMemUsage READ gpuMemUsage NOTIFY gpuMemUsageChanged)
 
     // ==================== RAM Properties ====================
     Q_PROPERTY(int ramUsage READ ramUsage NOTIFY ramUsageChanged)
-    Q_PROPERTY(QString ramUsed READ ramUsed NOTIFY ramUsedChanged)
-    Q_PROPERTY(QString ramFree READ ramFree NOTIFY ramFreeChanged)
-    Q_PROPERTY(QString ramCache READ ramCache NOTIFY ramCacheChanged)
-    Q_PROPERTY(int ramTotal READ ramTotal NOTIFY ramTotalChanged)
+    Q_PROPERTY(qint64 ramUsed READ ramUsed NOTIFY ramUsedChanged)
+    Q_PROPERTY(qint64 ramFree READ ramFree NOTIFY ramFreeChanged)
+    Q_PROPERTY(qint64 ramCache READ ramCache NOTIFY ramCacheChanged)
+    Q_PROPERTY(qint64 ramTotal READ ramTotal NOTIFY ramTotalChanged)
 
     // ==================== Storage Properties ====================
     Q_PROPERTY(int hddUsage READ hddUsage NOTIFY hddUsageChanged)
     Q_PROPERTY(int hddTemp READ hddTemp NOTIFY hddTempChanged)
-    Q_PROPERTY(QString hddTotal READ hddTotal NOTIFY hddTotalChanged)
-    Q_PROPERTY(QString hddUsed READ hddUsed NOTIFY hddUsedChanged)
-    Q_PROPERTY(QString hddFree READ hddFree NOTIFY hddFreeChanged)
+    Q_PROPERTY(qint64 hddTotal READ hddTotal NOTIFY hddTotalChanged)
+    Q_PROPERTY(qint64 hddUsed READ hddUsed NOTIFY hddUsedChanged)
+    Q_PROPERTY(qint64 hddFree READ hddFree NOTIFY hddFreeChanged)
 
     // Swap
     Q_PROPERTY(int swapUsage READ swapUsage NOTIFY swapUsageChanged)
-    Q_PROPERTY(QString swapTotal READ swapTotal NOTIFY swapTotalChanged)
-    Q_PROPERTY(QString swapUsed READ swapUsed NOTIFY swapUsedChanged)
-    Q_PROPERTY(QString swapFree READ swapFree NOTIFY swapFreeChanged)
+    Q_PROPERTY(qint64 swapTotal READ swapTotal NOTIFY swapTotalChanged)
+    Q_PROPERTY(qint64 swapUsed READ swapUsed NOTIFY swapUsedChanged)
+    Q_PROPERTY(qint64 swapFree READ swapFree NOTIFY swapFreeChanged)
     
     // I/O
-    Q_PROPERTY(QString ioRead READ ioRead NOTIFY ioReadChanged)
-    Q_PROPERTY(QString ioWrite READ ioWrite NOTIFY ioWriteChanged)
-    Q_PROPERTY(QVariantList ioHistory READ ioHistory NOTIFY ioHistoryChanged)
+    Q_PROPERTY(double ioRead READ ioRead NOTIFY ioReadChanged)
+    Q_PROPERTY(double ioWrite READ ioWrite NOTIFY ioWriteChanged)
+    Q_PROPERTY(HistoryModel* ioHistoryModel READ ioHistoryModel CONSTANT)
+    Q_PROPERTY(QVariantList diskDevices READ diskDevices NOTIFY diskDevicesChanged)
 
     // ==================== Network Properties ====================
     Q_PROPERTY(QString networkInterface READ networkInterface NOTIFY networkInterfaceChanged)
     Q_PROPERTY(QString ipAddress READ ipAddress NOTIFY ipAddressChanged)
     Q_PROPERTY(QString macAddress READ macAddress NOTIFY macAddressChanged)
-    Q_PROPERTY(QString netUpSpeed READ netUpSpeed NOTIFY netUpSpeedChanged)
-    Q_PROPERTY(QString netDownSpeed READ netDownSpeed NOTIFY netDownSpeedChanged)
-    Q_PROPERTY(QString packetRate READ packetRate NOTIFY packetRateChanged)
+    Q_PROPERTY(double netUpSpeed READ netUpSpeed NOTIFY netUpSpeedChanged)
+    Q_PROPERTY(double netDownSpeed READ netDownSpeed NOTIFY netDownSpeedChanged)
+    Q_PROPERTY(double packetRate READ packetRate NOTIFY packetRateChanged)
     Q_PROPERTY(int activeConnections READ activeConnections NOTIFY activeConnectionsChanged)
-    Q_PROPERTY(QVariantList netUpHistory READ netUpHistory NOTIFY netUpHistoryChanged)
-    Q_PROPERTY(QVariantList netDownHistory READ netDownHistory NOTIFY netDownHistoryChanged)
+    Q_PROPERTY(HistoryModel* netUpHistoryModel READ netUpHistoryModel CONSTANT)
+    Q_PROPERTY(HistoryModel* netDownHistoryModel READ netDownHistoryModel CONSTANT)
+
+    // ==================== Process Properties ====================
+    Q_PROPERTY(QVariantList topCpuProcesses READ topCpuProcesses NOTIFY processesChanged)
+    Q_PROPERTY(QVariantList topMemoryProcesses READ topMemoryProcesses NOTIFY processesChanged)
+    Q_PROPERTY(int processCount READ processCount NOTIFY processesChanged)
+    Q_PROPERTY(double forkRate READ forkRate NOTIFY processesChanged)
+    Q_PROPERTY(double execRate READ execRate NOTIFY processesChanged)
+    Q_PROPERTY(double exitRate READ exitRate NOTIFY processesChanged)
+    Q_PROPERTY(bool processEvents READ processEvents NOTIFY processesChanged)
   
     // ==================== System Properties ====================
     Q_PROPERTY(QString hostname READ hostname CONSTANT)
@@ -96,6 +114,8 @@ class SystemController : public QObject
     Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval NOTIFY updateIntervalChanged)
     Q_PROPERTY(bool darkMode READ darkMode WRITE setDarkMode NOTIFY darkModeChanged)
     Q_PROPERTY(bool soundAlert READ soundAlert WRITE setSoundAlert NOTIFY soundAlertChanged)
+    Q_PROPERTY(int logLevel READ logLevel WRITE setLogLevel NOTIFY logLevelChanged)
+    Q_PROPERTY(int maxLogLevel READ maxLogLevel CONSTANT)
     
     Q_PROPERTY(int cpuWarnThreshold READ cpuWarnThreshold WRITE setCpuWarnThreshold NOTIFY cpuWarnThresholdChanged)
     Q_PROPERTY(int cpuCritThreshold READ cpuCritThreshold WRITE setCpuCritThreshold NOTIFY cpuCritThresholdChanged)
@@ -104,54 +124,74 @@ class SystemController : public QObject
     // ==================== Logs ====================
     Q_PROPERTY(QVariantList systemLogs READ systemLogs NOTIFY systemLogsChanged)
 
+    // ==================== Instrumentation ====================
+    Q_PROPERTY(QVariantList instrumentation READ instrumentation NOTIFY instrumentationChanged)
+    Q_PROPERTY(bool countsAllocations READ countsAllocations CONSTANT)
+    Q_PROPERTY(bool tracing READ tracing CONSTANT)
+
 public:
     explicit SystemController(QObject* parent = nullptr);
     ~SystemController() override;
 
+    /**
+     * @brief Follow the visible page, so the sampler can idle unseen collectors
+     */
+    void setNavigation(NavigationController* navigation);
+
     // ==================== CPU Getters ====================
-    int cpuUsage() const { return m_cpuUsage; }
-    int cpuTemp() const { return m_cpuTemp; }
-    QString cpuClock() const { return m_cpuClock; }
-    QVariantList coreUsages() const { return m_coreUsages; }
-    QVariantList tempHistory() const { return m_tempHistory; }
-    QString loadAverage() const { return m_loadAverage; }
+    int cpuUsage() const { return m_snapshot->cpuUsage; }
+    int cpuTemp() const { return m_snapshot->cpuTemp; }
+    qint64 cpuClock() const { return m_snapshot->cpuClock; }
+    CoreUsageModel* coreUsageModel() const { return m_coreUsageModel; }
+    HistoryModel* tempHistoryModel() const { return m_tempHistoryModel; }
+    QList<qreal> loadAverage() const { return m_snapshot->loadAverage; }
 
     // ==================== GPU Getters ====================
-    int gpuUsage() const { return m_gpuUsage; }
-    int gpuTemp() const { return m_gpuTemp; }
-    int gpuMemUsage() const { return m_gpuMemUsage; }
+    int gpuUsage() const { return m_snapshot->gpuUsage; }
+    int gpuTemp() const { return m_snapshot->gpuTemp; }
+    qint64 gpuMemUsage() const { return m_snapshot->gpuMemUsage; }
 
     // ==================== RAM Getters ====================
-    int ramUsage() const { return m_ramUsage; }
-    QString ramUsed() const { return m_ramUsed; }
-    QString ramFree() const { return m_ramFree; }
-    QString ramCache() const { return m_ramCache; }
-    int ramTotal() const { return m_ramTotal; }
+    int ramUsage() const { return m_snapshot->ramUsage; }
+    qint64 ramUsed() const { return m_snapshot->ramUsed; }
+    qint64 ramFree() const { return m_snapshot->ramFree; }
+    qint64 ramCache() const { return m_snapshot->ramCache; }
+    qint64 ramTotal() const { return m_snapshot->ramTotal; }
 
     // ==================== Storage Getters ====================
-    int hddUsage() const { return m_hddUsage; }
-    int hddTemp() const { return m_hddTemp; }
-    QString hddTotal() const { return m_hddTotal; }
-    QString hddUsed() const { return m_hddUsed; }
-    QString hddFree() const { return m_hddFree; }
-    int swapUsage() const { return m_swapUsage; }
-    QString swapTotal() const { return m_swapTotal; }
-    QString swapUsed() const { return m_swapUsed; }
-    QString swapFree() const { return m_swapFree; }
-    QString ioRead() const { return m_ioRead; }
-    QString ioWrite() const { return m_ioWrite; }
-    QVariantList ioHistory() const { return m_ioHistory; }
+    int hddUsage() const { return m_snapshot->hddUsage; }
+    int hddTemp() const { return m_snapshot->hddTemp; }
+    qint64 hddTotal() const { return m_snapshot->hddTotal; }
+    qint64 hddUsed() const { return m_snapshot->hddUsed; }
+    qint64 hddFree() const { return m_snapshot->hddFree; }
+    int swapUsage() const { return m_snapshot->swapUsage; }
+    qint64 swapTotal() const { return m_snapshot->swapTotal; }
+    qint64 swapUsed() const { return m_snapshot->swapUsed; }
+    qint64 swapFree() const { return m_snapshot->swapFree; }
+    double ioRead() const { return m_snapshot->ioRead; }
+    double ioWrite() const { return m_snapshot->ioWrite; }
+    HistoryModel* ioHistoryModel() const { return m_ioHistoryModel; }
+    QVariantList diskDevices() const { return m_snapshot->diskDevices; }
 
     // ==================== Network Getters ====================
-    QString networkInterface() const { return m_networkInterface; }
-    QString ipAddress() const { return m_ipAddress; }
-    QString macAddress() const { return m_macAddress; }
-    QString netUpSpeed() const { return m_netUpSpeed; }
-    QString netDownSpeed() const { return m_netDownSpeed; }
-    QString packetRate() const { return m_packetRate; }
-    int activeConnections() const { return m_activeConnections; }
-    QVariantList netUpHistory() const { return m_netUpHistory; }
-    QVariantList netDownHistory() const { return m_netDownHistory; }
+    QString networkInterface() const { return m_snapshot->networkInterface; }
+    QString ipAddress() const { return m_snapshot->ipAddress; }
+    QString macAddress() const { return m_snapshot->macAddress; }
+    double netUpSpeed() const { return m_snapshot->netUpSpeed; }
+    double netDownSpeed() const { return m_snapshot->netDownSpeed; }
+    double packetRate() const { return m_snapshot->packetRate; }
+    int activeConnections() const { return m_snapshot->activeConnections; }
+    HistoryModel* netUpHistoryModel() const { return m_netUpHistoryModel; }
+    HistoryModel* netDownHistoryModel() const { return m_netDownHistoryModel; }
+
+    // ==================== Process Getters ====================
+    QVariantList topCpuProcesses() const { return m_snapshot->topCpuProcesses; }
+    QVariantList topMemoryProcesses() const { return m_snapshot->topMemoryProcesses; }
+    int processCount() const { return m_snapshot->processCount; }
+    double forkRate() const { return m_snapshot->forkRate; }
+    double execRate() const { return m_snapshot->execRate; }
+    double exitRate() const { return m_snapshot->exitRate; }
+    bool processEvents() const { return m_snapshot->processEvents; }
 
     // ==================== System Getters ====================
     QString hostname() const { return m_hostname; }
@@ -164,6 +204,8 @@ public:
     int updateInterval() const { return m_updateInterval; }
     bool darkMode() const { return m_darkMode; }
     bool soundAlert() const { return m_soundAlert; }
+    int logLevel() const { return m_logLevel; }
+    int maxLogLevel() const;
     int cpuWarnThreshold() const { return m_cpuWarnThreshold; }
     int cpuCritThreshold() const { return m_cpuCritThreshold; }
     int ramWarnThreshold() const { return m_ramWarnThreshold; }
@@ -171,10 +213,27 @@ public:
     // ==================== Logs ====================
     QVariantList systemLogs() const { return m_systemLogs; }
 
+    // ==================== Instrumentation ====================
+    /**
+     * @brief Per-stage timings, see Instrumentation::report()
+     *
+     * Stages are the sampler's collectors, their idle baselines, publish
+     * (diff and snapshot copy) and notify (applying a snapshot on the GUI
+     * thread, including the QML bindings it re-evaluates).
+     */
+    QVariantList instrumentation() const;
+    bool countsAllocations() const;
+
+    /**
+     * @brief true if started with SYSMON_TRACE (see TraceRecorder)
+     */
+    bool tracing() const;
+
     // ==================== Settings Setters ====================
     void setUpdateInterval(int interval);
     void setDarkMode(bool enabled);
     void setSoundAlert(bool enabled);
+    void setLogLevel(int level);
     void setCpuWarnThreshold(int threshold);
     void setCpuCritThreshold(int threshold);
     void setRamWarnThreshold(int threshold);
@@ -184,14 +243,41 @@ public:
     Q_INVOKABLE void reboot();
     Q_INVOKABLE void shutdown();
     Q_INVOKABLE void addLog(const QString& level, const QString& message);
+    Q_INVOKABLE void resetInstrumentation();
+
+    /**
+     * @brief Write the trace recorded so far to the SYSMON_TRACE file
+     * @return false if tracing is off or the file could not be written
+     */
+    Q_INVOKABLE bool dumpTrace();
+
+    /**
+     * @brief Long-range history for charts
+     *
+     * Served from the monitors' in-memory series when they reach back far
+     * enough, otherwise from the on-disk archive.
+     * @param metric "cpuUsage", "cpuTemp", "ramUsage", "diskIo", "netUp" or "netDown"
+     * @param rangeSeconds How far back to go (e.g. 3600, 86400, 2592000)
+     * @param points Values to return at most
+     * @return Average per point, oldest first; gaps repeat the previous
+     *         value, and the list is empty if nothing was recorded yet
+     */
+    Q_INVOKABLE QVariantList archivedHistory(const QString& metric, int rangeSeconds, int points = 120) const;
+
+    /**
+     * @brief Percentile of a metric over a recent window
+     * @param metric Same names as archivedHistory()
+     * @param q 0..1, e.g. 0.99 for p99 (within 1% of a real sample)
+     * @param windowSec Up to an hour, in 10 s steps
+     * @return In the metric's unit, -1 if nothing was sampled in the window
+     */
+    Q_INVOKABLE double percentile(const QString& metric, double q, int windowSec) const;
 
 signals:
     // CPU Signals
     void cpuUsageChanged();
     void cpuTempChanged();
     void cpuClockChanged();
-    void coreUsagesChanged();
-    void tempHistoryChanged();
     void loadAverageChanged();
 
     // GPU Signals
@@ -218,7 +304,7 @@ signals:
     void swapFreeChanged();
     void ioReadChanged();
     void ioWriteChanged();
-    void ioHistoryChanged();
+    void diskDevicesChanged();
 
     // Network Signals
     void networkInterfaceChanged();
@@ -228,8 +314,9 @@ signals:
     void netDownSpeedChanged();
     void packetRateChanged();
     void activeConnectionsChanged();
-    void netUpHistoryChanged();
-    void netDownHistoryChanged();
+
+    // Process Signals
+    void processesChanged();
 
     // System Signals
     void uptimeChanged();
@@ -239,77 +326,66 @@ signals:
     void updateIntervalChanged();
     void darkModeChanged();
     void soundAlertChanged();
+    void logLevelChanged();
     void cpuWarnThresholdChanged();
     void cpuCritThresholdChanged();
     void ramWarnThresholdChanged();
 
     // Logs
     void systemLogsChanged();
+
+    // Instrumentation, at most every INSTRUMENTATION_REFRESH_MS
+    void instrumentationChanged();
     
+    /**
+     * @brief Emitted once per applied snapshot, after the per-property signals
+     * @param changed MetricField bits that changed (may be 0)
+     *
+     * For consumers that would rather refresh in bulk than connect to each
+     * NOTIFY signal.
+     */
+    void metricsUpdated(quint64 changed);
+
 private slots:
-    void updateAllMetrics();
+    void onSnapshotReady();
 
 private:
-    void initializeMonitors();
+    void initializeSampler();
     void connectSignals();
+
+    /**
+     * @brief Push one batch of changes to the models and to QML
+     * @param changed MetricField bits that differ from the previous snapshot
+     */
+    void applyChanges(quint64 changed);
     void checkThresholds();
 
 private:
-    // Monitors (Model layer)
-    CpuMonitor* m_cpuMonitor;
-    GpuMonitor* m_gpuMonitor;
-    MemoryMonitor* m_memMonitor;
-    StorageMonitor* m_storageMonitor;
-    NetworkMonitor* m_networkMonitor;
+    // Sampler (Model layer runs on its own thread)
+    QThread* m_samplerThread;
+    MetricsSampler* m_sampler;
+
+    // On-disk history and percentile sketches, written by the sampler;
+    // both outlive the sampler thread
+    std::unique_ptr<HistoryStore> m_historyStore;
+    std::unique_ptr<QuantileStore> m_quantileStore;
+
+    // Stage timings, recorded by the sampler and by onSnapshotReady()
+    std::unique_ptr<Instrumentation> m_instrumentation;
+    Probe* m_notifyProbe;
+    QElapsedTimer m_instrumentationRefresh;
+
     SettingsManager* m_settingsManager;
 
-    // Update timer
-    QTimer* m_updateTimer;
-
-    // CPU data
-    int m_cpuUsage;
-    int m_cpuTemp;
-    QString m_cpuClock;
-    QVariantList m_coreUsages;
-    QVariantList m_tempHistory;
-    QString m_loadAverage;
-
-    // GPU data
-    int m_gpuUsage;
-    int m_gpuTemp;
-    int m_gpuMemUsage;
-
-    // RAM data
-    int m_ramUsage;
-    QString m_ramUsed;
-    QString m_ramFree;
-    QString m_ramCache;
-    int m_ramTotal;
-
-    // Storage data
-    int m_hddUsage;
-    int m_hddTemp;
-    QString m_hddTotal;
-    QString m_hddUsed;
-    QString m_hddFree;
-    int m_swapUsage;
-    QString m_swapTotal;
-    QString m_swapUsed;
-    QString m_swapFree;
-    QString m_ioRead;
-    QString m_ioWrite;
-    QVariantList m_ioHistory;
-
-    // Network data
-    QString m_networkInterface;
-    QString m_ipAddress;
-    QString m_macAddress;
-    QString m_netUpSpeed;
-    QString m_netDownSpeed;
-    QString m_packetRate;
-    int m_activeConnections;
-    QVariantList m_netUpHistory;
-    QVariantList m_netDownHistory;
+    // Metric values are read straight from the applied snapshot
+    std::shared_ptr<const MetricsSnapshot> m_snapshot;
+
+    // List models fed from the snapshot
+    CoreUsageModel* m_coreUsageModel;
+    HistoryModel* m_tempHistoryModel;
+    HistoryModel* m_ioHistoryModel;
+    HistoryModel* m_netUpHistoryModel;
+    HistoryModel* m_netDownHistoryModel;
 
     // System data
     QString m_hostname;
@@ -322,12 +398,16 @@ private:
     int m_updateInterval;
     bool m_darkMode;
     bool m_soundAlert;
+    int m_logLevel;
     int m_cpuWarnThreshold;
     int m_cpuCritThreshold;
     int m_ramWarnThreshold;
 
     // Logs
     QVariantList m_systemLogs;
+
+    // Constants
+    static constexpr int INSTRUMENTATION_REFRESH_MS = 1000;
 };
 
 #endif // SYSTEMCONTROLLER_H
\ No newline at end of file
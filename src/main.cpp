@@ -5,19 +5,26 @@
  * ============================================================================
  */
 
+#define LOG_CATEGORY LogCategory::Ui
+
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickWindow>
 #include <QFont>
 #include <QFile>
 #include <QDir>
+#include <QStandardPaths>
 
 #include "controller/SystemController.h"
 #include "controller/NavigationController.h"
+#include "view/LineChartItem.h"
+#include "view/UnitFormatter.h"
 
 #include "common/Constants.h"
 #include "common/Logger.h"
+#include "common/TraceRecorder.h"
 
 #ifdef PLATFORM_RASPBERRY_PI
 /**
@@ -89,19 +96,47 @@ int main(int argc, char *argv[])
     Logger::instance().setMaxLogEntries(100);
     LOG_INFO("Application starting...");
 
+    // ==================== Tracing (opt-in) ====================
+    // SYSMON_TRACE=1 (default file) or SYSMON_TRACE=<path>: record a
+    // timeline, written at exit and from the Settings Perf tab
+    const QString traceSetting = qEnvironmentVariable("SYSMON_TRACE");
+    if (!traceSetting.isEmpty()) {
+        QString tracePath = traceSetting;
+        if (traceSetting == "1") {
+            const QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+            QDir().mkpath(appDataPath);
+            tracePath = appDataPath + '/' + QLatin1String(App::Trace::FILE_NAME);
+        }
+        TraceRecorder::instance().enable(tracePath);
+        LOG_INFO("Tracing to %1", tracePath);
+    }
+
+    // ==================== Register QML Types ====================
+    qmlRegisterType<LineChartItem>("SystemMonitor.Charts", 1, 0, "LineChartItem");
+
+    // One formatter for every page, so its per-field cache is shared
+    UnitFormatter* unitFormatter = new UnitFormatter(&app);
+    qmlRegisterSingletonInstance("SystemMonitor.Units", 1, 0, "UnitFormatter", unitFormatter);
+
     // ==================== Create QML Engine ====================
     QQmlApplicationEngine engine;
 
     // ==================== Create Controllers ====================
     SystemController* systemController = new SystemController(&app);
     NavigationController* navController = new NavigationController(&app);
+    systemController->setNavigation(navController);
 
     // ==================== Register Context Properties ====================
     engine.rootContext()->setContextProperty("systemInfo", systemController);
     engine.rootContext()->setContextProperty("navigation", navController);
 
-    // Logger is only available in QML when LOG_LEVEL > 0 (Debug/Development builds)
-    // In Release builds (LOG_LEVEL=0), Logger is a stub without QObject inheritance
+    // Field diagnostics: SYSMON_LOG_LEVEL/SYSMON_LOG_CATEGORIES override the
+    // saved level, SIGUSR1/SIGUSR2 step it while running
+    Logger::instance().configureFromEnvironment();
+    Logger::instance().installSignalHandlers();
+
+    // Logger is only available in QML when LOG_LEVEL > 0
+    // Built with LOG_LEVEL=0, Logger is a stub without QObject inheritance
 #if LOG_LEVEL > LOG_LEVEL_OFF
     engine.rootContext()->setContextProperty("logger", &Logger::instance());
 #endif
@@ -134,6 +169,30 @@ int main(int argc, char *argv[])
         return -1;
     }
 
+    // Scene graph sync and render on the trace; these are emitted on the
+    // render thread, so the connections must be direct
+    if (TraceRecorder::isEnabled()) {
+        QQuickWindow* window = qobject_cast<QQuickWindow*>(engine.rootObjects().constFirst());
+        if (window) {
+            TraceRecorder* trace = &TraceRecorder::instance();
+            QObject::connect(window, &QQuickWindow::beforeSynchronizing, window, [trace]() {
+                trace->begin("sync", "render", TraceRecorder::nowNs());
+            }, Qt::DirectConnection);
+            QObject::connect(window, &QQuickWindow::afterSynchronizing, window, [trace]() {
+                trace->end("sync", "render", TraceRecorder::nowNs());
+            }, Qt::DirectConnection);
+            QObject::connect(window, &QQuickWindow::beforeRendering, window, [trace]() {
+                trace->begin("render", "render", TraceRecorder::nowNs());
+            }, Qt::DirectConnection);
+            QObject::connect(window, &QQuickWindow::afterRendering, window, [trace]() {
+                trace->end("render", "render", TraceRecorder::nowNs());
+            }, Qt::DirectConnection);
+            QObject::connect(window, &QQuickWindow::frameSwapped, window, [trace]() {
+                trace->instant("frameSwapped", "render", TraceRecorder::nowNs());
+            }, Qt::DirectConnection);
+        }
+    }
+
     // ==================== Log Startup Complete ====================
     LOG_INFO("Application started successfully");
     
@@ -141,5 +200,10 @@ int main(int argc, char *argv[])
     qDebug() << App::Info::NAME << "v" << App::Info::VERSION;
     qDebug() << "==========================================";
 
-    return app.exec();
+    const int result = app.exec();
+
+    if (TraceRecorder::isEnabled()) {
+        TraceRecorder::instance().dump();
+    }
+    return result;
 }
\ No newline at end of file
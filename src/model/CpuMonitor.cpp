@@ -5,20 +5,81 @@
  * ============================================
  */
 
+#define LOG_CATEGORY LogCategory::Cpu
+
 #include "CpuMonitor.h"
 #include "FileReader.h"
 #include "Constants.h"
 #include "Logger.h"
-#include <QFile>
-#include <QTextStream>
+#include <QDateTime>
 #include <QDir>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/**
+ * @brief Parse an unsigned decimal at p, skipping leading blanks
+ */
+unsigned long long parseNumber(const char*& p, const char* end)
+{
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+
+    unsigned long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<unsigned long long>(*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+bool startsWith(const char* p, const char* end, const char* prefix, qsizetype prefixLen)
+{
+    return (end - p) >= prefixLen && memcmp(p, prefix, static_cast<size_t>(prefixLen)) == 0;
+}
+
+/**
+ * @brief Parse an unsigned fixed-point number ("0.52") at p, skipping leading blanks
+ * @return false if there is no digit at p
+ */
+bool parseDecimal(const char*& p, const char* end, double& value)
+{
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+
+    value = static_cast<double>(parseNumber(p, end));
+
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value += (*p - '0') * scale;
+            scale *= 0.1;
+            ++p;
+        }
+    }
+    return true;
+}
+
+} // namespace
 
 CpuMonitor::CpuMonitor(QObject *parent) 
     : QObject(parent)
     , m_prevTotal(0)
     , m_prevIdle(0)
+    , m_usagePending(false)
+    , m_perCorePending(false)
     , m_coreCount(DEFAULT_CORE_COUNT)
+    , m_loadAvgFile(QString::fromLatin1(App::Path::PROC_LOADAVG))
 {
+    m_statFile.setPath(QString::fromLatin1(App::Path::PROC_STAT));
+
     // Detect number of cores
     QDir cpuDir("/sys/devices/system/cpu");
     QStringList cpuDirs = cpuDir.entryList(QStringList() << "cpu[0-9]*", QDir::Dirs);
@@ -29,21 +90,29 @@ CpuMonitor::CpuMonitor(QObject *parent)
     // Initalize per-core stats
     m_prevCoreStats.resize(m_coreCount);
 
-    // Reserve temperature history buffer
-    m_tempHistory.reserve(MAX_TEMP_HISTORY);
-    
+    // Aggregate line + one slot per core, so the first parse does not grow it
+    m_procStat.cores.resize(m_coreCount + 1);
+    m_statBuffer.reserve(STAT_BUFFER_SIZE);
+
     // Find temperartue sensor path
     m_tempSensorPath = findTempSensorPath();
+    m_tempFile.setPath(m_tempSensorPath);
+    m_freqFile.setPath(findFreqPath());
 
-    LOG_INFO(QString("CpuMonitor initialized - %1 cores, temp sensor: %2")
-            .arg(m_coreCount)
-            .arg(m_tempSensorPath.isEmpty() ? "not found" : m_tempSensorPath));
+    LOG_INFO("CpuMonitor initialized - %1 cores, temp sensor: %2",
+             m_coreCount, m_tempSensorPath.isEmpty() ? QString("not found") : m_tempSensorPath);
 }
 
 int CpuMonitor::parseUsage()
 {
     unsigned long long total, idle;
 
+    // Reuse a read that parsePerCoreUsage() has not consumed yet
+    if (!m_usagePending && !readProcStat()) {
+        return 0;
+    }
+    m_usagePending = false;
+
     if (!parseCpuStats(total, idle)) {
         return 0;
     }
@@ -78,7 +147,7 @@ int CpuMonitor::parseTemp()
         return 0;
     }
 
-    int tempMilliDegrees = FileReader::readInt(m_tempSensorPath, 0);
+    int tempMilliDegrees = m_tempFile.readInt(0);
 
     if (tempMilliDegrees == 0) {
         return 0;
@@ -88,36 +157,32 @@ int CpuMonitor::parseTemp()
     return tempMilliDegrees / 1000;
 }
 
-QString CpuMonitor::parseClock()
+qint64 CpuMonitor::parseClock()
 {
-    // Try multiple paths for CPU frequency
-    QStringList freqPaths = {
-        "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq",
-        "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq"
-    };
-    
-    for (const QString &path : freqPaths) {
-        if (!FileReader::fileExists(path)) {
-            continue;
-        }
-        
-        int freqKHz = FileReader::readInt(path, 0);
-        if (freqKHz > 0) {
-            // Convert tp GHz with 1 decimal place
-            double freqGHz = freqKHz / 1000000.0;
-            return QString::number(freqGHz, 'f', 1) + "G";
-        }
+    int freqKHz = m_freqFile.readInt(0);
+    if (freqKHz > 0) {
+        return static_cast<qint64>(freqKHz) * 1000; // cpufreq reports kHz
     }
     
-    return "N/A";
+    return 0;
 }
 
 QVariantList CpuMonitor::parsePerCoreUsage()
 {
     QVariantList result;
-    
+
+    // Reuse a read that parseUsage() has not consumed yet
+    if (!m_perCorePending && !readProcStat()) {
+        return result;
+    }
+    m_perCorePending = false;
+
+    result.reserve(m_coreCount);
+    const int available = m_procStat.cores.size() - 1;
+
     for (int i = 0; i < m_coreCount; ++i) {
-        CoreStats currentStats = readCoreStats(i);
+        // Offline cores read as zero, which calculateCoreUsage() reports as idle
+        const CoreStats currentStats = (i < available) ? m_procStat.cores[i + 1] : CoreStats();
         int usage = calculateCoreUsage(m_prevCoreStats[i], currentStats);
         m_prevCoreStats[i] = currentStats;
         result.append(usage);
@@ -126,119 +191,148 @@ QVariantList CpuMonitor::parsePerCoreUsage()
     return result;
 }
 
-void CpuMonitor::updateTempHistory(int temp)
+void CpuMonitor::updateCoreBaseline()
 {
-    m_tempHistory.append(temp);
+    if (!m_perCorePending && !readProcStat()) {
+        return;
+    }
+    m_perCorePending = false;
 
-    // Maintain circular buffer behavior
-    while (m_tempHistory.size() > MAX_TEMP_HISTORY) {
-        m_tempHistory.removeFirst();
+    const int available = m_procStat.cores.size() - 1;
+    for (int i = 0; i < m_coreCount; ++i) {
+        m_prevCoreStats[i] = (i < available) ? m_procStat.cores[i + 1] : CoreStats();
     }
 }
 
-QVariantList CpuMonitor::getTempHistory() const
+void CpuMonitor::updateTempHistory(int temp)
 {
-    QVariantList result;
-    result.reserve(m_tempHistory.size());
-
-    // Convert QVector<int> to QVariantList for QML
-    for (int temp : m_tempHistory) {
-        result.append(temp);
-    }
-
-    return result;
+    // Oldest sample is overwritten once the ring is full
+    m_tempHistory.push(temp);
+    m_tempSeries.append(QDateTime::currentSecsSinceEpoch(), temp);
 }
 
-QString CpuMonitor::parseLoadAverage()
+QList<qreal> CpuMonitor::parseLoadAverage()
 {
-    QString loadStr = FileReader::readFirstLine("/proc/loadavg");
+    char buffer[128];
+    qsizetype length = m_loadAvgFile.read(buffer, sizeof(buffer));
 
-    if (loadStr.isEmpty()) {
-        return "N/A";
+    if (length <= 0) {
+        return {};
     }
 
     // Format: "0.00 0.01 0.05 1/234 5678"
     // We want first 3 values
-    QStringList parts = loadStr.split(' ', Qt::SkipEmptyParts);
-
-    if (parts.size() >= 3) {
-        return QString("%1 %2 %3").arg(parts[0], parts[1], parts[2]);
+    const char* p = buffer;
+    const char* end = buffer + length;
+    QList<qreal> loads;
+    loads.reserve(3);
+
+    for (int i = 0; i < 3; ++i) {
+        double value = 0.0;
+        if (!parseDecimal(p, end, value)) {
+            return {};
+        }
+        loads.append(value);
     }
 
-    return "N/A";
+    return loads;
 }
 
-bool CpuMonitor::parseCpuStats(unsigned long long &total, unsigned long long &idle)
+bool CpuMonitor::readProcStat()
 {
-    QStringList lines = FileReader::readLines(App::Path::PROC_STAT);
-
-    if (lines.isEmpty()) {
-        return false;
-    }
-
-    // First line format: "cpu user nice system idle iowait irq softirq ..."
-    QString cpuLine = lines.first();
-
-    if (!cpuLine.startsWith("cpu ")) {
+    // pread() into the reusable buffer; it only grows if the kernel
+    // output outgrows the current capacity
+    if (!m_statFile.read(m_statBuffer)) {
         return false;
     }
 
-    QStringList parts = cpuLine.split(' ', Qt::SkipEmptyParts);
-
-    if (parts.size() < 5) {
+    if (!parseProcStat(m_statBuffer.constData(), m_statBuffer.size(), m_procStat)) {
         return false;
     }
 
-    // Parse CPU times (skip "cpu" label at index 0)
-    unsigned long long user = parts[1].toULongLong();
-    unsigned long long nice = parts[2].toULongLong();
-    unsigned long long system = parts[3].toULongLong();
-    unsigned long long idleTime = parts[4].toULongLong();
-    unsigned long long iowait = (parts.size() > 5) ? parts[5].toULongLong() : 0;
-    unsigned long long irq = (parts.size() > 6) ? parts[6].toULongLong() : 0;
-    unsigned long long softirq = (parts.size() > 7) ? parts[7].toULongLong() : 0;
-
-    // Calculate total and idle
-    total = user + nice + system + idleTime + iowait + irq + softirq;
-    idle = idleTime + iowait;
-    
+    m_usagePending = true;
+    m_perCorePending = true;
     return true;
 }
 
-CpuMonitor::CoreStats CpuMonitor::readCoreStats(int coreNum)
+bool CpuMonitor::parseProcStat(const char *data, qsizetype size, ProcStatSnapshot &snapshot)
 {
-    CoreStats stats;
+    const char* p = data;
+    const char* end = data + size;
+    bool foundAggregate = false;
 
-    QFile file(App::Path::PROC_STAT);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return stats;
-    }
+    snapshot.ctxt = 0;
+    snapshot.procsRunning = 0;
+    snapshot.procsBlocked = 0;
 
-    QTextStream stream(&file);
-    QString searchStr = QString("cpu%1 ").arg(coreNum);
+    // Offline cores have no line: they read as zero, not as their last counters
+    std::fill(snapshot.cores.begin(), snapshot.cores.end(), CoreStats());
 
-    // Search for the line starting with "cpu0 ", "cpu1 ", etc.
-    while (!stream.atEnd()) {
-        QString line = stream.readLine();
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        // Line format: "cpu[N] user nice system idle iowait irq softirq ..."
+        if (startsWith(p, lineEnd, "cpu", 3)) {
+            const char* q = p + 3;
+            int index = 0;
 
-        if (line.startsWith(searchStr)) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+            if (q < lineEnd && *q >= '0' && *q <= '9') {
+                index = static_cast<int>(parseNumber(q, lineEnd)) + 1;
+            }
 
-            if (parts.size() >= 8) {
-                stats.user = parts[1].toULongLong();
-                stats.nice = parts[2].toULongLong();
-                stats.system = parts[3].toULongLong();
-                stats.idle = parts[4].toULongLong();
-                stats.iowait = parts[5].toULongLong();
-                stats.irq = parts[6].toULongLong();
-                stats.softirq = parts[7].toULongLong();
+            if (index >= snapshot.cores.size()) {
+                // Only happens when more cores appear than we have seen so far
+                snapshot.cores.resize(index + 1);
             }
-            break;
+
+            CoreStats& stats = snapshot.cores[index];
+            stats.user = parseNumber(q, lineEnd);
+            stats.nice = parseNumber(q, lineEnd);
+            stats.system = parseNumber(q, lineEnd);
+            stats.idle = parseNumber(q, lineEnd);
+            stats.iowait = parseNumber(q, lineEnd);
+            stats.irq = parseNumber(q, lineEnd);
+            stats.softirq = parseNumber(q, lineEnd);
+
+            if (index == 0) {
+                foundAggregate = true;
+            }
+        }
+        else if (startsWith(p, lineEnd, "ctxt ", 5)) {
+            const char* q = p + 5;
+            snapshot.ctxt = parseNumber(q, lineEnd);
         }
+        else if (startsWith(p, lineEnd, "procs_running ", 14)) {
+            const char* q = p + 14;
+            snapshot.procsRunning = parseNumber(q, lineEnd);
+        }
+        else if (startsWith(p, lineEnd, "procs_blocked ", 14)) {
+            const char* q = p + 14;
+            snapshot.procsBlocked = parseNumber(q, lineEnd);
+        }
+
+        p = lineEnd + 1;
     }
 
-    file.close();
-    return stats;
+    return foundAggregate;
+}
+
+bool CpuMonitor::parseCpuStats(unsigned long long &total, unsigned long long &idle)
+{
+    if (m_procStat.cores.isEmpty()) {
+        return false;
+    }
+
+    const CoreStats& cpu = m_procStat.cores.first();
+
+    // Calculate total and idle
+    total = cpu.user + cpu.nice + cpu.system + cpu.idle + cpu.iowait + cpu.irq + cpu.softirq;
+    idle = cpu.idle + cpu.iowait;
+
+    return total > 0;
 }
 
 int CpuMonitor::calculateCoreUsage(const CoreStats &prev, const CoreStats &curr)
@@ -259,8 +353,9 @@ int CpuMonitor::calculateCoreUsage(const CoreStats &prev, const CoreStats &curr)
     unsigned long long deltaTotal = currTotal - prevTotal;
     unsigned long long deltaIdle = currIdle - prevIdle;
     
-    // Avoid division by zero
-    if (deltaTotal == 0) {
+    // Avoid division by zero; an offline core reads as zero, so its total
+    // goes backwards
+    if (currTotal <= prevTotal) {
         return 0;
     }
     
@@ -290,3 +385,21 @@ QString CpuMonitor::findTempSensorPath()
     LOG_WARNING("No temperature sensor found");
     return QString();
 }
+
+QString CpuMonitor::findFreqPath()
+{
+    // Try multiple paths for CPU frequency
+    QStringList freqPaths = {
+        "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq",
+        "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq"
+    };
+
+    for (const QString &path : freqPaths) {
+        if (FileReader::fileExists(path)) {
+            return path;
+        }
+    }
+
+    LOG_WARNING("No CPU frequency source found");
+    return QString();
+}
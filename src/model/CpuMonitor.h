@@ -9,8 +9,14 @@
 #define CPUMONITOR_H
 
 #include <QObject>
+#include <QList>
 #include <QVector>
 #include <QVariantList>
+#include <QByteArray>
+#include "FileReader.h"
+#include "RingBuffer.h"
+#include "CompressedSeries.h"
+#include "Constants.h"
 
 /**
  * @class CpuMonitor
@@ -38,6 +44,22 @@ public:
         unsigned long long irq = 0;
         unsigned long long softirq = 0;
     };
+
+    /**
+     * @brief One parsed read of /proc/stat
+     *
+     * cores is a flat array: index 0 holds the aggregate "cpu" line and
+     * index N + 1 holds "cpuN". It is only resized when the set of cores
+     * changes, so re-parsing into the same snapshot does not allocate.
+     * Cores missing from a read (offline) are zero.
+     */
+    struct ProcStatSnapshot {
+        QVector<CoreStats> cores;
+        unsigned long long ctxt = 0;
+        unsigned long long procsRunning = 0;
+        unsigned long long procsBlocked = 0;
+    };
+
     explicit CpuMonitor(QObject *parent = nullptr);
     ~CpuMonitor() override = default;
     
@@ -55,9 +77,9 @@ public:
 
     /**
      * @brief Parse CPU clock frequency
-     * @return Frequency string (e.g., "1.4G")
+     * @return Frequency in Hz, 0 if not available
      */
-    QString parseClock();
+    qint64 parseClock();
 
     /**
      * @brief Parse per-core CPU usage
@@ -65,6 +87,13 @@ public:
      */
     QVariantList parsePerCoreUsage();
 
+    /**
+     * @brief Refresh the per-core baselines without computing usages
+     *
+     * Keeps parsePerCoreUsage() deltas short while no page shows cores.
+     */
+    void updateCoreBaseline();
+
     /**
      * @brief Update temperature history buffer
      * @param temp Current temperature
@@ -73,15 +102,20 @@ public:
 
     /**
      * @brief Get temperature history for charting
-     * @return List of temperature values
+     * @return Temperature samples, oldest first
+     */
+    const RingBuffer<int, App::History::CHART_SAMPLES>& getTempHistory() const { return m_tempHistory; }
+
+    /**
+     * @brief Temperature over the last SERIES_RETENTION_SEC, compressed
      */
-    QVariantList getTempHistory() const;
+    const CompressedSeries& getTempSeries() const { return m_tempSeries; }
 
     /**
      * @brief Parse load average
-     * @return Load average string (1, 5, 15 min)
+     * @return 1, 5 and 15 minute load averages, empty if not available
      */
-    QString parseLoadAverage();
+    QList<qreal> parseLoadAverage();
 
     /**
      * @brief Get number of CPU cores
@@ -89,16 +123,32 @@ public:
      */
     int getCoreCount() const { return m_coreCount; }
 
+    /**
+     * @brief Scheduler counters from the last /proc/stat read
+     */
+    unsigned long long getContextSwitches() const { return m_procStat.ctxt; }
+    unsigned long long getProcsRunning() const { return m_procStat.procsRunning; }
+    unsigned long long getProcsBlocked() const { return m_procStat.procsBlocked; }
+
+    /**
+     * @brief Parse /proc/stat content into a snapshot in a single pass
+     * @param data Raw file content (not required to be NUL-terminated)
+     * @param size Number of bytes in data
+     * @param snapshot Output, reused between calls to avoid allocation
+     * @return true if the aggregate cpu line was found
+     */
+    static bool parseProcStat(const char* data, qsizetype size, ProcStatSnapshot& snapshot);
+
 private:
     /**
-     * @brief Parse CPU stats from /proc/stat
+     * @brief Read /proc/stat once into m_statBuffer and parse m_procStat
      */
-    bool parseCpuStats(unsigned long long& total, unsigned long long& idle);
+    bool readProcStat();
 
     /**
-     * @brief Read statistics for a specific core
+     * @brief Aggregate CPU totals from the current snapshot
      */
-    CoreStats readCoreStats(int coreNum);
+    bool parseCpuStats(unsigned long long& total, unsigned long long& idle);
 
     /**
      * @brief Calculate usage from previous and current stats
@@ -110,6 +160,11 @@ private:
      */
     QString findTempSensorPath();
 
+    /**
+     * @brief Find available CPU frequency path
+     */
+    QString findFreqPath();
+
 private:
     // Previous readings for delta calculation
     unsigned long long m_prevTotal;
@@ -118,16 +173,29 @@ private:
     // Per-core previous statistics
     QVector<CoreStats> m_prevCoreStats;
 
+    // Latest /proc/stat read, shared by parseUsage() and parsePerCoreUsage()
+    ProcFileHandle m_statFile;
+    QByteArray m_statBuffer;
+    ProcStatSnapshot m_procStat;
+    bool m_usagePending;
+    bool m_perCorePending;
+
     // Temperature history for charting
-    QVector<int> m_tempHistory;
+    RingBuffer<int, App::History::CHART_SAMPLES> m_tempHistory;
+    CompressedSeries m_tempSeries;
 
     // Configuration
     int m_coreCount;
     QString m_tempSensorPath;
 
+    // Descriptors kept open between ticks
+    ProcFileHandle m_tempFile;
+    ProcFileHandle m_freqFile;
+    ProcFileHandle m_loadAvgFile;
+
     // Constants
-    static constexpr int MAX_TEMP_HISTORY = 60;
     static constexpr int DEFAULT_CORE_COUNT = 4;
+    static constexpr int STAT_BUFFER_SIZE = 16 * 1024;
 };
 
 #endif // CPUMONITOR_H
\ No newline at end of file
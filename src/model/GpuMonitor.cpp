@@ -5,6 +5,8 @@
  * ============================================
  */
 
+#define LOG_CATEGORY LogCategory::Cpu
+
 #include "GpuMonitor.h"
 #include "FileReader.h"
 #include "Logger.h"
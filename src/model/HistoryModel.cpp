@@ -0,0 +1,193 @@
+/**
+ * ============================================
+ * File: src/model/HistoryModel.cpp
+ * Description: HistoryModel and CoreUsageModel implementation
+ * ============================================
+ */
+
+#include "HistoryModel.h"
+
+// ============================================================================
+// HistoryModel
+// ============================================================================
+
+HistoryModel::HistoryModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_total(0)
+    , m_minimum(0)
+    , m_maximum(0)
+{
+}
+
+int HistoryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_values.size();
+}
+
+QVariant HistoryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_values.size()) {
+        return QVariant();
+    }
+
+    if (role == ValueRole || role == Qt::DisplayRole) {
+        return m_values.at(index.row());
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> HistoryModel::roleNames() const
+{
+    return { { ValueRole, "value" } };
+}
+
+int HistoryModel::valueAt(int row) const
+{
+    if (row < 0 || row >= m_values.size()) {
+        return 0;
+    }
+    return m_values.at(row);
+}
+
+void HistoryModel::append(int value)
+{
+    const int previousCount = m_values.size();
+
+    // Full: the oldest row goes first, so views see a remove + insert
+    if (m_values.isFull()) {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        int dropped;
+        m_values.tryPop(dropped);
+        endRemoveRows();
+    }
+
+    const int row = m_values.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_values.push(value);
+    endInsertRows();
+
+    ++m_total;
+
+    if (m_values.size() != previousCount) {
+        emit countChanged();
+    }
+    updateRange();
+}
+
+void HistoryModel::sync(const QVector<int> &values, quint64 total)
+{
+    if (total == m_total) {
+        return;
+    }
+
+    const quint64 missing = total - m_total;
+
+    if (total < m_total || missing > static_cast<quint64>(values.size())) {
+        // Too far behind (or the producer restarted): rebuild once
+        const int previousCount = m_values.size();
+
+        beginResetModel();
+        m_values.clear();
+        for (int value : values) {
+            m_values.push(value);
+        }
+        endResetModel();
+
+        m_total = total;
+
+        if (m_values.size() != previousCount) {
+            emit countChanged();
+        }
+        updateRange();
+        return;
+    }
+
+    for (int i = values.size() - static_cast<int>(missing); i < values.size(); ++i) {
+        append(values.at(i));
+    }
+    m_total = total;
+}
+
+void HistoryModel::updateRange()
+{
+    int minimum = 0;
+    int maximum = 0;
+
+    if (!m_values.isEmpty()) {
+        minimum = m_values.first();
+        maximum = minimum;
+        for (int value : m_values) {
+            minimum = qMin(minimum, value);
+            maximum = qMax(maximum, value);
+        }
+    }
+
+    if (minimum != m_minimum || maximum != m_maximum) {
+        m_minimum = minimum;
+        m_maximum = maximum;
+        emit rangeChanged();
+    }
+}
+
+// ============================================================================
+// CoreUsageModel
+// ============================================================================
+
+CoreUsageModel::CoreUsageModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int CoreUsageModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_usages.size();
+}
+
+QVariant CoreUsageModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_usages.size()) {
+        return QVariant();
+    }
+
+    if (role == UsageRole || role == Qt::DisplayRole) {
+        return m_usages.at(index.row());
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> CoreUsageModel::roleNames() const
+{
+    return { { UsageRole, "usage" } };
+}
+
+int CoreUsageModel::usageAt(int row) const
+{
+    if (row < 0 || row >= m_usages.size()) {
+        return 0;
+    }
+    return m_usages.at(row);
+}
+
+void CoreUsageModel::setUsages(const QVariantList &usages)
+{
+    if (usages.size() != m_usages.size()) {
+        // Core count changed (first sample, or CPU hotplug)
+        beginResetModel();
+        m_usages.resize(usages.size());
+        for (int i = 0; i < usages.size(); ++i) {
+            m_usages[i] = usages.at(i).toInt();
+        }
+        endResetModel();
+        emit countChanged();
+        return;
+    }
+
+    for (int i = 0; i < usages.size(); ++i) {
+        const int usage = usages.at(i).toInt();
+        if (usage != m_usages.at(i)) {
+            m_usages[i] = usage;
+            const QModelIndex changed = index(i);
+            emit dataChanged(changed, changed, { UsageRole });
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * ============================================
+ * File: src/model/HistoryModel.h
+ * Description: List models feeding charts and per-core bars incrementally
+ * ============================================
+ */
+
+#ifndef HISTORYMODEL_H
+#define HISTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QVariantList>
+#include <QVector>
+#include "RingBuffer.h"
+#include "Constants.h"
+
+/**
+ * @class HistoryModel
+ * @brief One chart series as a list model (row 0 = oldest sample)
+ *
+ * sync() appends only the samples the view has not seen yet, as a
+ * rowsRemoved/rowsInserted pair per sample, instead of replacing the
+ * whole series. QML charts read values through valueAt() and the
+ * precomputed minimum/maximum, so nothing is converted to a JS array.
+ */
+class HistoryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int minimum READ minimum NOTIFY rangeChanged)
+    Q_PROPERTY(int maximum READ maximum NOTIFY rangeChanged)
+
+public:
+    enum Roles {
+        ValueRole = Qt::UserRole + 1
+    };
+
+    explicit HistoryModel(QObject *parent = nullptr);
+    ~HistoryModel() override = default;
+
+    // QAbstractListModel
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_values.size(); }
+    int minimum() const { return m_minimum; }
+    int maximum() const { return m_maximum; }
+
+    /**
+     * @brief Sample at row (0 = oldest), 0 if out of range
+     */
+    Q_INVOKABLE int valueAt(int row) const;
+
+    /**
+     * @brief Append one sample, dropping the oldest when full
+     */
+    void append(int value);
+
+    /**
+     * @brief Bring the model up to date with a producer-side series
+     * @param values Producer's current series, oldest first
+     * @param total Samples the producer has ever pushed
+     *
+     * Only the samples newer than the last sync are appended. If more were
+     * missed than values holds (or the producer restarted), the model is
+     * reset from values instead.
+     */
+    void sync(const QVector<int>& values, quint64 total);
+
+signals:
+    void countChanged();
+    void rangeChanged();
+
+private:
+    void updateRange();
+
+private:
+    RingBuffer<int, App::History::CHART_SAMPLES> m_values;
+    quint64 m_total;
+    int m_minimum;
+    int m_maximum;
+};
+
+/**
+ * @class CoreUsageModel
+ * @brief Per-core CPU usage, one row per core
+ *
+ * setUsages() emits dataChanged only for cores whose value changed; rows
+ * are only inserted or removed if the core count itself changes.
+ */
+class CoreUsageModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        UsageRole = Qt::UserRole + 1
+    };
+
+    explicit CoreUsageModel(QObject *parent = nullptr);
+    ~CoreUsageModel() override = default;
+
+    // QAbstractListModel
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_usages.size(); }
+
+    /**
+     * @brief Usage of one core (0-100), 0 if out of range
+     */
+    Q_INVOKABLE int usageAt(int row) const;
+
+    /**
+     * @brief Apply the latest per-core usages
+     */
+    void setUsages(const QVariantList& usages);
+
+signals:
+    void countChanged();
+
+private:
+    QVector<int> m_usages;
+};
+
+#endif // HISTORYMODEL_H
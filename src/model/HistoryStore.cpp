@@ -0,0 +1,91 @@
+/**
+ * ============================================
+ * File: src/model/HistoryStore.cpp
+ * Description: Persistent metric history implementation
+ * ============================================
+ */
+
+#define LOG_CATEGORY LogCategory::History
+
+#include "HistoryStore.h"
+#include "Constants.h"
+#include "Logger.h"
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+
+namespace {
+
+/**
+ * @brief File and QML name of each HistoryStore::Metric, in enum order
+ */
+const char* const METRIC_NAMES[HistoryStore::MetricCount] = {
+    "cpuUsage",
+    "cpuTemp",
+    "ramUsage",
+    "diskIo",
+    "netUp",
+    "netDown"
+};
+
+} // namespace
+
+HistoryStore::HistoryStore(const QString& directory)
+{
+    if (!QDir().mkpath(directory)) {
+        LOG_WARNING("HistoryStore: cannot create %1, history is not kept", directory);
+        return;
+    }
+
+    const QVector<RrdArchive::Resolution> resolutions = {
+        { App::History::ARCHIVE_FINE_STEP, App::History::ARCHIVE_FINE_ROWS },
+        { App::History::ARCHIVE_MEDIUM_STEP, App::History::ARCHIVE_MEDIUM_ROWS },
+        { App::History::ARCHIVE_COARSE_STEP, App::History::ARCHIVE_COARSE_ROWS }
+    };
+
+    const QDir dir(directory);
+    for (int metric = 0; metric < MetricCount; ++metric) {
+        auto archive = std::make_unique<RrdArchive>(resolutions);
+        if (archive->open(dir.filePath(QString::fromLatin1(METRIC_NAMES[metric]) + ".rrd"))) {
+            m_series[metric].archive = std::move(archive);
+        }
+    }
+
+    LOG_INFO("HistoryStore: archives in %1", directory);
+}
+
+void HistoryStore::append(Metric metric, double value)
+{
+    Series& series = m_series[metric];
+    if (!series.archive) {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    QMutexLocker locker(&series.mutex);
+    series.archive->append(value, now);
+}
+
+QVector<RrdArchive::Point> HistoryStore::read(Metric metric, qint64 rangeSec, int maxPoints) const
+{
+    const Series& series = m_series[metric];
+    if (!series.archive) {
+        return {};
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    QMutexLocker locker(&series.mutex);
+    return series.archive->read(rangeSec, now, maxPoints);
+}
+
+int HistoryStore::metricForName(const QString& name)
+{
+    for (int metric = 0; metric < MetricCount; ++metric) {
+        if (name == QLatin1String(METRIC_NAMES[metric])) {
+            return metric;
+        }
+    }
+    return -1;
+}
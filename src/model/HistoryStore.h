@@ -0,0 +1,72 @@
+/**
+ * ============================================
+ * File: src/model/HistoryStore.h
+ * Description: Persistent long-range metric history (one RrdArchive per metric)
+ * ============================================
+ */
+
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <memory>
+#include "RrdArchive.h"
+
+/**
+ * @class HistoryStore
+ * @brief Long-range history of the charted metrics, kept across restarts
+ *
+ * Each metric has its own archive file in the store directory, with the
+ * resolutions from App::History (1 s x 1 h, 10 s x 24 h, 5 min x 30 d).
+ * MetricsSampler appends from its thread whenever a collector produces a
+ * value; SystemController reads ranges for the charts on the GUI thread.
+ * A mutex per metric keeps the two apart; appends hold it for a few
+ * stores, so the sampler never waits on anything slower than a chart read.
+ */
+class HistoryStore
+{
+public:
+    enum Metric {
+        CpuUsage,       // %
+        CpuTemp,        // °C
+        RamUsage,       // %
+        DiskIo,         // Read + write bytes/s, primary device
+        NetUp,          // Bytes/s
+        NetDown,        // Bytes/s
+        MetricCount
+    };
+
+    /**
+     * @param directory Created if missing; metrics whose file cannot be
+     *        mapped are simply not recorded
+     */
+    explicit HistoryStore(const QString& directory);
+
+    /**
+     * @brief Record one sample at the current wall-clock time
+     */
+    void append(Metric metric, double value);
+
+    /**
+     * @brief Consolidated history of the last rangeSec seconds, oldest first
+     */
+    QVector<RrdArchive::Point> read(Metric metric, qint64 rangeSec, int maxPoints) const;
+
+    /**
+     * @brief Metric for a QML-facing name ("cpuTemp", "netUp", ...), -1 if unknown
+     */
+    static int metricForName(const QString& name);
+
+private:
+    struct Series {
+        std::unique_ptr<RrdArchive> archive;
+        mutable QMutex mutex;
+    };
+
+    std::array<Series, MetricCount> m_series;
+};
+
+#endif // HISTORYSTORE_H
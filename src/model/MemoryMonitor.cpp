@@ -5,218 +5,169 @@
  * ============================================
  */
 
+#define LOG_CATEGORY LogCategory::Memory
+
 #include "MemoryMonitor.h"
 #include "FileReader.h"
 #include "Constants.h"
 #include "Logger.h"
-#include <QDateTime>
-
-MemoryMonitor::MemoryMonitor(QObject *parent)
-    : QObject(parent)
-    , m_lastCacheTime(0)
-{
-    LOG_INFO("MemoryMonitor initialized");
-}
-
-int MemoryMonitor::parseUsage()
-{
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-
-    if (memInfo.isEmpty()) {
-        return 0;
-    }
+#include <cstring>
 
-    unsigned long long total = memInfo.value("MemTotal", 0);
-    unsigned long long available = memInfo.value("MemAvailable", 0);
+namespace {
 
-    // Fallback if MemAvailable not present (older kernels)
-    if (available == 0) {
-         unsigned long long free = memInfo.value("MemFree", 0);
-        unsigned long long buffers = memInfo.value("Buffers", 0);
-        unsigned long long cached = memInfo.value("Cached", 0);
-        available = free + buffers + cached;
-    }
+using MemInfoField = unsigned long long MemoryMonitor::MemInfoSnapshot::*;
 
-    if (total == 0) {
-        return 0;
+/**
+ * @brief FNV-1a hash of a meminfo key
+ */
+constexpr quint32 keyHash(const char* key, size_t length)
+{
+    quint32 hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
     }
-
-    unsigned long long used = total - available;
-    int usage = static_cast<int>((used * 100) / total);
-
-    return qBound(0, usage, 100);
+    return hash;
 }
 
-QString MemoryMonitor::parseUsed()
+constexpr quint32 operator""_key(const char* key, size_t length)
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    
-    unsigned long long total = memInfo.value("MemTotal", 0);
-    unsigned long long available = memInfo.value("MemAvailable", 0);
-
-    if (available == 0) {
-        unsigned long long free = memInfo.value("MemFree", 0);
-        unsigned long long buffers = memInfo.value("Buffers", 0);
-        unsigned long long cached = memInfo.value("Cached", 0);
-        available = free + buffers + cached;
-    }
-
-    unsigned long long used = total - available;
-
-    // meminfo values are in kB, convert to bytes for bytesToMB
-    return bytesToMB(used * 1024);
+    return keyHash(key, length);
 }
 
-QString MemoryMonitor::parseFree()
+/**
+ * @brief Map a meminfo key to its snapshot field, nullptr if unused
+ *
+ * Two keys hashing alike would be duplicate case labels and fail to
+ * compile. The key is still compared once, so an unknown key that
+ * collides with a known one cannot overwrite a field.
+ */
+MemInfoField fieldForKey(const char* key, size_t length)
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    unsigned long long available = memInfo.value("MemAvailable", 0);
-
-     if (available == 0) {
-        unsigned long long free = memInfo.value("MemFree", 0);
-        unsigned long long buffers = memInfo.value("Buffers", 0);
-        unsigned long long cached = memInfo.value("Cached", 0);
-        available = free + buffers + cached;
+    using Snapshot = MemoryMonitor::MemInfoSnapshot;
+
+    const char* name = nullptr;
+    MemInfoField field = nullptr;
+
+    switch (keyHash(key, length)) {
+    case "MemTotal"_key:        name = "MemTotal";        field = &Snapshot::memTotal;       break;
+    case "MemFree"_key:         name = "MemFree";         field = &Snapshot::memFree;        break;
+    case "MemAvailable"_key:    name = "MemAvailable";    field = &Snapshot::memAvailable;   break;
+    case "Buffers"_key:         name = "Buffers";         field = &Snapshot::buffers;        break;
+    case "Cached"_key:          name = "Cached";          field = &Snapshot::cached;         break;
+    case "SwapCached"_key:      name = "SwapCached";      field = &Snapshot::swapCached;     break;
+    case "Active"_key:          name = "Active";          field = &Snapshot::active;         break;
+    case "Inactive"_key:        name = "Inactive";        field = &Snapshot::inactive;       break;
+    case "SwapTotal"_key:       name = "SwapTotal";       field = &Snapshot::swapTotal;      break;
+    case "SwapFree"_key:        name = "SwapFree";        field = &Snapshot::swapFree;       break;
+    case "Dirty"_key:           name = "Dirty";           field = &Snapshot::dirty;          break;
+    case "Writeback"_key:       name = "Writeback";       field = &Snapshot::writeback;      break;
+    case "AnonPages"_key:       name = "AnonPages";       field = &Snapshot::anonPages;      break;
+    case "Mapped"_key:          name = "Mapped";          field = &Snapshot::mapped;         break;
+    case "Shmem"_key:           name = "Shmem";           field = &Snapshot::shmem;          break;
+    case "SReclaimable"_key:    name = "SReclaimable";    field = &Snapshot::sReclaimable;   break;
+    case "SUnreclaim"_key:      name = "SUnreclaim";      field = &Snapshot::sUnreclaim;     break;
+    case "HugePages_Total"_key: name = "HugePages_Total"; field = &Snapshot::hugePagesTotal; break;
+    case "HugePages_Free"_key:  name = "HugePages_Free";  field = &Snapshot::hugePagesFree;  break;
+    case "HugePages_Rsvd"_key:  name = "HugePages_Rsvd";  field = &Snapshot::hugePagesRsvd;  break;
+    case "HugePages_Surp"_key:  name = "HugePages_Surp";  field = &Snapshot::hugePagesSurp;  break;
+    case "Hugepagesize"_key:    name = "Hugepagesize";    field = &Snapshot::hugePageSize;   break;
+    default:
+        return nullptr;
     }
-    
-    return bytesToMB(available * 1024); // meminfo is in kB
+
+    return (strlen(name) == length && memcmp(key, name, length) == 0) ? field : nullptr;
 }
 
-int MemoryMonitor::parseTotal()
+} // namespace
+
+MemoryMonitor::MemoryMonitor(QObject *parent)
+    : QObject(parent)
+    , m_memInfoFile(QString::fromLatin1(App::Path::PROC_MEMINFO))
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    unsigned long long total = memInfo.value("MemTotal", 0);
-    
-    return static_cast<int>(total / 1024); // Convert kB to MB
+    LOG_INFO("MemoryMonitor initialized");
 }
 
-QString MemoryMonitor::parseCache()
+bool MemoryMonitor::update()
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    unsigned long long cached = memInfo.value("Cached", 0);
+    if (!m_memInfoFile.read(m_memInfoBuffer) || m_memInfoBuffer.isEmpty()) {
+        LOG_WARNING("Failed to read /proc/meminfo");
+        m_snapshot = MemInfoSnapshot();
+        return false;
+    }
 
-    return bytesToMB(cached * 1024);
+    return parseMemInfo(m_memInfoBuffer.constData(), m_memInfoBuffer.size(), m_snapshot);
 }
 
-QString MemoryMonitor::parseBuffers()
+bool MemoryMonitor::parseMemInfo(const char *data, qsizetype size, MemInfoSnapshot &snapshot)
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    unsigned long long buffers = memInfo.value("Buffers", 0);
-    
-    return bytesToMB(buffers * 1024);
-}
+    snapshot = MemInfoSnapshot();
 
-unsigned long long MemoryMonitor::getUsedBytes()
-{
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
+    const char* p = data;
+    const char* end = data + size;
 
-    unsigned long long total = memInfo.value("MemTotal", 0);
-    unsigned long long available = memInfo.value("MemAvailable", 0);
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        // Line format: "MemTotal:        3884076 kB"
+        const char* colon = static_cast<const char*>(memchr(p, ':', static_cast<size_t>(lineEnd - p)));
+        if (colon) {
+            MemInfoField field = fieldForKey(p, static_cast<size_t>(colon - p));
+            if (field) {
+                const char* v = colon + 1;
+                while (v < lineEnd && *v == ' ') {
+                    ++v;
+                }
+
+                unsigned long long value = 0;
+                while (v < lineEnd && *v >= '0' && *v <= '9') {
+                    value = value * 10 + static_cast<unsigned long long>(*v - '0');
+                    ++v;
+                }
+                snapshot.*field = value;
+            }
+        }
 
-    if (available == 0) {
-        unsigned long long free = memInfo.value("MemFree", 0);
-        unsigned long long buffers = memInfo.value("Buffers", 0);
-        unsigned long long cached = memInfo.value("Cached", 0);
-        available = free + buffers + cached;
+        p = lineEnd + 1;
     }
 
-    return (total - available) * 1024; // Convert kB to bytes
+    return snapshot.memTotal > 0;
 }
 
-unsigned long long MemoryMonitor::getFreeBytes()
+int MemoryMonitor::parseUsage()
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    unsigned long long available = memInfo.value("MemAvailable", 0);
-    
-    if (available == 0) {
-        unsigned long long free = memInfo.value("MemFree", 0);
-        unsigned long long buffers = memInfo.value("Buffers", 0);
-        unsigned long long cached = memInfo.value("Cached", 0);
-        available = free + buffers + cached;
+    if (m_snapshot.memTotal == 0) {
+        return 0;
     }
-    
-    return available * 1024;
-}
 
-unsigned long long MemoryMonitor::getTotalBytes()
-{
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    return memInfo.value("MemTotal", 0) * 1024;
+    int usage = static_cast<int>((m_snapshot.usedKb() * 100) / m_snapshot.memTotal);
+
+    return qBound(0, usage, 100);
 }
 
-unsigned long long MemoryMonitor::getCachedBytes()
+unsigned long long MemoryMonitor::getUsedBytes() const
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    return memInfo.value("Cached", 0) * 1024;
+    return m_snapshot.usedKb() * 1024; // Convert kB to bytes
 }
 
-unsigned long long MemoryMonitor::getBuffersBytes()
+unsigned long long MemoryMonitor::getFreeBytes() const
 {
-    QMap<QString, unsigned long long> memInfo = parseMemInfo();
-    return memInfo.value("Buffers", 0) * 1024;
+    return m_snapshot.availableKb() * 1024;
 }
 
-QMap<QString, unsigned long long> MemoryMonitor::parseMemInfo()
+unsigned long long MemoryMonitor::getTotalBytes() const
 {
-    // Check cache validity
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    if (!m_cachedMemInfo.isEmpty() && (currentTime - m_lastCacheTime) < CACHE_VALIDITY_MS) {
-        return m_cachedMemInfo;
-    }
-
-    m_cachedMemInfo.clear();
-
-    QString content = FileReader::readAll(App::Path::PROC_MEMINFO);
-    if (content.isEmpty()) {
-        LOG_WARNING("Failed to read /proc/meminfo");
-        return m_cachedMemInfo;
-    }
-
-    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
-    
-    for (const QString& line: lines) {
-        int colonPos = line.indexOf(':');
-        if (colonPos <= 0) {
-            continue;
-        }
-
-        QString key = line.left(colonPos).trimmed();
-        QString valueStr = line.mid(colonPos + 1).trimmed();
-
-        // Remove " kB" suffix
-        valueStr = valueStr.remove(" kB").trimmed();
-
-        bool ok;
-        unsigned long long value = valueStr.toULongLong(&ok);
-
-        if (ok) {
-            m_cachedMemInfo[key] = value;
-        }
-    }
-    
-    m_lastCacheTime = currentTime;
-    return m_cachedMemInfo;
+    return m_snapshot.memTotal * 1024;
 }
 
-QString MemoryMonitor::bytesToMB(unsigned long long bytes)
+unsigned long long MemoryMonitor::getCachedBytes() const
 {
-    double mb = bytes / (1024.0 * 1024.0);
-    return QString::number(static_cast<int>(mb)) + "M";
+    return m_snapshot.cached * 1024;
 }
 
-QString MemoryMonitor::bytesToHuman(unsigned long long bytes)
+unsigned long long MemoryMonitor::getBuffersBytes() const
 {
-    const char* units[] = {"B", "K", "M", "G", "T"};
-    int unitIndex = 0;
-    double size = static_cast<double>(bytes);
-
-    while (size >= 1024.0 && unitIndex < 4)  {
-        size /= 1024.0;
-        unitIndex++;
-    }
-
-    if (unitIndex == 0) {
-        return QString::number(static_cast<int>(size)) + units[unitIndex];
-    }
-    return QString::number(size, 'f', 1) + units[unitIndex];
+    return m_snapshot.buffers * 1024;
 }
@@ -10,90 +10,112 @@
 
 #include <QObject>
 #include <QString>
-#include <QMap>
+#include <QByteArray>
+#include "FileReader.h"
 
 /**
  * @class MemoryMonitor
  * @brief Monitors RAM usage, swap, and cache statistics
  * 
- * Read data from /proc/meminfo
+ * Read data from /proc/meminfo. update() parses the file once into a
+ * MemInfoSnapshot and every getter reads from that snapshot.
  */
 class MemoryMonitor : public QObject 
 {
     Q_OBJECT
 
 public:
-    explicit MemoryMonitor(QObject *parent = nullptr);
-    ~MemoryMonitor() override = default;
-
-    /**
-     * @brief Parse RAM usage percentage
-     * @return Usage percentage (0-100)
-     */
-    int parseUsage();
-
-    /**
-     * @brief Parse used RAM
-     * @return Used RAM string (e.g., "512M")
-     */
-    QString parseUsed();
-
     /**
-     * @brief Parse free/available RAM
-     * @return Free RAM string (e.g., "256M")
+     * @brief Fixed-layout copy of the /proc/meminfo keys we use
+     *
+     * Values are in kB as reported by the kernel, except the HugePages_*
+     * counts which are page counts. Keys missing on older kernels stay 0.
      */
-    QString parseFree();
+    struct MemInfoSnapshot {
+        unsigned long long memTotal = 0;
+        unsigned long long memFree = 0;
+        unsigned long long memAvailable = 0;
+        unsigned long long buffers = 0;
+        unsigned long long cached = 0;
+        unsigned long long swapCached = 0;
+        unsigned long long active = 0;
+        unsigned long long inactive = 0;
+        unsigned long long swapTotal = 0;
+        unsigned long long swapFree = 0;
+        unsigned long long dirty = 0;
+        unsigned long long writeback = 0;
+        unsigned long long anonPages = 0;
+        unsigned long long mapped = 0;
+        unsigned long long shmem = 0;
+        unsigned long long sReclaimable = 0;
+        unsigned long long sUnreclaim = 0;
+        unsigned long long hugePagesTotal = 0;
+        unsigned long long hugePagesFree = 0;
+        unsigned long long hugePagesRsvd = 0;
+        unsigned long long hugePagesSurp = 0;
+        unsigned long long hugePageSize = 0;
+
+        /**
+         * @brief Available memory, estimated on kernels without MemAvailable
+         */
+        unsigned long long availableKb() const
+        {
+            return memAvailable != 0 ? memAvailable : memFree + buffers + cached;
+        }
+
+        unsigned long long usedKb() const
+        {
+            unsigned long long available = availableKb();
+            return memTotal > available ? memTotal - available : 0;
+        }
+    };
 
-    /**
-     * @brief Parse total RAM in MB
-     * @return Total RAM in MB
-     */
-    int parseTotal();
-
-    /**
-     * @brief Parse cached memory
-     * @return Cached memory string (e.g., "128M")
-     */
-    QString parseCache();
+    explicit MemoryMonitor(QObject *parent = nullptr);
+    ~MemoryMonitor() override = default;
 
     /**
-     * @brief Parse buffer memory
-     * @return Buffers memory string
+     * @brief Re-read /proc/meminfo into the snapshot (once per tick)
+     * @return false if the file could not be read
      */
-    QString parseBuffers();
+    bool update();
 
     /**
-     * @brief Get raw memory values, for detailed display
+     * @brief Snapshot filled by the last update()
      */
-    unsigned long long getUsedBytes();
-    unsigned long long getFreeBytes();
-    unsigned long long getTotalBytes();
-    unsigned long long getCachedBytes();
-    unsigned long long getBuffersBytes();
+    const MemInfoSnapshot& snapshot() const { return m_snapshot; }
 
-private:
     /**
-     * @brief Parse /proc/meminfo into key-value map
-     * @return Map of memory metrics (values in kB)
+     * @brief Parse /proc/meminfo content into a snapshot
+     *
+     * Single pass over the bytes; keys are matched through a switch on a
+     * compile-time hash, so parsing does not allocate.
+     *
+     * @return true if MemTotal was found
      */
-    QMap<QString, unsigned long long> parseMemInfo();
+    static bool parseMemInfo(const char* data, qsizetype size, MemInfoSnapshot& snapshot);
 
     /**
-     * @brief Convert bytes to human-readable MB string
+     * @brief Parse RAM usage percentage
+     * @return Usage percentage (0-100)
      */
-    QString bytesToMB(unsigned long long bytes);
+    int parseUsage();
 
     /**
-     * @brief Covert bytes to human-readable string with auto unit
+     * @brief Memory figures in bytes; formatting is left to the view
      */
-    QString bytesToHuman(unsigned long long bytes);
+    unsigned long long getUsedBytes() const;
+    unsigned long long getFreeBytes() const;
+    unsigned long long getTotalBytes() const;
+    unsigned long long getCachedBytes() const;
+    unsigned long long getBuffersBytes() const;
 
 private:
-    // Cached meminfo for mutiple queries in same update cycle
-    QMap<QString, unsigned long long> m_cachedMemInfo;
-    qint64 m_lastCacheTime;
+    // Latest meminfo, shared by every getter in the same update cycle
+    MemInfoSnapshot m_snapshot;
 
-    static constexpr int CACHE_VALIDITY_MS = 100; // Cache valid for 100ms
+    // /proc/meminfo kept open and re-read with pread()
+    ProcFileHandle m_memInfoFile;
+    QByteArray m_memInfoBuffer;
 };
 
 #endif // MEMORYMONITOR_H
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * ============================================================================
+ * File: src/model/MetricsSnapshot.cpp
+ * Description: Snapshot diff producing MetricField change masks
+ * ============================================================================
+ */
+
+#include "MetricsSnapshot.h"
+
+quint64 diffSnapshots(const MetricsSnapshot& before, const MetricsSnapshot& after)
+{
+    quint64 changed = 0;
+
+    auto mark = [&changed](bool differs, quint64 field) {
+        if (differs) {
+            changed |= field;
+        }
+    };
+
+    // ==================== CPU ====================
+    mark(before.cpuUsage != after.cpuUsage, MetricField::CpuUsage);
+    mark(before.cpuTemp != after.cpuTemp, MetricField::CpuTemp);
+    mark(before.cpuClock != after.cpuClock, MetricField::CpuClock);
+    mark(before.coreUsages != after.coreUsages, MetricField::CoreUsages);
+    mark(before.tempHistory.total != after.tempHistory.total, MetricField::TempHistory);
+    mark(before.loadAverage != after.loadAverage, MetricField::LoadAverage);
+
+    // ==================== GPU ====================
+    mark(before.gpuUsage != after.gpuUsage, MetricField::GpuUsage);
+    mark(before.gpuTemp != after.gpuTemp, MetricField::GpuTemp);
+    mark(before.gpuMemUsage != after.gpuMemUsage, MetricField::GpuMemUsage);
+
+    // ==================== RAM ====================
+    mark(before.ramUsage != after.ramUsage, MetricField::RamUsage);
+    mark(before.ramUsed != after.ramUsed, MetricField::RamUsed);
+    mark(before.ramFree != after.ramFree, MetricField::RamFree);
+    mark(before.ramCache != after.ramCache, MetricField::RamCache);
+    mark(before.ramTotal != after.ramTotal, MetricField::RamTotal);
+
+    // ==================== Storage ====================
+    mark(before.hddUsage != after.hddUsage, MetricField::HddUsage);
+    mark(before.hddTemp != after.hddTemp, MetricField::HddTemp);
+    mark(before.hddTotal != after.hddTotal, MetricField::HddTotal);
+    mark(before.hddUsed != after.hddUsed, MetricField::HddUsed);
+    mark(before.hddFree != after.hddFree, MetricField::HddFree);
+    mark(before.swapUsage != after.swapUsage, MetricField::SwapUsage);
+    mark(before.swapTotal != after.swapTotal, MetricField::SwapTotal);
+    mark(before.swapUsed != after.swapUsed, MetricField::SwapUsed);
+    mark(before.swapFree != after.swapFree, MetricField::SwapFree);
+    mark(before.ioRead != after.ioRead, MetricField::IoRead);
+    mark(before.ioWrite != after.ioWrite, MetricField::IoWrite);
+    mark(before.ioHistory.total != after.ioHistory.total, MetricField::IoHistory);
+    mark(before.diskDevices != after.diskDevices, MetricField::DiskDevices);
+
+    // ==================== Network ====================
+    mark(before.networkInterface != after.networkInterface, MetricField::NetworkInterface);
+    mark(before.ipAddress != after.ipAddress, MetricField::IpAddress);
+    mark(before.macAddress != after.macAddress, MetricField::MacAddress);
+    mark(before.netUpSpeed != after.netUpSpeed, MetricField::NetUpSpeed);
+    mark(before.netDownSpeed != after.netDownSpeed, MetricField::NetDownSpeed);
+    mark(before.packetRate != after.packetRate, MetricField::PacketRate);
+    mark(before.activeConnections != after.activeConnections, MetricField::ActiveConnections);
+    mark(before.netUpHistory.total != after.netUpHistory.total, MetricField::NetUpHistory);
+    mark(before.netDownHistory.total != after.netDownHistory.total, MetricField::NetDownHistory);
+
+    // ==================== Processes ====================
+    mark(before.topCpuProcesses != after.topCpuProcesses
+         || before.topMemoryProcesses != after.topMemoryProcesses
+         || before.processCount != after.processCount
+         || before.forkRate != after.forkRate
+         || before.execRate != after.execRate
+         || before.exitRate != after.exitRate
+         || before.processEvents != after.processEvents, MetricField::Processes);
+
+    return changed;
+}
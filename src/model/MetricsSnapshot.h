@@ -0,0 +1,187 @@
+/**
+ * ============================================================================
+ * File: src/model/MetricsSnapshot.h
+ * Description: Immutable set of metrics produced by one sampler pass
+ * ============================================================================
+ */
+
+#ifndef METRICSSNAPSHOT_H
+#define METRICSSNAPSHOT_H
+
+#include <QList>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+#include "CompressedSeries.h"
+
+/**
+ * @struct HistorySeries
+ * @brief A chart series plus how many samples were ever produced
+ *
+ * total lets the GUI side append only what it has not seen yet.
+ */
+struct HistorySeries
+{
+    QVector<int> values;    // Oldest first
+    quint64 total = 0;
+};
+
+/**
+ * @brief One bit per snapshot field, used for change masks
+ *
+ * Uptime and SystemTime are filled in by SystemController, not the sampler.
+ */
+namespace MetricField {
+enum : quint64 {
+    // CPU
+    CpuUsage          = 1ULL << 0,
+    CpuTemp           = 1ULL << 1,
+    CpuClock          = 1ULL << 2,
+    CoreUsages        = 1ULL << 3,
+    TempHistory       = 1ULL << 4,
+    LoadAverage       = 1ULL << 5,
+
+    // GPU
+    GpuUsage          = 1ULL << 6,
+    GpuTemp           = 1ULL << 7,
+    GpuMemUsage       = 1ULL << 8,
+
+    // RAM
+    RamUsage          = 1ULL << 9,
+    RamUsed           = 1ULL << 10,
+    RamFree           = 1ULL << 11,
+    RamCache          = 1ULL << 12,
+    RamTotal          = 1ULL << 13,
+
+    // Storage
+    HddUsage          = 1ULL << 14,
+    HddTemp           = 1ULL << 15,
+    HddTotal          = 1ULL << 16,
+    HddUsed           = 1ULL << 17,
+    HddFree           = 1ULL << 18,
+    SwapUsage         = 1ULL << 19,
+    SwapTotal         = 1ULL << 20,
+    SwapUsed          = 1ULL << 21,
+    SwapFree          = 1ULL << 22,
+    IoRead            = 1ULL << 23,
+    IoWrite           = 1ULL << 24,
+    IoHistory         = 1ULL << 25,
+    DiskDevices       = 1ULL << 26,
+
+    // Network
+    NetworkInterface  = 1ULL << 27,
+    IpAddress         = 1ULL << 28,
+    MacAddress        = 1ULL << 29,
+    NetUpSpeed        = 1ULL << 30,
+    NetDownSpeed      = 1ULL << 31,
+    PacketRate        = 1ULL << 32,
+    ActiveConnections = 1ULL << 33,
+    NetUpHistory      = 1ULL << 34,
+    NetDownHistory    = 1ULL << 35,
+
+    // Processes (top lists, count and lifecycle rates)
+    Processes         = 1ULL << 36,
+
+    // System (controller side)
+    Uptime            = 1ULL << 37,
+    SystemTime        = 1ULL << 38,
+
+    All               = (1ULL << 39) - 1
+};
+}
+
+/**
+ * @struct MetricsSnapshot
+ * @brief Everything the UI shows, as collected on the sampler thread
+ *
+ * Built by MetricsSampler, whose collectors each refresh their own fields
+ * at their own rate, and published as a shared_ptr<const> after every
+ * scheduler wakeup, so once a snapshot is handed to the GUI thread nobody
+ * writes to it again.
+ *
+ * Metrics are raw numbers in base units (bytes, bytes/s, Hz, °C, %);
+ * turning them into text is the view's job (see UnitFormatter). Only
+ * identifiers such as the interface name stay strings.
+ *
+ * The *Series fields are the monitors' 24 h compressed histories. They
+ * share sealed blocks with the monitor, so a copy costs a reference count
+ * plus the block still being filled. They have no MetricField bit: the
+ * GUI reads them on demand (SystemController::archivedHistory).
+ */
+struct MetricsSnapshot
+{
+    // ==================== CPU ====================
+    int cpuUsage = 0;               // %
+    int cpuTemp = 0;                // °C
+    qint64 cpuClock = 0;            // Hz, 0 = unknown
+    QVariantList coreUsages;
+    HistorySeries tempHistory;
+    CompressedSeries tempSeries;
+    QList<qreal> loadAverage;       // 1, 5, 15 min; empty = unknown
+
+    // ==================== GPU ====================
+    int gpuUsage = 0;               // %
+    int gpuTemp = 0;                // °C
+    qint64 gpuMemUsage = -1;        // Bytes, -1 = unknown
+
+    // ==================== RAM (bytes) ====================
+    int ramUsage = 0;               // %
+    qint64 ramUsed = 0;
+    qint64 ramFree = 0;
+    qint64 ramCache = 0;
+    qint64 ramTotal = 0;
+
+    // ==================== Storage (bytes, bytes/s) ====================
+    int hddUsage = 0;               // %
+    int hddTemp = 0;                // °C
+    qint64 hddTotal = 0;
+    qint64 hddUsed = 0;
+    qint64 hddFree = 0;
+    int swapUsage = 0;              // %
+    qint64 swapTotal = 0;
+    qint64 swapUsed = 0;
+    qint64 swapFree = 0;
+    double ioRead = 0.0;
+    double ioWrite = 0.0;
+    HistorySeries ioHistory;
+    CompressedSeries ioSeries;      // Read + write
+    QVariantList diskDevices;   // Per-device maps, see StorageMonitor::getDeviceStats()
+
+    // ==================== Network ====================
+    QString networkInterface = QStringLiteral("N/A");
+    QString ipAddress = QStringLiteral("N/A");
+    QString macAddress = QStringLiteral("N/A");
+    double netUpSpeed = 0.0;        // Bytes/s
+    double netDownSpeed = 0.0;      // Bytes/s
+    double packetRate = 0.0;        // Packets/s, rx + tx
+    int activeConnections = 0;
+    HistorySeries netUpHistory;
+    HistorySeries netDownHistory;
+    CompressedSeries netUpSeries;
+    CompressedSeries netDownSeries;
+
+    // ==================== Processes ====================
+    QVariantList topCpuProcesses;       // See ProcessMonitor::getTopByCpu()
+    QVariantList topMemoryProcesses;
+    int processCount = 0;
+    double forkRate = 0.0;          // Processes/s, see ProcessMonitor
+    double execRate = 0.0;
+    double exitRate = 0.0;
+    bool processEvents = false;     // Rates come from proc connector events
+
+    // Monotonically increasing publish number, 0 = never sampled
+    quint64 sequence = 0;
+
+    // MetricField bits that differ from snapshot sequence - 1
+    quint64 changed = MetricField::All;
+};
+
+/**
+ * @brief MetricField bits whose values differ between two snapshots
+ *
+ * sequence and changed themselves are not compared. Histories compare by
+ * their total sample count only.
+ */
+quint64 diffSnapshots(const MetricsSnapshot& before, const MetricsSnapshot& after);
+
+#endif // METRICSSNAPSHOT_H
@@ -5,47 +5,267 @@
  * ============================================
  */
 
+#define LOG_CATEGORY LogCategory::Network
+
 #include "NetworkMonitor.h"
 #include "FileReader.h"
 #include "Constants.h"
 #include "Logger.h"
-#include <QFile>
-#include <QTextStream>
-#include <QProcess>
 #include <QDateTime>
+#include <QSocketNotifier>
+#include <cstring>
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <linux/if.h>
+#include <linux/inet_diag.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace {
+
+/**
+ * @brief Preferred interfaces, highest priority first
+ */
+QStringList interfaceCandidates()
+{
+#ifdef PLATFORM_RASPBERRY_PI
+    // Raspberry Pi: eth0 > wlan0
+    return {"eth0", "wlan0"};
+#else
+    return {"enp0s3", "enp0s8", "enp3s0", "ens33", "ens160",
+            "wlp2s0", "wlp3s0", "wlan0", "eth0"};
+#endif
+}
+
+QString defaultInterface()
+{
+#ifdef PLATFORM_RASPBERRY_PI
+    return "eth0"; // Default fallback for Pi
+#else
+    return "enp0s3"; // Default fallback for Ubuntu
+#endif
+}
+
+/**
+ * @brief Apply one RTM_NEWLINK/RTM_DELLINK message to the link table
+ */
+void applyLinkMessage(const nlmsghdr* msg, QHash<QString, NetworkMonitor::LinkState>& links)
+{
+    const ifinfomsg* ifi = static_cast<const ifinfomsg*>(NLMSG_DATA(msg));
+    int length = static_cast<int>(IFLA_PAYLOAD(msg));
+
+    QString name;
+    QString mac;
+
+    for (const rtattr* rta = IFLA_RTA(ifi); RTA_OK(rta, length); rta = RTA_NEXT(rta, length)) {
+        if (rta->rta_type == IFLA_IFNAME) {
+            name = QString::fromLatin1(static_cast<const char*>(RTA_DATA(rta)));
+        }
+        else if (rta->rta_type == IFLA_ADDRESS) {
+            QByteArray bytes(static_cast<const char*>(RTA_DATA(rta)), static_cast<int>(RTA_PAYLOAD(rta)));
+            mac = QString::fromLatin1(bytes.toHex(':').toUpper());
+        }
+    }
+
+    if (name.isEmpty()) {
+        return;
+    }
+
+    if (msg->nlmsg_type == RTM_DELLINK) {
+        links.remove(name);
+        return;
+    }
+
+    NetworkMonitor::LinkState& link = links[name];
+    link.index = ifi->ifi_index;
+    link.up = (ifi->ifi_flags & IFF_UP) != 0;
+    link.carrier = (ifi->ifi_flags & IFF_LOWER_UP) != 0;
+    link.loopback = (ifi->ifi_flags & IFF_LOOPBACK) != 0;
+    if (!mac.isEmpty()) {
+        link.mac = mac;
+    }
+}
+
+/**
+ * @brief Value of one hex digit, -1 if c is not one
+ */
+int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief TCP state of one /proc/net/tcp line, -1 for the header
+ *
+ * Line format: "  sl  local_address rem_address   st tx_queue ..."
+ */
+int tcpLineState(QByteArrayView line)
+{
+    const char* p = line.data();
+    const char* end = p + line.size();
+
+    // Skip "sl", local and remote address
+    for (int field = 0; field < 3; ++field) {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+        while (p < end && *p != ' ') {
+            ++p;
+        }
+    }
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+
+    if (end - p < 2) {
+        return -1;
+    }
+
+    int high = hexDigit(p[0]);
+    int low = hexDigit(p[1]);
+    if (high < 0 || low < 0) {
+        return -1;
+    }
+    return high * 16 + low;
+}
+
+} // namespace
 
 NetworkMonitor::NetworkMonitor(QObject *parent)
     : QObject(parent)
     , m_interface("")
     , m_ipAddress("N/A")
+    , m_ipv6Address("N/A")
     , m_macAddress("N/A")
-    , m_upSpeed("0 B/s")
-    , m_downSpeed("0 B/s")
-    , m_packetRate("0 pps")
+    , m_eventNotifier(nullptr)
+    , m_tcpFile(QString::fromLatin1(App::Path::PROC_NET_TCP))
+    , m_tcp6File(QString::fromLatin1(App::Path::PROC_NET_TCP6))
+    , m_upSpeed(0.0)
+    , m_downSpeed(0.0)
+    , m_packetRate(0.0)
     , m_activeConnections(0)
     , m_prevTimestamp(0)
+    , m_upSeries(App::History::SERIES_RETENTION_SEC, App::History::SERIES_RATE_QUANTUM)
+    , m_downSeries(App::History::SERIES_RETENTION_SEC, App::History::SERIES_RATE_QUANTUM)
+    , m_netDevFile(QString::fromLatin1(App::Path::PROC_NET_DEV))
 {
-    m_upHistory.reserve(MAX_HISTORY);
-    m_downHistory.reserve(MAX_HISTORY);
+    if (!startLinkTracking()) {
+        LOG_WARNING("NetworkMonitor: rtnetlink unavailable, polling interface state");
+        pollInterfaceState();
+    }
 
-    // Detect active interface
-    m_interface = detectInterface();
+    if (!m_diagSocket.open(NETLINK_SOCK_DIAG)) {
+        LOG_WARNING("NetworkMonitor: sock_diag unavailable, counting connections from /proc/net/tcp");
+    }
     
-    LOG_INFO(QString("NetworkMonitor initialized - interface: %1").arg(m_interface));
+    LOG_INFO("NetworkMonitor initialized - interface: %1", m_interface);
+}
+
+bool NetworkMonitor::startLinkTracking()
+{
+    if (!m_routeSocket.open(NETLINK_ROUTE)) {
+        return false;
+    }
+
+    // Subscribe before dumping, so a change racing with the dump is
+    // still delivered as a notification afterwards
+    if (!m_events.open(NETLINK_ROUTE, RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR, true)) {
+        return false;
+    }
+
+    if (!refreshLinks()) {
+        m_events.close();
+        return false;
+    }
+    refreshAddresses();
+    applyInterfaceState();
+
+    m_eventNotifier = new QSocketNotifier(m_events.fd(), QSocketNotifier::Read, this);
+    connect(m_eventNotifier, &QSocketNotifier::activated, this, &NetworkMonitor::onNetlinkEvent);
+
+    return true;
+}
+
+void NetworkMonitor::onNetlinkEvent()
+{
+    bool linksChanged = false;
+    bool addressesChanged = false;
+
+    int handled = m_events.drain([&](const nlmsghdr* msg) {
+        switch (msg->nlmsg_type) {
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+            applyLinkMessage(msg, m_links);
+            linksChanged = true;
+            break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+            addressesChanged = true;
+            break;
+        default:
+            break;
+        }
+    });
+
+    if (handled < 0) {
+        // Receive queue overflowed (ENOBUFS) and notifications were lost:
+        // resync everything from full dumps
+        LOG_WARNING("NetworkMonitor: netlink notifications lost, resyncing");
+        linksChanged = refreshLinks();
+        addressesChanged = true;
+    }
+
+    if (addressesChanged) {
+        refreshAddresses();
+    }
+
+    if ((linksChanged || addressesChanged) && applyInterfaceState()) {
+        emit linkStateChanged();
+    }
 }
 
 void NetworkMonitor::update()
 {
-     // Re-detect interface if needed
-    if (m_interface.isEmpty()) {
-        m_interface = detectInterface();
+    // Without notifications, the slow-changing state has to be polled
+    if (!m_eventNotifier) {
+        pollInterfaceState();
     }
 
-    // Update IP and MAC addresses
-    m_ipAddress = parseIpAddress(m_interface);
-    m_macAddress = parseMacAddress(m_interface);
+    if (!measureRates()) {
+        return;
+    }
+
+    // Add to history (convert to KB/s for chart)
+    int upKBs = static_cast<int>(m_upSpeed / 1024.0);
+    int downKBs = static_cast<int>(m_downSpeed / 1024.0);
+    
+    m_upHistory.push(upKBs);
+    m_downHistory.push(downKBs);
+}
+
+bool NetworkMonitor::updateBaseline()
+{
+    if (!m_eventNotifier) {
+        pollInterfaceState();
+    }
 
-    // Update trafiic statistics
+    return measureRates();
+}
+
+bool NetworkMonitor::measureRates()
+{
     NetStats currentStats = parseNetStats(m_interface);
     qint64 currentTimestamp = QDateTime::currentMSecsSinceEpoch();
 
@@ -53,10 +273,10 @@ void NetworkMonitor::update()
     if (m_prevTimestamp == 0) {
         m_prevStats = currentStats;
         m_prevTimestamp = currentTimestamp;
-        m_upSpeed = "0 B/s";
-        m_downSpeed = "0 B/s";
-        m_packetRate = "0 pps";
-        return;
+        m_upSpeed = 0.0;
+        m_downSpeed = 0.0;
+        m_packetRate = 0.0;
+        return false;
     }
 
     // Calculate deltas
@@ -67,57 +287,30 @@ void NetworkMonitor::update()
     unsigned long long deltaTxPackets = currentStats.txPackets - m_prevStats.txPackets;
     
     // Calculate rates
-    double downRate = calculateRate(deltaRxBytes, deltaMs);
-    double upRate = calculateRate(deltaTxBytes, deltaMs);
+    m_downSpeed = calculateRate(deltaRxBytes, deltaMs);
+    m_upSpeed = calculateRate(deltaTxBytes, deltaMs);
 
-    // Format speeds
-    m_downSpeed = formatRate(downRate);
-    m_upSpeed = formatRate(upRate);
-
-     // Calculate packet rate (packets per second)
-    if (deltaMs > 0) {
-        unsigned long long totalPackets = deltaRxPackets + deltaTxPackets;
-        double pps = (totalPackets * 1000.0) / deltaMs;
-        m_packetRate = QString::number(static_cast<int>(pps)) + " pps";
-    }
-    
-    // Add to history (convert to KB/s for chart)
-    int upKBs = static_cast<int>(upRate / 1024.0);
-    int downKBs = static_cast<int>(downRate / 1024.0);
-    
-    m_upHistory.append(upKBs);
-    m_downHistory.append(downKBs);
-    
-    // Keep only last MAX_HISTORY values
-    while (m_upHistory.size() > MAX_HISTORY) {
-        m_upHistory.removeFirst();
-    }
-    while (m_downHistory.size() > MAX_HISTORY) {
-        m_downHistory.removeFirst();
-    }
+    // Packet rate uses the same formula, on packets instead of bytes
+    m_packetRate = calculateRate(deltaRxPackets + deltaTxPackets, deltaMs);
     
     // Update previous values
     m_prevStats = currentStats;
     m_prevTimestamp = currentTimestamp;
-    
-    // Update active connections
+
+    m_upSeries.append(currentTimestamp / 1000, m_upSpeed);
+    m_downSeries.append(currentTimestamp / 1000, m_downSpeed);
+    return true;
+}
+
+void NetworkMonitor::updateConnections()
+{
     m_activeConnections = parseActiveConnections();
 }
 
 QString NetworkMonitor::detectInterface()
 {
-    QStringList candidates;
-
-#ifdef PLATFORM_RASPBERRY_PI
-    // Raspberry Pi: eth0 > wlan0
-    candidates = {"eth0", "wlan0"};
-#else
-    candidates = {"enp0s3", "enp0s8", "enp3s0", "ens33", "ens160",
-                  "wlp2s0", "wlp3s0", "wlan0", "eth0"};
-#endif
-
     // Try priority list first
-    for (const QString &iface: candidates) {
+    for (const QString &iface: interfaceCandidates()) {
         QString macPath = QString("/sys/class/net/%1/address").arg(iface);
         if (FileReader::fileExists(macPath)) {
             // Check if interface has carrier (is up)
@@ -148,44 +341,259 @@ QString NetworkMonitor::detectInterface()
 
     LOG_WARNING("No network interface detected");    
     
-#ifdef PLATFORM_RASPBERRY_PI
-    return "eth0"; // Default fallback for Pi
-#else
-    return "enp0s3"; // Default fallback for Ubuntu
-#endif
+    return defaultInterface();
 }
 
-QString NetworkMonitor::parseIpAddress(const QString &interface)
+QString NetworkMonitor::selectInterface() const
 {
-    if (interface.isEmpty()) {
-        return "N/A";
+    // Priority list first, as long as the link is up with carrier
+    for (const QString &iface: interfaceCandidates()) {
+        auto it = m_links.constFind(iface);
+        if (it != m_links.cend() && it->up && it->carrier) {
+            return iface;
+        }
     }
 
-    // Use 'ip addr show' command
-    QProcess process;
-    process.start("ip", {"addr", "show", interface});
+    // Otherwise any non-loopback link, preferring one with carrier, then
+    // the lowest index so the choice is stable
+    QString best;
+    const LinkState* bestLink = nullptr;
 
-    if (!process.waitForFinished(1000)) {
-        return "N/A";
+    for (auto it = m_links.cbegin(); it != m_links.cend(); ++it) {
+        if (it->loopback) {
+            continue;
+        }
+        if (!bestLink
+            || (it->carrier && !bestLink->carrier)
+            || (it->carrier == bestLink->carrier && it->index < bestLink->index)) {
+            best = it.key();
+            bestLink = &it.value();
+        }
+    }
+
+    if (!best.isEmpty()) {
+        return best;
+    }
+
+    LOG_WARNING("No network interface detected");
+    return defaultInterface();
+}
+
+void NetworkMonitor::pollInterfaceState()
+{
+     // Re-detect interface if needed
+    if (m_interface.isEmpty()) {
+        m_interface = detectInterface();
+    }
+
+    // No notifications to tell when addresses change, so re-dump each time;
+    // without rtnetlink at all, ask getifaddrs() instead
+    if (!refreshAddresses()) {
+        readInterfaceAddresses();
+    }
+
+    InterfaceAddresses addresses = m_addresses.value(m_interface);
+    m_ipAddress = addresses.ipv4.isEmpty() ? (addresses.ipv6.isEmpty() ? "N/A" : addresses.ipv6) : addresses.ipv4;
+    m_ipv6Address = addresses.ipv6.isEmpty() ? "N/A" : addresses.ipv6;
+    m_macAddress = parseMacAddress(m_interface);
+}
+
+bool NetworkMonitor::applyInterfaceState()
+{
+    bool changed = false;
+
+    const QString iface = selectInterface();
+    if (iface != m_interface) {
+        LOG_INFO("NetworkMonitor: active interface %1 -> %2", m_interface, iface);
+        m_interface = iface;
+
+        // Counters of the new interface are unrelated to the old ones
+        m_prevTimestamp = 0;
+        changed = true;
+    }
+
+    InterfaceAddresses addresses = m_addresses.value(m_interface);
+    QString ipAddress = addresses.ipv4.isEmpty() ? (addresses.ipv6.isEmpty() ? "N/A" : addresses.ipv6) : addresses.ipv4;
+    QString ipv6Address = addresses.ipv6.isEmpty() ? "N/A" : addresses.ipv6;
+
+    auto link = m_links.constFind(m_interface);
+    QString macAddress = (link != m_links.cend() && !link->mac.isEmpty()) ? link->mac : "N/A";
+
+    if (ipAddress != m_ipAddress || ipv6Address != m_ipv6Address || macAddress != m_macAddress) {
+        m_ipAddress = ipAddress;
+        m_ipv6Address = ipv6Address;
+        m_macAddress = macAddress;
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool NetworkMonitor::refreshLinks()
+{
+    if (!m_routeSocket.isOpen()) {
+        return false;
+    }
+
+    ifinfomsg request;
+    memset(&request, 0, sizeof(request));
+    request.ifi_family = AF_UNSPEC;
+
+    if (!m_routeSocket.sendRequest(RTM_GETLINK, NLM_F_DUMP, &request, sizeof(request))) {
+        return false;
+    }
+
+    QHash<QString, LinkState> links;
+
+    bool ok = m_routeSocket.receiveDump([&](const nlmsghdr* msg) {
+        if (msg->nlmsg_type == RTM_NEWLINK) {
+            applyLinkMessage(msg, links);
+        }
+    });
+
+    if (!ok) {
+        return false;
+    }
+
+    m_links.swap(links);
+    return true;
+}
+
+bool NetworkMonitor::refreshAddresses()
+{
+    if (!m_routeSocket.isOpen()) {
+        return false;
+    }
+
+    ifaddrmsg request;
+    memset(&request, 0, sizeof(request));
+    request.ifa_family = AF_UNSPEC;   // IPv4 and IPv6 in one dump
+
+    if (!m_routeSocket.sendRequest(RTM_GETADDR, NLM_F_DUMP, &request, sizeof(request))) {
+        return false;
+    }
+
+    QHash<QString, InterfaceAddresses> addresses;
+    QHash<int, QString> names;
+
+    bool ok = m_routeSocket.receiveDump([&](const nlmsghdr* msg) {
+        if (msg->nlmsg_type != RTM_NEWADDR) {
+            return;
+        }
+
+        const ifaddrmsg* ifa = static_cast<const ifaddrmsg*>(NLMSG_DATA(msg));
+        if (ifa->ifa_family != AF_INET && ifa->ifa_family != AF_INET6) {
+            return;
+        }
+
+        // IFA_LOCAL is the interface's own address on point-to-point links,
+        // IFA_ADDRESS otherwise
+        const void* address = nullptr;
+        const void* local = nullptr;
+        int length = static_cast<int>(IFA_PAYLOAD(msg));
+
+        for (const rtattr* rta = IFA_RTA(ifa); RTA_OK(rta, length); rta = RTA_NEXT(rta, length)) {
+            if (rta->rta_type == IFA_ADDRESS) {
+                address = RTA_DATA(rta);
+            }
+            else if (rta->rta_type == IFA_LOCAL) {
+                local = RTA_DATA(rta);
+            }
+        }
+
+        const void* selected = local ? local : address;
+        if (!selected) {
+            return;
+        }
+
+        // Resolve the name once per interface index
+        const int index = static_cast<int>(ifa->ifa_index);
+        auto nameIt = names.find(index);
+        if (nameIt == names.end()) {
+            char nameBuffer[IF_NAMESIZE];
+            nameIt = names.insert(index, if_indextoname(ifa->ifa_index, nameBuffer)
+                                             ? QString::fromLatin1(nameBuffer) : QString());
+        }
+        if (nameIt->isEmpty()) {
+            return;
+        }
+
+        char text[INET6_ADDRSTRLEN];
+        if (!inet_ntop(ifa->ifa_family, selected, text, sizeof(text))) {
+            return;
+        }
+
+        InterfaceAddresses& entry = addresses[*nameIt];
+        if (ifa->ifa_family == AF_INET) {
+            if (entry.ipv4.isEmpty()) {
+                entry.ipv4 = QString::fromLatin1(text);
+            }
+        }
+        // Prefer a global IPv6 address over link-local
+        else if (entry.ipv6.isEmpty() || ifa->ifa_scope == RT_SCOPE_UNIVERSE) {
+            entry.ipv6 = QString::fromLatin1(text);
+        }
+    });
+
+    if (!ok) {
+        return false;
     }
 
-    QString output = QString::fromUtf8(process.readAllStandardOutput());
-    QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+    m_addresses.swap(addresses);
+    return true;
+}
+
+bool NetworkMonitor::readInterfaceAddresses()
+{
+    ifaddrs* list = nullptr;
+    if (getifaddrs(&list) != 0) {
+        return false;
+    }
+
+    QHash<QString, InterfaceAddresses> addresses;
+
+    // ifa_addr is the interface's own address, on point-to-point links too
+    for (const ifaddrs* ifa = list; ifa; ifa = ifa->ifa_next) {
+        if (!ifa->ifa_addr || !ifa->ifa_name) {
+            continue;
+        }
+
+        const int family = ifa->ifa_addr->sa_family;
+        const void* address = nullptr;
+        bool global = false;
+        if (family == AF_INET) {
+            address = &reinterpret_cast<const sockaddr_in*>(ifa->ifa_addr)->sin_addr;
+        }
+        else if (family == AF_INET6) {
+            const in6_addr* address6 = &reinterpret_cast<const sockaddr_in6*>(ifa->ifa_addr)->sin6_addr;
+            address = address6;
+            global = !IN6_IS_ADDR_LINKLOCAL(address6) && !IN6_IS_ADDR_LOOPBACK(address6);
+        }
+        else {
+            continue;
+        }
+
+        char text[INET6_ADDRSTRLEN];
+        if (!inet_ntop(family, address, text, sizeof(text))) {
+            continue;
+        }
 
-    // Look for line with "inet " (IPv4)
-    for (const QString &line: lines) {
-        QString trimmed =  line.trimmed();
-        if (trimmed.startsWith("inet ")) {
-            // Format: "inet 192.168.1.100/24..."
-            QStringList parts = trimmed.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                // Remove subnet mask (/24)
-                return parts[1].split('/').first();
+        // Same preferences as refreshAddresses()
+        InterfaceAddresses& entry = addresses[QString::fromLatin1(ifa->ifa_name)];
+        if (family == AF_INET) {
+            if (entry.ipv4.isEmpty()) {
+                entry.ipv4 = QString::fromLatin1(text);
             }
         }
+        else if (entry.ipv6.isEmpty() || global) {
+            entry.ipv6 = QString::fromLatin1(text);
+        }
     }
 
-    return "N/A";
+    freeifaddrs(list);
+
+    m_addresses.swap(addresses);
+    return true;
 }
 
 QString NetworkMonitor::parseMacAddress(const QString &interface)
@@ -204,120 +612,147 @@ NetworkMonitor::NetStats NetworkMonitor::parseNetStats(const QString &interface)
 {
     NetStats stats;
     
-    if (interface.isEmpty()) {
+    if (interface.isEmpty() || !m_netDevFile.read(m_netDevBuffer)) {
         return stats;
     }
-    
-    QStringList lines = FileReader::readLines(App::Path::PROC_NET_DEV);
 
-    for (const QString& line : lines) {
-        if (line.contains(interface + ":")) {
-            int colonPos = line.indexOf(':');
+    const QByteArray name = interface.toLatin1();
+    parseNetDev(m_netDevBuffer.constData(), m_netDevBuffer.size(), name, stats);
+    return stats;
+}
+
+bool NetworkMonitor::parseNetDev(const char* data, qsizetype size, QByteArrayView interface, NetStats& stats)
+{
+    const char* p = data;
+    const char* end = data + size;
 
-            if (colonPos > 0) {
-                QString values = line.mid(colonPos + 1);
-                QStringList parts = values.split(' ', Qt::SkipEmptyParts);
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
 
-                // Index: 0=rxBytes, 1=rxPackets, 8=txBytes, 9=txPackets
-                if (parts.size() >= 10) {
-                    stats.rxBytes = parts[0].toULongLong();
-                    stats.rxPackets = parts[1].toULongLong();
-                    stats.txBytes = parts[8].toULongLong();
-                    stats.txPackets = parts[9].toULongLong();
+        // Line format: "  eth0: rxBytes rxPackets ... txBytes txPackets ..."
+        const char* q = p;
+        while (q < lineEnd && *q == ' ') {
+            ++q;
+        }
+
+        const char* colon = static_cast<const char*>(memchr(q, ':', static_cast<size_t>(lineEnd - q)));
+        if (colon && (colon - q) == interface.size() && memcmp(q, interface.data(), static_cast<size_t>(interface.size())) == 0) {
+            // Index: 0=rxBytes, 1=rxPackets, 8=txBytes, 9=txPackets
+            unsigned long long values[10] = {};
+            const char* v = colon + 1;
+            int count = 0;
+
+            while (count < 10 && v < lineEnd) {
+                while (v < lineEnd && *v == ' ') {
+                    ++v;
+                }
+                if (v == lineEnd) {
+                    break;
+                }
+                while (v < lineEnd && *v >= '0' && *v <= '9') {
+                    values[count] = values[count] * 10 + static_cast<unsigned long long>(*v - '0');
+                    ++v;
                 }
+                ++count;
             }
-            break;
+
+            if (count < 10) {
+                return false;
+            }
+            stats.rxBytes = values[0];
+            stats.rxPackets = values[1];
+            stats.txBytes = values[8];
+            stats.txPackets = values[9];
+            return true;
         }
+
+        p = lineEnd + 1;
     }
     
-    return stats;
+    return false;
 }
 
-QVariantList NetworkMonitor::getUpHistory() const
+int NetworkMonitor::parseActiveConnections()
 {
-    QVariantList result;
-    result.reserve(m_upHistory.size());
-
-    for (int value : m_upHistory) {
-        result.append(value);
-    }
-    return result;
+    TcpStateCounts counts = countTcpStates(1u << TCP_ESTABLISHED);
+    return counts[TCP_ESTABLISHED];
 }
 
-QVariantList NetworkMonitor::getDownHistory() const
+NetworkMonitor::TcpStateCounts NetworkMonitor::countTcpStates(quint32 stateMask)
 {
-    QVariantList result;
-    result.reserve(m_downHistory.size());
+    TcpStateCounts counts{};
 
-    for (int value : m_downHistory) {
-        result.append(value);
+    if (!countTcpStatesDiag(AF_INET, stateMask, counts)) {
+        countTcpStatesProc(m_tcpFile, m_tcpChunk, stateMask, counts);
     }
-    return result;
+    if (!countTcpStatesDiag(AF_INET6, stateMask, counts)) {
+        countTcpStatesProc(m_tcp6File, m_tcpChunk, stateMask, counts);
+    }
+
+    return counts;
 }
 
-int NetworkMonitor::parseActiveConnections()
+bool NetworkMonitor::countTcpStatesDiag(int family, quint32 stateMask, TcpStateCounts &counts)
 {
-    int count = 0;
+    if (!m_diagSocket.isOpen()) {
+        return false;
+    }
 
-    // Count IPv4 connections
-    QStringList tcpLines = FileReader::readLines(App::Path::PROC_NET_TCP);
-    for (int i = 1; i < tcpLines.size(); i++) { // Skip header
-        QStringList parts = tcpLines[i].split(' ', Qt::SkipEmptyParts);
+    inet_diag_req_v2 request;
+    memset(&request, 0, sizeof(request));
+    request.sdiag_family = static_cast<quint8>(family);
+    request.sdiag_protocol = IPPROTO_TCP;
+    request.idiag_states = stateMask;   // Filtered by the kernel
+    request.idiag_ext = 0;              // No extensions: smallest replies
 
-        if (parts.size() >= 4 && parts[3] == "01") { // ESTABLISHED
-            count++;
-        }
+    if (!m_diagSocket.sendRequest(SOCK_DIAG_BY_FAMILY, NLM_F_DUMP, &request, sizeof(request))) {
+        return false;
     }
 
-    // Count IPv6 connections
-     QStringList tcp6Lines = FileReader::readLines(App::Path::PROC_NET_TCP6);
-    for (int i = 1; i < tcp6Lines.size(); i++) { 
-        QStringList parts = tcp6Lines[i].split(' ', Qt::SkipEmptyParts);
+    // Count into a local table so a failed dump leaves no partial result
+    TcpStateCounts familyCounts{};
+
+    bool ok = m_diagSocket.receiveDump([&](const nlmsghdr* msg) {
+        if (msg->nlmsg_type != SOCK_DIAG_BY_FAMILY) {
+            return;
+        }
 
-        if (parts.size() >= 4 && parts[3] == "01") { 
-            count++;
+        const inet_diag_msg* diag = static_cast<const inet_diag_msg*>(NLMSG_DATA(msg));
+        if (diag->idiag_state < TCP_STATE_SLOTS) {
+            ++familyCounts[diag->idiag_state];
         }
+    });
+
+    if (!ok) {
+        return false;
     }
-    
-    return count;
+
+    for (int state = 0; state < TCP_STATE_SLOTS; ++state) {
+        counts[state] += familyCounts[state];
+    }
+    return true;
 }
 
-QString NetworkMonitor::formatRate(double bytesPerSec)
+void NetworkMonitor::countTcpStatesProc(ProcFileHandle &file, QByteArray &chunk,
+                                        quint32 stateMask, TcpStateCounts &counts)
 {
-    constexpr double KB = 1024.0;
-    constexpr double MB = KB * 1024.0;
-    constexpr double GB = MB * 1024.0;
-    
-    if (bytesPerSec >= GB) {
-        return QString::number(bytesPerSec / GB, 'f', 1) + " GB/s";
-    } 
-    else if (bytesPerSec >= MB) {
-        return QString::number(bytesPerSec / MB, 'f', 1) + " MB/s";
-    } 
-    else if (bytesPerSec >= KB) {
-        return QString::number(bytesPerSec / KB, 'f', 1) + " KB/s";
-    } 
-    else {
-        return QString::number(static_cast<int>(bytesPerSec)) + " B/s";
-    }
+    file.forEachLine(chunk, [&](QByteArrayView line) {
+        int state = tcpLineState(line);
+        if (state > 0 && state < TCP_STATE_SLOTS && (stateMask & (1u << state))) {
+            ++counts[state];
+        }
+    });
 }
 
-double NetworkMonitor::calculateRate(unsigned long long deltaBytes, qint64 deltaMs)
+double NetworkMonitor::calculateRate(unsigned long long delta, qint64 deltaMs)
 {
     if (deltaMs <= 0) {
         return 0.0;
     }
     
-    // Convert to bytes per second
-    return (deltaBytes * 1000.0) / deltaMs;
+    // Convert to units per second
+    return (delta * 1000.0) / deltaMs;
 }
-
-QString NetworkMonitor::parseDownloadRate()
-{
-    return m_downSpeed;
-}
-
-QString NetworkMonitor::parseUploadRate()
-{
-    return m_upSpeed;
-}
\ No newline at end of file
@@ -10,8 +10,17 @@
 
 #include <QObject>
 #include <QString>
-#include <QVector>
 #include <QVariantList>
+#include <QByteArray>
+#include <QHash>
+#include <array>
+#include "FileReader.h"
+#include "NetlinkSocket.h"
+#include "RingBuffer.h"
+#include "CompressedSeries.h"
+#include "Constants.h"
+
+class QSocketNotifier;
 
 /**
  * @class NetworkMonitor
@@ -19,9 +28,13 @@
  * 
  * Reads data from:
  * - /proc/net/dev (traffic stats)
- * - /proc/net/tcp (connections)
- * - /sys/class/net (MAC address, carrier)
- * - ip command (IP address)
+ * - sock_diag inet_diag dumps (connections), /proc/net/tcp as fallback
+ * - rtnetlink RTM_GETLINK/RTM_GETADDR (links, MAC and IP addresses)
+ * - /sys/class/net (MAC address, carrier) when netlink is unavailable
+ *
+ * Interface, carrier, MAC and address changes arrive as rtnetlink
+ * multicast notifications handled from the event loop, so update()
+ * only has to read the traffic counters.
  */
 class NetworkMonitor : public QObject
 {
@@ -38,43 +51,146 @@ public:
         unsigned long long txPackets = 0;
     };
 
+    /**
+     * @brief Preferred addresses of one interface
+     */
+    struct InterfaceAddresses {
+        QString ipv4;
+        QString ipv6;
+    };
+
+    /**
+     * @brief State of one network link as reported by RTM_NEWLINK
+     */
+    struct LinkState {
+        int index = 0;
+        bool up = false;
+        bool carrier = false;
+        bool loopback = false;
+        QString mac;
+    };
+
+    /**
+     * @brief Socket counts indexed by TCP state (TCP_ESTABLISHED = 1, ...)
+     */
+    static constexpr int TCP_STATE_SLOTS = 16;
+    using TcpStateCounts = std::array<int, TCP_STATE_SLOTS>;
+
     explicit NetworkMonitor(QObject *parent = nullptr);
     ~NetworkMonitor() override = default;
 
     /**
-     * @brief Update all network statistics
+     * @brief Update traffic statistics (and interface info when polling)
      */    
     void update();
 
+    /**
+     * @brief Recount established TCP connections (sock_diag dump)
+     *
+     * Separate from update() so it can run on a slower schedule.
+     */
+    void updateConnections();
+
+    /**
+     * @brief Move the rate baseline to the current counters
+     *
+     * Cheap stand-in for update() while no page shows traffic: no chart
+     * history, and the next update() measures a short interval. The rates
+     * still cover the idle interval, for the long-range archive.
+     *
+     * @return false if there was no previous read to measure rates from
+     */
+    bool updateBaseline();
+
     // === Interface Info ===
     QString getInterface() const { return m_interface; }    
     QString getIpAddress() const { return m_ipAddress; }
+    QString getIpv6Address() const { return m_ipv6Address; }
     QString getMacAddress() const { return m_macAddress; }
 
-    // === Traffic Stats ===
-    QString getUpSpeed() const { return m_upSpeed; }
-    QString getDownSpeed() const { return m_downSpeed; }
-    QString getPacketRate() const { return m_packetRate; }
+    // === Traffic Stats (bytes/s, packets/s) ===
+    double getUpSpeed() const { return m_upSpeed; }
+    double getDownSpeed() const { return m_downSpeed; }
+    double getPacketRate() const { return m_packetRate; }
     int getActiveConnections() const { return m_activeConnections; }
 
     // === History for Charts ===
-    QVariantList getUpHistory() const;
-    QVariantList getDownHistory() const;
+    const RingBuffer<int, App::History::CHART_SAMPLES>& getUpHistory() const { return m_upHistory; }
+    const RingBuffer<int, App::History::CHART_SAMPLES>& getDownHistory() const { return m_downHistory; }
+
+    // === Long-range history (bytes/s, to 1 KB/s, baselines included) ===
+    const CompressedSeries& getUpSeries() const { return m_upSeries; }
+    const CompressedSeries& getDownSeries() const { return m_downSeries; }
+
+    /**
+     * @brief Parse one interface's counters from /proc/net/dev content
+     * @return false if the interface has no complete line
+     */
+    static bool parseNetDev(const char* data, qsizetype size, QByteArrayView interface, NetStats& stats);
 
-   // === Legacy API ===
-    QString parseDownloadRate();
-    QString parseUploadRate();
+    /**
+     * @brief Count one address family by streaming /proc/net/tcp{,6}
+     * @param chunk Scratch buffer for ProcFileHandle::forEachLine()
+     * @param stateMask Bitmask of (1 << TCP_*) states to count
+     */
+    static void countTcpStatesProc(ProcFileHandle& file, QByteArray& chunk,
+                                   quint32 stateMask, TcpStateCounts& counts);
+
+signals:
+    /**
+     * @brief Active interface, IP or MAC address changed
+     */
+    void linkStateChanged();
+
+private slots:
+    /**
+     * @brief Handle queued rtnetlink link/address notifications
+     */
+    void onNetlinkEvent();
 
 private:
     /**
-     * @brief Detect active network interface
+     * @brief Subscribe to link/address notifications and load initial state
+     * @return false if netlink is unavailable (polling fallback)
+     */
+    bool startLinkTracking();
+
+    /**
+     * @brief Detect active network interface from sysfs (polling fallback)
      */
     QString detectInterface();
 
     /**
-     * @brief Parse IP address for interface
+     * @brief Pick the active interface from the link table
+     */
+    QString selectInterface() const;
+
+    /**
+     * @brief Re-read interface, MAC and addresses without notifications
+     */
+    void pollInterfaceState();
+
+    /**
+     * @brief Apply link table and address cache to the exposed fields
+     * @return true if interface, IP or MAC changed
+     */
+    bool applyInterfaceState();
+
+    /**
+     * @brief Re-dump all links with one RTM_GETLINK request
+     */
+    bool refreshLinks();
+
+    /**
+     * @brief Re-dump all interface addresses with one RTM_GETADDR request
      */
-    QString parseIpAddress(const QString& interface);
+    bool refreshAddresses();
+
+    /**
+     * @brief Re-read all interface addresses with getifaddrs(), for when
+     * the rtnetlink socket could not be opened
+     */
+    bool readInterfaceAddresses();
 
     /**
      * @brief Parse MAC address for interface
@@ -92,14 +208,31 @@ private:
     int parseActiveConnections();
 
     /**
-     * @brief Format bytes/sec to human-readable string
+     * @brief Count IPv4 and IPv6 TCP sockets per state
+     * @param stateMask Bitmask of (1 << TCP_*) states to count
+     */
+    TcpStateCounts countTcpStates(quint32 stateMask);
+
+    /**
+     * @brief Count one address family with a sock_diag dump
+     *
+     * The kernel applies stateMask itself, so only matching sockets are
+     * sent back, and replies are counted in place without being stored.
+     *
+     * @return false if sock_diag is unavailable or the dump failed
+     */
+    bool countTcpStatesDiag(int family, quint32 stateMask, TcpStateCounts& counts);
+
+    /**
+     * @brief Re-read the counters and recompute the rates since the last read
+     * @return false on the first read (no previous counters, rates are 0)
      */
-    QString formatRate(double bytesPerSec);
+    bool measureRates();
 
     /**
-     * @brief Calculate rate from delta bytes and time
+     * @brief Per-second rate of a counter delta (bytes or packets)
      */
-    double calculateRate(unsigned long long deltaBytes, qint64 deltaMs);
+    double calculateRate(unsigned long long delta, qint64 deltaMs);
 
 private:
     // Current interface name
@@ -107,14 +240,28 @@ private:
 
     // IP and MAC addresses
     QString m_ipAddress;
+    QString m_ipv6Address;
     QString m_macAddress;
 
-    // Speed/rate strings
-    QString m_upSpeed;
-    QString m_downSpeed;
+    // rtnetlink link table and address cache, keyed by interface name
+    QHash<QString, LinkState> m_links;
+    QHash<QString, InterfaceAddresses> m_addresses;
+    NetlinkSocket m_routeSocket;     // RTM_GETLINK/RTM_GETADDR dumps
+    NetlinkSocket m_events;          // RTMGRP_LINK/RTMGRP_*_IFADDR notifications
+    QSocketNotifier* m_eventNotifier;
 
-    // Packet rate
-    QString m_packetRate;
+    // Connection counting: sock_diag, or streamed /proc/net/tcp{,6}
+    NetlinkSocket m_diagSocket;
+    ProcFileHandle m_tcpFile;
+    ProcFileHandle m_tcp6File;
+    QByteArray m_tcpChunk;
+
+    // Traffic rates (bytes/s)
+    double m_upSpeed;
+    double m_downSpeed;
+
+    // Packet rate (rx + tx packets/s)
+    double m_packetRate;
 
     // Active connetions count
     int m_activeConnections;
@@ -124,11 +271,16 @@ private:
     qint64 m_prevTimestamp;
 
     // History buffers for charts
-    QVector<int> m_upHistory;
-    QVector<int> m_downHistory;
+    RingBuffer<int, App::History::CHART_SAMPLES> m_upHistory;
+    RingBuffer<int, App::History::CHART_SAMPLES> m_downHistory;
+
+    // Long-range history
+    CompressedSeries m_upSeries;
+    CompressedSeries m_downSeries;
 
-    // Constants
-    static constexpr int MAX_HISTORY = 60;
+    // /proc/net/dev kept open and re-read with pread()
+    ProcFileHandle m_netDevFile;
+    QByteArray m_netDevBuffer;
 };
 
 #endif // NETWORKMONITOR_H
\ No newline at end of file
@@ -0,0 +1,498 @@
+/**
+ * ============================================
+ * File: src/model/ProcessMonitor.cpp
+ * Description: Process table implementation
+ * ============================================
+ */
+
+#define LOG_CATEGORY LogCategory::Process
+
+#include "ProcessMonitor.h"
+#include "Logger.h"
+#include <QFile>
+#include <QSocketNotifier>
+#include <QVariantMap>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief pid of a /proc entry name, -1 for anything else
+ */
+int parsePid(const char* name)
+{
+    int pid = 0;
+    for (const char* c = name; *c; ++c) {
+        if (*c < '0' || *c > '9') {
+            return -1;
+        }
+        pid = pid * 10 + (*c - '0');
+    }
+    return (*name != '\0') ? pid : -1;
+}
+
+/**
+ * @brief Next space-separated unsigned field, advancing cursor
+ */
+quint64 nextField(const char*& cursor, const char* end)
+{
+    while (cursor < end && *cursor == ' ') {
+        ++cursor;
+    }
+
+    quint64 value = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        value = value * 10 + static_cast<quint64>(*cursor - '0');
+        ++cursor;
+    }
+
+    // Skip the rest of a signed or non-numeric field
+    while (cursor < end && *cursor != ' ') {
+        ++cursor;
+    }
+    return value;
+}
+
+// Event codes of struct proc_event, spelled out because newer kernel
+// headers moved the enum out of the struct
+constexpr quint32 PROC_EVENT_FORK_CODE = 0x00000001;
+constexpr quint32 PROC_EVENT_EXEC_CODE = 0x00000002;
+constexpr quint32 PROC_EVENT_EXIT_CODE = 0x80000000;
+
+/**
+ * @brief Send a proc connector multicast op (PROC_CN_MCAST_LISTEN/IGNORE)
+ */
+bool sendMulticastOp(NetlinkSocket& socket, quint32 op)
+{
+    // cn_msg ends in a flexible array, so the op is laid out behind it by hand
+    char payload[sizeof(cn_msg) + sizeof(op)];
+    memset(payload, 0, sizeof(payload));
+
+    cn_msg* message = reinterpret_cast<cn_msg*>(payload);
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(op);
+    memcpy(payload + sizeof(cn_msg), &op, sizeof(op));
+
+    return socket.sendRequest(NLMSG_DONE, 0, payload, sizeof(payload));
+}
+
+} // namespace
+
+ProcessMonitor::ProcessMonitor(QObject* parent)
+    : ProcessMonitor(QString::fromLatin1(App::Path::PROC), parent)
+{
+    if (!startEventTracking()) {
+        LOG_INFO("ProcessMonitor: proc connector unavailable (needs CAP_NET_ADMIN), scanning /proc");
+    }
+
+    LOG_INFO("ProcessMonitor initialized - budget %1 pids per update, %2",
+             App::Process::SCAN_BUDGET, isEventDriven() ? QString("event-driven") : QString("directory passes"));
+}
+
+ProcessMonitor::ProcessMonitor(const QString& procRoot, QObject* parent)
+    : QObject(parent)
+    , m_procRoot(QFile::encodeName(procRoot))
+    , m_procDir(nullptr)
+    , m_pass(1)
+    , m_baselinePass(1)
+    , m_passStartCount(0)
+    , m_passStartMs(0)
+    , m_processCount(0)
+    , m_eventNotifier(nullptr)
+    , m_rescan(true)
+    , m_suspended(false)
+    , m_nextPid(0)
+    , m_prevCountersMs(0)
+    , m_forkRate(0.0)
+    , m_execRate(0.0)
+    , m_exitRate(0.0)
+    , m_ticksPerSec(sysconf(_SC_CLK_TCK))
+    , m_pageSize(sysconf(_SC_PAGESIZE))
+{
+    m_clock.start();
+    m_processes.reserve(512);
+}
+
+ProcessMonitor::~ProcessMonitor()
+{
+    stopEventTracking();
+
+    if (m_procDir) {
+        closedir(m_procDir);
+    }
+}
+
+bool ProcessMonitor::startEventTracking()
+{
+    // Subscribing to the group is what needs the capability
+    if (!m_events.open(NETLINK_CONNECTOR, CN_IDX_PROC, true)) {
+        return false;
+    }
+
+    if (!sendMulticastOp(m_events, PROC_CN_MCAST_LISTEN)) {
+        m_events.close();
+        return false;
+    }
+
+    // Subscribed before the first directory pass, so a process started
+    // while it runs arrives as an event rather than being missed
+    m_eventNotifier = new QSocketNotifier(m_events.fd(), QSocketNotifier::Read, this);
+    connect(m_eventNotifier, &QSocketNotifier::activated, this, &ProcessMonitor::onProcEvent);
+
+    return true;
+}
+
+void ProcessMonitor::stopEventTracking()
+{
+    if (!m_eventNotifier) {
+        return;
+    }
+
+    // The kernel counts listeners and generates events while any remain
+    sendMulticastOp(m_events, PROC_CN_MCAST_IGNORE);
+
+    delete m_eventNotifier;
+    m_eventNotifier = nullptr;
+    m_events.close();
+}
+
+void ProcessMonitor::onProcEvent()
+{
+    const int handled = m_events.drain([this](const nlmsghdr* msg) {
+        const cn_msg* message = static_cast<const cn_msg*>(NLMSG_DATA(msg));
+        const proc_event* event = reinterpret_cast<const proc_event*>(message->data);
+
+        // Every event read below fits in the fork variant
+        if (msg->nlmsg_len < NLMSG_LENGTH(sizeof(cn_msg) + offsetof(proc_event, event_data)
+                                          + sizeof(event->event_data.fork))
+            || message->id.idx != CN_IDX_PROC) {
+            return;
+        }
+
+        // Threads have their own fork/exit events: only thread group
+        // leaders (pid == tgid) are processes
+        switch (static_cast<quint32>(event->what)) {
+        case PROC_EVENT_FORK_CODE:
+            if (event->event_data.fork.child_pid == event->event_data.fork.child_tgid) {
+                // Read at the next refresh; pass keeps it through a rescan
+                m_processes.insert(event->event_data.fork.child_pid).pass = m_pass;
+                ++m_counters.forks;
+            }
+            break;
+        case PROC_EVENT_EXEC_CODE:
+            if (event->event_data.exec.process_pid == event->event_data.exec.process_tgid) {
+                if (Process* process = m_processes.find(event->event_data.exec.process_pid)) {
+                    process->execed = true;
+                }
+                ++m_counters.execs;
+            }
+            break;
+        case PROC_EVENT_EXIT_CODE:
+            if (event->event_data.exit.process_pid == event->event_data.exit.process_tgid) {
+                m_processes.erase(event->event_data.exit.process_pid);
+                ++m_counters.exits;
+            }
+            break;
+        default:
+            break;
+        }
+    });
+
+    if (handled < 0) {
+        // Receive queue overflowed (ENOBUFS), e.g. during a fork storm:
+        // events were lost, so resync the pid set from /proc
+        LOG_WARNING("ProcessMonitor: proc events lost, rescanning /proc");
+        m_rescan = true;
+    }
+}
+
+void ProcessMonitor::setSuspended(bool suspended)
+{
+    if (m_suspended == suspended) {
+        return;
+    }
+    m_suspended = suspended;
+
+    if (m_eventNotifier) {
+        m_eventNotifier->setEnabled(!suspended);
+    }
+    if (suspended) {
+        return;
+    }
+
+    if (m_eventNotifier) {
+        // Apply what is still queued; a long suspension overflows the
+        // socket, so rescan for what was dropped either way
+        onProcEvent();
+        m_rescan = true;
+    }
+    else {
+        // The pass in progress spans the suspension
+        m_baselinePass = m_pass;
+    }
+
+    // Counters are only diffed from the next update on
+    m_prevCountersMs = 0;
+    m_forkRate = 0.0;
+    m_execRate = 0.0;
+    m_exitRate = 0.0;
+}
+
+void ProcessMonitor::update()
+{
+    const qint64 nowMs = m_clock.elapsed();
+
+    if (m_eventNotifier && !m_rescan) {
+        refreshTracked(nowMs);
+    }
+    else {
+        scanDirectory(nowMs);
+    }
+
+    measureRates(nowMs);
+    rank();
+}
+
+void ProcessMonitor::scanDirectory(qint64 nowMs)
+{
+    if (!m_procDir) {
+        m_procDir = opendir(m_procRoot.constData());
+        if (!m_procDir) {
+            LOG_WARNING("ProcessMonitor: cannot open %1", QFile::decodeName(m_procRoot));
+            return;
+        }
+    }
+
+    int scanned = 0;
+    while (scanned < App::Process::SCAN_BUDGET) {
+        const dirent* entry = readdir(m_procDir);
+        if (!entry) {
+            finishPass(nowMs);
+            break;
+        }
+
+        const int pid = parsePid(entry->d_name);
+        if (pid > 0) {
+            sampleProcess(pid, nowMs);
+            ++scanned;
+        }
+    }
+}
+
+void ProcessMonitor::refreshTracked(qint64 nowMs)
+{
+    m_pids.clear();
+    m_processes.forEach([this](int pid, const Process&) {
+        m_pids.append(pid);
+    });
+
+    // Table order changes with every insert, erase and rehash; pid order
+    // does not, so resuming after the last pid read reaches each in turn
+    std::sort(m_pids.begin(), m_pids.end());
+
+    const int count = static_cast<int>(m_pids.size());
+    const int budget = qMin(count, App::Process::SCAN_BUDGET);
+    const int start = static_cast<int>(std::lower_bound(m_pids.cbegin(), m_pids.cend(), m_nextPid)
+                                       - m_pids.cbegin());
+
+    for (int i = 0; i < budget; ++i) {
+        const int pid = m_pids.at((start + i) % count);
+        if (!sampleProcess(pid, nowMs)) {
+            // Exited before its event was handled
+            m_processes.erase(pid);
+        }
+        m_nextPid = pid + 1;
+    }
+
+    m_processCount = m_processes.size();
+}
+
+bool ProcessMonitor::sampleProcess(int pid, qint64 nowMs)
+{
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%d/stat", m_procRoot.constData(), pid);
+
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;   // Exited since it was listed
+    }
+    const ssize_t length = ::read(fd, m_statBuffer, sizeof(m_statBuffer) - 1);
+    ::close(fd);
+    if (length <= 0) {
+        return false;
+    }
+
+    StatFields fields;
+    if (!parseStat(m_statBuffer, length, fields)) {
+        return false;
+    }
+
+    bool inserted = false;
+    Process& process = m_processes.insert(pid, &inserted);
+
+    if (inserted || process.startTime != fields.startTime) {
+        // New pid, a reused one, or a fork not read yet: no previous
+        // reading to diff against
+        process = Process();
+        process.startTime = fields.startTime;
+        process.execed = true;
+    }
+    else if (nowMs > process.sampledMs && fields.ticks >= process.ticks) {
+        const double seconds = (nowMs - process.sampledMs) / 1000.0;
+        process.cpuPercent = static_cast<float>((fields.ticks - process.ticks) * 100.0 / (m_ticksPerSec * seconds));
+    }
+
+    // A rescan may follow lost exec events, so it re-reads every name
+    if (process.execed || m_rescan) {
+        const qsizetype nameLength = qMin<qsizetype>(fields.nameLength, sizeof(process.name) - 1);
+        memset(process.name, 0, sizeof(process.name));
+        memcpy(process.name, fields.name, static_cast<size_t>(nameLength));
+        process.execed = false;
+    }
+
+    process.state = fields.state;
+    process.ticks = fields.ticks;
+    process.sampledMs = nowMs;
+    process.rssBytes = static_cast<qint64>(fields.rssPages) * m_pageSize;
+    process.pass = m_pass;
+    return true;
+}
+
+bool ProcessMonitor::parseStat(const char* data, qsizetype size, StatFields& fields)
+{
+    // "pid (comm) state ..." - comm may hold spaces and ')', so take the last one
+    const char* end = data + size;
+    const char* open = static_cast<const char*>(memchr(data, '(', static_cast<size_t>(size)));
+    const char* close = end;
+    while (close > data && *(close - 1) != ')') {
+        --close;
+    }
+    if (!open || close <= open + 1 || close + 2 >= end) {
+        return false;
+    }
+    --close;
+
+    // Fields after comm, numbered as in proc(5)
+    const char* cursor = close + 2;
+    fields.name = open + 1;
+    fields.nameLength = close - open - 1;
+    fields.state = *cursor;
+    ++cursor;
+
+    quint64 utime = 0;
+    quint64 stime = 0;
+    for (int field = 4; field <= 24; ++field) {
+        const quint64 value = nextField(cursor, end);
+        switch (field) {
+        case 14: utime = value; break;
+        case 15: stime = value; break;
+        case 22: fields.startTime = value; break;
+        case 24: fields.rssPages = value; break;
+        default: break;
+        }
+    }
+    fields.ticks = utime + stime;
+    return true;
+}
+
+void ProcessMonitor::finishPass(qint64 nowMs)
+{
+    // Whatever this pass did not reach has exited
+    const quint32 pass = m_pass;
+    const int found = m_processes.size() - m_passStartCount;
+    const int removed = m_processes.removeIf([pass](int, const Process& process) {
+        return process.pass != pass;
+    });
+    m_processCount = m_processes.size();
+
+    // Without events, the difference between passes is all there is to
+    // count. It accrued over the whole pass, so it is divided by the time
+    // the pass took and held until the next one completes; the first pass
+    // (or one that spanned a suspension) only sets the baseline
+    if (!m_eventNotifier && m_pass > m_baselinePass && nowMs > m_passStartMs) {
+        const double seconds = (nowMs - m_passStartMs) / 1000.0;
+        m_forkRate = qMax(0, found) / seconds;
+        m_exitRate = removed / seconds;
+    }
+
+    m_passStartCount = m_processCount;
+    m_passStartMs = nowMs;
+    m_rescan = false;
+
+    ++m_pass;
+    rewinddir(m_procDir);
+}
+
+void ProcessMonitor::measureRates(qint64 nowMs)
+{
+    // Directory passes set their rates in finishPass()
+    if (!m_eventNotifier) {
+        return;
+    }
+
+    if (m_prevCountersMs > 0 && nowMs > m_prevCountersMs) {
+        const double seconds = (nowMs - m_prevCountersMs) / 1000.0;
+        m_forkRate = (m_counters.forks - m_prevCounters.forks) / seconds;
+        m_execRate = (m_counters.execs - m_prevCounters.execs) / seconds;
+        m_exitRate = (m_counters.exits - m_prevCounters.exits) / seconds;
+    }
+
+    m_prevCounters = m_counters;
+    m_prevCountersMs = nowMs;
+}
+
+template <typename Greater>
+QVariantList ProcessMonitor::topBy(Greater greater)
+{
+    auto byValue = [&greater](const std::pair<int, const Process*>& a,
+                              const std::pair<int, const Process*>& b) {
+        return greater(a.second, b.second);
+    };
+
+    // Partial selection: O(n) to find the top rows, then sort only those
+    const int count = qMin(App::Process::TOP_COUNT, static_cast<int>(m_candidates.size()));
+    std::nth_element(m_candidates.begin(), m_candidates.begin() + count, m_candidates.end(), byValue);
+    std::sort(m_candidates.begin(), m_candidates.begin() + count, byValue);
+
+    QVariantList rows;
+    rows.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const Process& process = *m_candidates.at(i).second;
+
+        QVariantMap row;
+        row["pid"] = m_candidates.at(i).first;
+        row["name"] = QString::fromLocal8Bit(process.name);
+        row["state"] = QString(QLatin1Char(process.state));
+        row["cpu"] = process.cpuPercent;
+        row["rss"] = process.rssBytes;
+        rows.append(row);
+    }
+    return rows;
+}
+
+void ProcessMonitor::rank()
+{
+    m_candidates.clear();
+    m_processes.forEach([this](int pid, const Process& process) {
+        // Forked pids are listed before their first read
+        if (process.name[0] != '\0') {
+            m_candidates.append({ pid, &process });
+        }
+    });
+
+    m_topByCpu = topBy([](const Process* a, const Process* b) {
+        return a->cpuPercent > b->cpuPercent;
+    });
+    m_topByMemory = topBy([](const Process* a, const Process* b) {
+        return a->rssBytes > b->rssBytes;
+    });
+}
@@ -0,0 +1,226 @@
+/**
+ * ============================================
+ * File: src/model/ProcessMonitor.h
+ * Description: Top processes by CPU and memory from /proc/[pid]/stat
+ * ============================================
+ */
+
+#ifndef PROCESSMONITOR_H
+#define PROCESSMONITOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QVariantList>
+#include <QVector>
+#include <dirent.h>
+#include "FlatHashMap.h"
+#include "NetlinkSocket.h"
+#include "Constants.h"
+
+class QSocketNotifier;
+
+/**
+ * @class ProcessMonitor
+ * @brief Ranks running processes by CPU% and resident memory
+ *
+ * Reads /proc/[pid]/stat for every process: one small read gives the
+ * name, state, CPU ticks, start time and resident set size. statm is not
+ * read, because its resident count is the same one stat reports.
+ *
+ * The set of live pids comes from one of two places:
+ * - Proc connector (NETLINK_CONNECTOR, needs CAP_NET_ADMIN): fork, exec
+ *   and exit events keep the table current as they happen, so an update
+ *   only re-reads the stat of pids already known. /proc is walked once at
+ *   start, and again only if events were dropped.
+ * - Otherwise, directory passes: the /proc directory stays open and each
+ *   update() reads the next pids from it; entries that a completed pass
+ *   did not see are dropped.
+ *
+ * Either way an update reads at most App::Process::SCAN_BUDGET pids,
+ * picking up where the previous one stopped, and each process's CPU% is
+ * measured over its own time between reads, so it stays correct when a
+ * round takes several updates.
+ *
+ * Fork, exec and exit rates are reported so that fork storms show up.
+ * With events they are exact (processes only, not threads); with
+ * directory passes, forks and exits are the pids a pass found new or
+ * gone, over the time the pass took, and exec is not known.
+ *
+ * Per-pid state lives in a FlatHashMap, and the read buffer is reused,
+ * so a steady process table is scanned without allocating. Ranking uses
+ * std::nth_element to pick the top entries, then sorts only those.
+ */
+class ProcessMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief What one /proc/[pid]/stat line holds that the table keeps
+     */
+    struct StatFields {
+        const char* name = nullptr;     // comm, in place in the parsed data
+        qsizetype nameLength = 0;
+        char state = '?';
+        quint64 ticks = 0;              // utime + stime
+        quint64 startTime = 0;
+        quint64 rssPages = 0;
+    };
+
+    explicit ProcessMonitor(QObject* parent = nullptr);
+
+    /**
+     * @brief Scan another /proc-shaped tree, by directory passes only
+     * @param procRoot Directory holding the [pid]/stat files
+     *
+     * For the benchmarks: proc connector events describe the live
+     * system, not the tree.
+     */
+    explicit ProcessMonitor(const QString& procRoot, QObject* parent = nullptr);
+
+    ~ProcessMonitor() override;
+
+    /**
+     * @brief Read the next batch of pids and re-rank
+     */
+    void update();
+
+    /**
+     * @brief Top processes as QML maps: pid, name, state, cpu (%), rss (bytes)
+     */
+    QVariantList getTopByCpu() const { return m_topByCpu; }
+    QVariantList getTopByMemory() const { return m_topByMemory; }
+
+    /**
+     * @brief Processes currently tracked
+     */
+    int getProcessCount() const { return m_processCount; }
+
+    /**
+     * @brief Process lifecycle rates (per second) between the last two
+     * updates, or over the last completed directory pass
+     */
+    double getForkRate() const { return m_forkRate; }
+    double getExecRate() const { return m_execRate; }
+    double getExitRate() const { return m_exitRate; }
+
+    /**
+     * @brief true if pids are tracked from proc connector events
+     */
+    bool isEventDriven() const { return m_eventNotifier != nullptr; }
+
+    /**
+     * @brief Stop or resume tracking while nothing reads the table
+     *
+     * Suspended, proc connector events are left queued in the socket, so
+     * a fork storm does not wake the thread. On resume /proc is rescanned
+     * for whatever the queue could not hold, and the rates restart from
+     * there rather than averaging over the suspension.
+     */
+    void setSuspended(bool suspended);
+
+    /**
+     * @brief Parse /proc/[pid]/stat content
+     * @return false if the line is truncated or malformed
+     */
+    static bool parseStat(const char* data, qsizetype size, StatFields& fields);
+
+private slots:
+    /**
+     * @brief Apply queued fork/exec/exit events to the table
+     */
+    void onProcEvent();
+
+private:
+    /**
+     * @brief What is kept per pid between reads
+     */
+    struct Process {
+        char name[16] = {};         // comm, at most 15 characters
+        char state = '?';
+        bool execed = false;        // comm may have changed since the last read
+        quint64 startTime = 0;      // Ticks after boot; a new value = reused pid
+        quint64 ticks = 0;          // utime + stime
+        qint64 sampledMs = 0;       // When ticks was read
+        float cpuPercent = 0.0f;
+        qint64 rssBytes = 0;
+        quint32 pass = 0;           // Last directory pass that saw the pid
+    };
+
+    /**
+     * @brief Subscribe to proc connector events
+     * @return false if the connector is unavailable (directory passes)
+     */
+    bool startEventTracking();
+    void stopEventTracking();
+
+    /**
+     * @brief Read the next pids from /proc, finishing the pass at its end
+     */
+    void scanDirectory(qint64 nowMs);
+
+    /**
+     * @brief Re-read the next tracked pids (event-driven mode)
+     */
+    void refreshTracked(qint64 nowMs);
+
+    /**
+     * @return false if the pid's stat could not be read (it has exited)
+     */
+    bool sampleProcess(int pid, qint64 nowMs);
+    void finishPass(qint64 nowMs);
+    void measureRates(qint64 nowMs);
+    void rank();
+
+    /**
+     * @brief Top rows of m_candidates by greater, as QML maps
+     */
+    template <typename Greater>
+    QVariantList topBy(Greater greater);
+
+private:
+    FlatHashMap<int, Process> m_processes;
+    QByteArray m_procRoot;      // Encoded, for opendir() and the stat paths
+    DIR* m_procDir;
+    quint32 m_pass;
+    quint32 m_baselinePass;     // Last pass that only counts, without a rate
+    int m_passStartCount;       // Table size when the current pass started
+    qint64 m_passStartMs;       // When it started
+    int m_processCount;
+
+    // Proc connector; while m_rescan is set, a directory pass is still
+    // needed to learn the pids that existed before (or while) events were lost
+    NetlinkSocket m_events;
+    QSocketNotifier* m_eventNotifier;
+    bool m_rescan;
+    bool m_suspended;
+    int m_nextPid;              // Where refreshTracked() resumes, in pid order
+
+    // Lifecycle counters and the rates derived from them
+    struct Counters {
+        quint64 forks = 0;
+        quint64 execs = 0;
+        quint64 exits = 0;
+    };
+    Counters m_counters;
+    Counters m_prevCounters;
+    qint64 m_prevCountersMs;
+    double m_forkRate;
+    double m_execRate;
+    double m_exitRate;
+
+    QElapsedTimer m_clock;
+    long m_ticksPerSec;
+    long m_pageSize;
+
+    // Reused between reads and ranks
+    char m_statBuffer[1024];
+    QVector<int> m_pids;                                    // Tracked pids, for refreshTracked()
+    QVector<std::pair<int, const Process*>> m_candidates;   // Every entry, for rank()
+
+    QVariantList m_topByCpu;
+    QVariantList m_topByMemory;
+};
+
+#endif // PROCESSMONITOR_H
@@ -0,0 +1,52 @@
+/**
+ * ============================================
+ * File: src/model/QuantileStore.cpp
+ * Description: Windowed percentiles implementation
+ * ============================================
+ */
+
+#include "QuantileStore.h"
+#include <QDateTime>
+#include <QMutexLocker>
+
+void QuantileStore::add(HistoryStore::Metric metric, double value)
+{
+    Series& series = m_series[metric];
+    const qint64 index = QDateTime::currentSecsSinceEpoch() / App::Quantile::SLICE_SEC;
+
+    QMutexLocker locker(&series.mutex);
+
+    Slice& slice = series.slices[index % App::Quantile::SLICE_COUNT];
+    if (slice.index != index) {
+        slice.index = index;
+        slice.sketch.clear();
+    }
+    slice.sketch.add(value);
+}
+
+bool QuantileStore::quantile(HistoryStore::Metric metric, double q, int windowSec, double& value) const
+{
+    const Series& series = m_series[metric];
+    const qint64 newest = QDateTime::currentSecsSinceEpoch() / App::Quantile::SLICE_SEC;
+    const int slices = qBound(1, (windowSec + App::Quantile::SLICE_SEC - 1) / App::Quantile::SLICE_SEC,
+                              App::Quantile::SLICE_COUNT);
+
+    QuantileSketch merged;
+
+    {
+        QMutexLocker locker(&series.mutex);
+
+        for (const Slice& slice : series.slices) {
+            if (slice.index > newest - slices && slice.index <= newest) {
+                merged.merge(slice.sketch);
+            }
+        }
+    }
+
+    if (merged.isEmpty()) {
+        return false;
+    }
+
+    value = merged.quantile(q);
+    return true;
+}
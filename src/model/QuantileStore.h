@@ -0,0 +1,61 @@
+/**
+ * ============================================
+ * File: src/model/QuantileStore.h
+ * Description: Windowed percentiles of the sampled metrics
+ * ============================================
+ */
+
+#ifndef QUANTILESTORE_H
+#define QUANTILESTORE_H
+
+#include <QMutex>
+#include <array>
+#include "Constants.h"
+#include "HistoryStore.h"
+#include "QuantileSketch.h"
+
+/**
+ * @class QuantileStore
+ * @brief p50/p95/p99-style queries over the last few seconds to an hour
+ *
+ * Each metric keeps a ring of QuantileSketch slices, one per SLICE_SEC of
+ * wall-clock time. A sample goes into the current slice (clearing it if
+ * it still holds one from a lap ago), so an update is O(1) and memory is
+ * bounded by SLICE_COUNT sketches. A query merges the slices inside the
+ * window, so windows are rounded up to whole slices.
+ *
+ * Metrics are HistoryStore's; MetricsSampler feeds both from the same
+ * values. Threading is the same as HistoryStore: appends on the sampler
+ * thread, queries on the GUI thread, a mutex per metric between them.
+ */
+class QuantileStore
+{
+public:
+    /**
+     * @brief Count one sample at the current wall-clock time
+     */
+    void add(HistoryStore::Metric metric, double value);
+
+    /**
+     * @brief Value at quantile q over the last windowSec seconds
+     * @param q 0..1, e.g. 0.99 for p99
+     * @param windowSec Rounded up to whole slices, capped at an hour
+     * @return false if no sample fell in the window
+     */
+    bool quantile(HistoryStore::Metric metric, double q, int windowSec, double& value) const;
+
+private:
+    struct Slice {
+        qint64 index = -1;      // timeSec / SLICE_SEC, -1 = unused
+        QuantileSketch sketch;
+    };
+
+    struct Series {
+        std::array<Slice, App::Quantile::SLICE_COUNT> slices;
+        mutable QMutex mutex;
+    };
+
+    std::array<Series, HistoryStore::MetricCount> m_series;
+};
+
+#endif // QUANTILESTORE_H
@@ -0,0 +1,270 @@
+/**
+ * ============================================
+ * File: src/model/RrdArchive.cpp
+ * Description: Round-robin time-series file implementation
+ * ============================================
+ */
+
+#define LOG_CATEGORY LogCategory::History
+
+#include "RrdArchive.h"
+#include "Logger.h"
+#include <QFile>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[8] = { 'S', 'M', 'R', 'R', 'D', 0, 0, 0 };
+constexpr qint64 ROWS_ALIGNMENT = 64;
+
+} // namespace
+
+/**
+ * @brief File header, host byte order (archives never leave the device)
+ */
+struct RrdArchive::Header {
+    char magic[8];
+    quint32 version;
+    quint32 resolutionCount;
+    struct {
+        quint32 stepSec;
+        quint32 rows;
+        quint64 offset;
+    } resolutions[MAX_RESOLUTIONS];
+};
+
+/**
+ * @brief One time bucket; all zero (count 0) means empty
+ */
+struct RrdArchive::Row {
+    qint64 bucket;          // timeSec / stepSec of the samples held
+    float min;
+    float max;
+    double sum;
+    quint32 count;
+    quint32 reserved;
+};
+
+RrdArchive::RrdArchive(const QVector<Resolution>& resolutions)
+    : m_resolutions(resolutions)
+    , m_map(nullptr)
+    , m_mapSize(0)
+{
+    static_assert(sizeof(Row) == 32, "RrdArchive rows are 32 bytes on disk");
+    Q_ASSERT(!m_resolutions.isEmpty() && m_resolutions.size() <= MAX_RESOLUTIONS);
+
+    qint64 offset = (static_cast<qint64>(sizeof(Header)) + ROWS_ALIGNMENT - 1) / ROWS_ALIGNMENT * ROWS_ALIGNMENT;
+    for (const Resolution& resolution : m_resolutions) {
+        m_offsets.append(offset);
+        offset += static_cast<qint64>(resolution.rows) * static_cast<qint64>(sizeof(Row));
+    }
+}
+
+RrdArchive::~RrdArchive()
+{
+    close();
+}
+
+bool RrdArchive::open(const QString& path)
+{
+    close();
+
+    const QByteArray fileName = QFile::encodeName(path);
+    const int fd = ::open(fileName.constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_WARNING("RrdArchive: cannot open %1: %2", path, QString::fromLocal8Bit(strerror(errno)));
+        return false;
+    }
+
+    const qint64 size = fileSize();
+
+    auto mapFile = [this, fd, size]() {
+        void* map = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        m_map = static_cast<char*>(map);
+        m_mapSize = size;
+        return true;
+    };
+
+    struct stat info;
+    const bool sizeMatches = fstat(fd, &info) == 0 && info.st_size == size;
+
+    bool ok = sizeMatches && mapFile();
+    if (ok && !headerMatches()) {
+        LOG_WARNING("RrdArchive: %1 has a different layout, starting it over", path);
+        close();
+        ok = false;
+    }
+    if (!ok) {
+        ok = initialize(fd) && mapFile();
+    }
+
+    // The mapping keeps the file referenced
+    ::close(fd);
+
+    if (!ok) {
+        LOG_WARNING("RrdArchive: cannot map %1", path);
+        close();
+    }
+    return ok;
+}
+
+void RrdArchive::close()
+{
+    if (m_map) {
+        munmap(m_map, static_cast<size_t>(m_mapSize));
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
+}
+
+void RrdArchive::append(double value, qint64 timeSec)
+{
+    if (!m_map || timeSec < 0) {
+        return;
+    }
+
+    const float sample = static_cast<float>(value);
+
+    for (int i = 0; i < m_resolutions.size(); ++i) {
+        const Resolution& resolution = m_resolutions.at(i);
+        const qint64 bucket = timeSec / resolution.stepSec;
+        Row& row = rows(i)[bucket % resolution.rows];
+
+        // The slot still holds a bucket from one lap ago (or nothing)
+        if (row.bucket != bucket || row.count == 0) {
+            row.min = sample;
+            row.max = sample;
+            row.sum = 0.0;
+            row.count = 0;
+            row.bucket = bucket;
+        }
+
+        row.min = qMin(row.min, sample);
+        row.max = qMax(row.max, sample);
+        row.sum += value;
+        ++row.count;
+    }
+}
+
+QVector<RrdArchive::Point> RrdArchive::read(qint64 rangeSec, qint64 nowSec, int maxPoints) const
+{
+    if (!m_map || rangeSec <= 0 || maxPoints <= 0) {
+        return {};
+    }
+
+    // Finest resolution whose ring spans the range, else the coarsest
+    int index = m_resolutions.size() - 1;
+    for (int i = 0; i < m_resolutions.size(); ++i) {
+        const Resolution& resolution = m_resolutions.at(i);
+        if (static_cast<qint64>(resolution.stepSec) * resolution.rows >= rangeSec) {
+            index = i;
+            break;
+        }
+    }
+
+    const Resolution& resolution = m_resolutions.at(index);
+    const Row* table = rows(index);
+    const qint64 step = resolution.stepSec;
+    const qint64 buckets = qMin<qint64>(resolution.rows, (rangeSec + step - 1) / step);
+    const qint64 firstBucket = nowSec / step - buckets + 1;
+    const int points = static_cast<int>(qMin<qint64>(maxPoints, buckets));
+
+    QVector<Point> result(points);
+
+    for (int p = 0; p < points; ++p) {
+        // Spread the buckets evenly over the points
+        const qint64 from = firstBucket + buckets * p / points;
+        const qint64 to = firstBucket + buckets * (p + 1) / points;
+
+        Point& point = result[p];
+        point.timeSec = from * step;
+
+        double sum = 0.0;
+        quint64 count = 0;
+
+        for (qint64 bucket = from; bucket < to; ++bucket) {
+            const Row& row = table[((bucket % resolution.rows) + resolution.rows) % resolution.rows];
+            if (row.bucket != bucket || row.count == 0) {
+                continue;
+            }
+
+            point.min = (count == 0) ? row.min : qMin<double>(point.min, row.min);
+            point.max = (count == 0) ? row.max : qMax<double>(point.max, row.max);
+            sum += row.sum;
+            count += row.count;
+        }
+
+        if (count > 0) {
+            point.avg = sum / count;
+            point.valid = true;
+        }
+    }
+
+    return result;
+}
+
+qint64 RrdArchive::fileSize() const
+{
+    const Resolution& last = m_resolutions.last();
+    return m_offsets.last() + static_cast<qint64>(last.rows) * static_cast<qint64>(sizeof(Row));
+}
+
+bool RrdArchive::headerMatches() const
+{
+    const Header* header = reinterpret_cast<const Header*>(m_map);
+
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+        || header->version != FORMAT_VERSION
+        || header->resolutionCount != static_cast<quint32>(m_resolutions.size())) {
+        return false;
+    }
+
+    for (int i = 0; i < m_resolutions.size(); ++i) {
+        if (header->resolutions[i].stepSec != static_cast<quint32>(m_resolutions.at(i).stepSec)
+            || header->resolutions[i].rows != static_cast<quint32>(m_resolutions.at(i).rows)
+            || header->resolutions[i].offset != static_cast<quint64>(m_offsets.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RrdArchive::initialize(int fd)
+{
+    // Truncating to 0 first makes every row read back as zeros (empty)
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, fileSize()) != 0) {
+        return false;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    header.version = FORMAT_VERSION;
+    header.resolutionCount = static_cast<quint32>(m_resolutions.size());
+    for (int i = 0; i < m_resolutions.size(); ++i) {
+        header.resolutions[i].stepSec = static_cast<quint32>(m_resolutions.at(i).stepSec);
+        header.resolutions[i].rows = static_cast<quint32>(m_resolutions.at(i).rows);
+        header.resolutions[i].offset = static_cast<quint64>(m_offsets.at(i));
+    }
+
+    // Layout first, magic last: a file cut short here is recreated next time
+    if (pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) || fdatasync(fd) != 0) {
+        return false;
+    }
+    if (pwrite(fd, MAGIC, sizeof(MAGIC), 0) != static_cast<ssize_t>(sizeof(MAGIC))) {
+        return false;
+    }
+    return fdatasync(fd) == 0;
+}
+
+RrdArchive::Row* RrdArchive::rows(int resolution) const
+{
+    return reinterpret_cast<Row*>(m_map + m_offsets.at(resolution));
+}
@@ -0,0 +1,107 @@
+/**
+ * ============================================
+ * File: src/model/RrdArchive.h
+ * Description: Round-robin time-series file with consolidated resolutions
+ * ============================================
+ */
+
+#ifndef RRDARCHIVE_H
+#define RRDARCHIVE_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @class RrdArchive
+ * @brief One metric's history in a fixed-size, memory-mapped file
+ *
+ * The file holds one ring of rows per resolution (e.g. 1 s x 1 h,
+ * 10 s x 24 h, 5 min x 30 d). A row covers one step-sized time bucket and
+ * keeps the min, max, sum and count of the samples that fell into it.
+ * A sample for bucket b goes to row b % rows: if that row still holds an
+ * older bucket it is restarted, otherwise the sample is folded in. So an
+ * append is a handful of stores per resolution, with no search, no
+ * allocation and no syscall.
+ *
+ * Crash safety comes from the layout rather than from syncing:
+ * - The file never changes size and rows are written in place through a
+ *   shared mapping, so the kernel writes dirty pages back on its own,
+ *   even after the process died. A power cut loses at most the last
+ *   writeback interval.
+ * - Each row records its own bucket number, so there is no head pointer
+ *   to get out of step with the data. Rows outside a read window, left
+ *   from before a gap or a clock jump, are simply ignored.
+ * - The header is written and synced once, at creation, with the magic
+ *   last. A file whose header does not match is recreated empty.
+ *
+ * Not thread-safe; see HistoryStore for the locking.
+ */
+class RrdArchive
+{
+public:
+    /**
+     * @brief One resolution: bucket length and ring size
+     */
+    struct Resolution {
+        int stepSec;
+        int rows;
+    };
+
+    /**
+     * @brief Consolidated value of one or more buckets
+     */
+    struct Point {
+        qint64 timeSec = 0;     // Start of the first bucket
+        double min = 0.0;
+        double max = 0.0;
+        double avg = 0.0;
+        bool valid = false;     // false = no samples in this span
+    };
+
+    explicit RrdArchive(const QVector<Resolution>& resolutions);
+    ~RrdArchive();
+
+    RrdArchive(const RrdArchive&) = delete;
+    RrdArchive& operator=(const RrdArchive&) = delete;
+
+    /**
+     * @brief Map an existing archive, or create it if missing or incompatible
+     */
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_map != nullptr; }
+
+    /**
+     * @brief Fold one sample into every resolution
+     */
+    void append(double value, qint64 timeSec);
+
+    /**
+     * @brief Consolidated history of the last rangeSec seconds
+     * @param nowSec End of the window
+     * @param maxPoints Points to return at most; buckets are merged to fit
+     * @return Oldest first; uses the finest resolution that spans the range
+     */
+    QVector<Point> read(qint64 rangeSec, qint64 nowSec, int maxPoints) const;
+
+private:
+    struct Header;
+    struct Row;
+
+    qint64 fileSize() const;
+    bool headerMatches() const;
+    bool initialize(int fd);
+    Row* rows(int resolution) const;
+
+private:
+    QVector<Resolution> m_resolutions;
+    QVector<qint64> m_offsets;      // File offset of each resolution's rows
+    char* m_map;
+    qint64 m_mapSize;
+
+    // Constants
+    static constexpr int MAX_RESOLUTIONS = 4;
+    static constexpr quint32 FORMAT_VERSION = 1;
+};
+
+#endif // RRDARCHIVE_H
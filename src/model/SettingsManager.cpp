@@ -5,6 +5,8 @@
  * ============================================
  */
 
+#define LOG_CATEGORY LogCategory::Ui
+
 #include "SettingsManager.h"
 #include "FileReader.h"
 #include "Constants.h"
@@ -18,6 +20,7 @@ SettingsManager::SettingsManager(QObject *parent)
     , m_updateInterval(App::Interval::NORMAL / 1000) // Convert ms to seconds
     , m_darkMode(true)
     , m_soundAlert(false)
+    , m_logLevel(LOG_DEFAULT_LEVEL)
     , m_cpuWarnThreshold(App::Threshold::CPU_WARNING)
     , m_cpuCritThreshold(App::Threshold::CPU_CRITICAL)
     , m_ramWarnThreshold(App::Threshold::RAM_WARNING)
@@ -33,7 +36,7 @@ SettingsManager::SettingsManager(QObject *parent)
     // Add initial log
     addLog("INFO", "System Monitor started");
 
-    LOG_INFO(QString("SettingsManager initialized - hostname: %1").arg(m_hostname));
+    LOG_INFO("SettingsManager initialized - hostname: %1", m_hostname);
 }
 
 QString SettingsManager::uptime() const
@@ -73,6 +76,15 @@ void SettingsManager::setSoundAlert(bool enabled)
     }
 }
 
+void SettingsManager::setLogLevel(int level)
+{
+    if (m_logLevel != level && level >= LOG_LEVEL_OFF && level <= LOG_LEVEL_DEBUG) {
+        m_logLevel = level;
+        addLog("INFO", QString("Log level set to %1").arg(level));
+        emit settingsChanged();
+    }
+}
+
 void SettingsManager::setCpuWarnThreshold(int threshold)
 {
     if (m_cpuWarnThreshold != threshold && threshold >= 0 && threshold <= 100) {
@@ -132,6 +144,7 @@ void SettingsManager::save()
     settings.setValue("updateInterval", m_updateInterval);
     settings.setValue("darkMode", m_darkMode);
     settings.setValue("soundAlert", m_soundAlert);
+    settings.setValue("logLevel", m_logLevel);
 
     // Save warning thresholds
     settings.setValue("cpuWarnThreshold", m_cpuWarnThreshold);
@@ -142,7 +155,7 @@ void SettingsManager::save()
 
     addLog("INFO", "Settings saved successfully");
 
-    LOG_INFO("Settings saved to: " + settings.fileName());
+    LOG_INFO("Settings saved to: %1", settings.fileName());
 }
 
 void SettingsManager::load()
@@ -153,12 +166,13 @@ void SettingsManager::load()
     m_updateInterval = settings.value("updateInterval", 2).toInt();
     m_darkMode = settings.value("darkMode", true).toBool();
     m_soundAlert = settings.value("soundAlert", false).toBool();
+    m_logLevel = qBound(LOG_LEVEL_OFF, settings.value("logLevel", LOG_DEFAULT_LEVEL).toInt(), LOG_LEVEL_DEBUG);
 
     m_cpuWarnThreshold = settings.value("cpuWarnThreshold", App::Threshold::CPU_WARNING).toInt();
     m_cpuCritThreshold = settings.value("cpuCritThreshold", App::Threshold::CPU_CRITICAL).toInt();
     m_ramWarnThreshold = settings.value("ramWarnThreshold", App::Threshold::RAM_WARNING).toInt();
     
-    LOG_INFO("Settings loaded from: " + settings.fileName());
+    LOG_INFO("Settings loaded from: %1", settings.fileName());
 }
 
 void SettingsManager::reboot()
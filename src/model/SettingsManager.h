@@ -32,6 +32,7 @@ class SettingsManager : public QObject
     Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval NOTIFY settingsChanged)
     Q_PROPERTY(bool darkMode READ darkMode WRITE setDarkMode NOTIFY settingsChanged)
     Q_PROPERTY(bool soundAlert READ soundAlert WRITE setSoundAlert NOTIFY settingsChanged)
+    Q_PROPERTY(int logLevel READ logLevel WRITE setLogLevel NOTIFY settingsChanged)
 
     // Warning thresholds
     Q_PROPERTY(int cpuWarnThreshold READ cpuWarnThreshold WRITE setCpuWarnThreshold NOTIFY settingsChanged)
@@ -57,6 +58,7 @@ public:
     int updateInterval() const { return m_updateInterval; }
     bool darkMode() const { return m_darkMode; }
     bool soundAlert() const { return m_soundAlert; }
+    int logLevel() const { return m_logLevel; }
     
     // === Threshold Getters ===
     int cpuWarnThreshold() const { return m_cpuWarnThreshold; }
@@ -77,6 +79,7 @@ public:
     void setUpdateInterval(int interval);
     void setDarkMode(bool enabled);
     void setSoundAlert(bool enabled);
+    void setLogLevel(int level);
     void setCpuWarnThreshold(int threshold);
     void setCpuCritThreshold(int threshold);
     void setRamWarnThreshold(int threshold);
@@ -108,6 +111,7 @@ private:
     int m_updateInterval;
     bool m_darkMode;
     bool m_soundAlert;
+    int m_logLevel;             // Runtime log level (LOG_LEVEL_*)
 
     // System info (cached)
     QString m_hostname;
@@ -5,30 +5,37 @@
  * ============================================
  */
 
+#define LOG_CATEGORY LogCategory::Storage
+
  #include "StorageMonitor.h"
  #include "FileReader.h"
  #include "Constants.h"
  #include "Logger.h"
  #include <sys/statvfs.h>
+ #include <QDateTime>
  #include <QDir>
+ #include <QVariantMap>
+ #include <algorithm>
+ #include <cstring>
 
 StorageMonitor::StorageMonitor(QObject *parent)
     : QObject(parent)
     , m_mountPoint("/")
-    , m_rootTotal("0GB")
-    , m_rootUsed("0GB")
-    , m_rootFree("0GB")
+    , m_rootTotal(0)
+    , m_rootUsed(0)
+    , m_rootFree(0)
     , m_swapUsage(0)
-    , m_swapTotal("0M")
-    , m_swapUsed("0M")
-    , m_swapFree("0M")
-    , m_ioRead("0.0 MB/s")
-    , m_ioWrite("0.0 MB/s")
+    , m_swapTotal(0)
+    , m_swapUsed(0)
+    , m_swapFree(0)
+    , m_ioRead(0.0)
+    , m_ioWrite(0.0)
+    , m_ioSeries(App::History::SERIES_RETENTION_SEC, App::History::SERIES_RATE_QUANTUM)
+    , m_diskStatsFile(QString::fromLatin1(App::Path::PROC_DISKSTATS))
 {
-    m_ioHistory.reserve(MAX_IO_HISTORY);
     m_blockDevice = findBlockDevice();
 
-    LOG_INFO(QString("StorageMonitor initialized - mount: %1, device: %2").arg(m_mountPoint, m_blockDevice));
+    LOG_INFO("StorageMonitor initialized - mount: %1, device: %2", m_mountPoint, m_blockDevice);
 }
 
 int StorageMonitor::parseUsage()
@@ -68,7 +75,7 @@ void StorageMonitor::setMountPoint(const QString &path)
 {
     if(m_mountPoint != path) {
         m_mountPoint = path;
-        LOG_INFO(QString("Mount point changed to: %1").arg(path));
+        LOG_INFO("Mount point changed to: %1", path);
     }
 }
 
@@ -77,50 +84,25 @@ void StorageMonitor::updateRootPartition()
     struct statvfs stat;
 
     if (statvfs(m_mountPoint.toUtf8().constData(), &stat) != 0) {
-        m_rootTotal = "N/A";
-        m_rootUsed = "N/A";
-        m_rootFree = "N/A";
+        m_rootTotal = 0;
+        m_rootUsed = 0;
+        m_rootFree = 0;
         return;
     }
 
     // Calculate sizes in bytes
     unsigned long long total = stat.f_blocks * stat.f_frsize;
     unsigned long long available = stat.f_bavail * stat.f_frsize;
-    unsigned long long used = total - available;
 
-    // Format to human-readable strings
-    m_rootTotal = formatSize(total);
-    m_rootUsed = formatSize(used);
-    m_rootFree = formatSize(available);
+    m_rootTotal = total;
+    m_rootUsed = total - available;
+    m_rootFree = available;
 }
 
-void StorageMonitor::updateSwap()
+void StorageMonitor::updateSwap(const MemoryMonitor::MemInfoSnapshot &memInfo)
 {
-    QString content = FileReader::readAll(App::Path::PROC_MEMINFO);
-
-    if (content.isEmpty()) {
-        return;
-    }
-
-    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
-
-    unsigned long long swapTotal = 0;
-    unsigned long long swapFree = 0;
-
-    for (const QString &line: lines) {
-        if (line.startsWith("SwapTotal:")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                swapTotal = parts[1].toULongLong(); // in kB
-            }
-        }
-        else if (line.startsWith("SwapFree:")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                swapFree = parts[1].toULongLong(); // in kB
-            }
-        }
-    }
+    unsigned long long swapTotal = memInfo.swapTotal; // in kB
+    unsigned long long swapFree = memInfo.swapFree;   // in kB
 
     // Calculate swap usage
     unsigned long long swapUsed = swapTotal - swapFree;
@@ -132,119 +114,197 @@ void StorageMonitor::updateSwap()
         m_swapUsage = 0;
     }
 
-    // Convert kB to bytes for formatting
-    m_swapTotal = formatSize(swapTotal * 1024);
-    m_swapUsed = formatSize(swapUsed * 1024);
-    m_swapFree = formatSize(swapFree * 1024);
+    // Convert kB to bytes
+    m_swapTotal = swapTotal * 1024;
+    m_swapUsed = swapUsed * 1024;
+    m_swapFree = swapFree * 1024;
 }
 
 void StorageMonitor::updateIoStats()
 {
-    if (m_blockDevice.isEmpty()) {
+    if (!m_diskStatsFile.read(m_diskStatsBuffer)) {
         return;
     }
 
-    IoStats currentStats = readIoStats();
+    // Rates use the real elapsed time, not the nominal timer interval
+    qint64 deltaMs = 0;
+    if (m_ioTimer.isValid()) {
+        deltaMs = m_ioTimer.restart();
+    }
+    else {
+        m_ioTimer.start();
+    }
 
-    // First call - initialize previous stats
-    if (m_prevIoStats.sectorsRead == 0 && m_prevIoStats.sectorsWritten == 0) {
-        m_prevIoStats = currentStats;
-        m_ioRead = "0.0 MB/s";
-        m_ioWrite = "0.0 MB/s";
-        return;
+    for (DiskDevice& device : m_devices) {
+        device.seen = false;
     }
 
-    // Calculate deltas
-    unsigned long long deltaRead = currentStats.sectorsRead - m_prevIoStats.sectorsRead;
-    unsigned long long deltaWrite = currentStats.sectorsWritten - m_prevIoStats.sectorsWritten;
+    parseDiskStats(m_diskStatsBuffer.constData(), m_diskStatsBuffer.size(),
+                   [&](QByteArrayView name, const DiskCounters& counters) {
+        // Loop and RAM disks only add noise
+        if (name.startsWith("loop") || name.startsWith("ram")) {
+            return;
+        }
 
-    // Update previous stats
-    m_prevIoStats = currentStats;
+        DiskDevice& device = deviceFor(name);
+        device.seen = true;
+        updateDeviceRates(device, counters, deltaMs);
+    });
+
+    // Drop devices that went away (e.g. an unplugged USB disk)
+    m_devices.erase(std::remove_if(m_devices.begin(), m_devices.end(),
+                                   [](const DiskDevice& device) { return !device.seen; }),
+                    m_devices.end());
+
+    // Single-device figures follow the primary block device
+    const DiskDevice* primary = nullptr;
+    for (const DiskDevice& device : std::as_const(m_devices)) {
+        if (device.name == m_blockDevice) {
+            primary = &device;
+            break;
+        }
+    }
 
-    // Calculate rates (assuming 2-second interval)
-    double readRate = calculateIoRate(deltaRead);
-    double writeRate = calculateIoRate(deltaWrite);
-    m_ioRead = QString::number(readRate, 'f', 1) + " MB/s";
-    m_ioWrite = QString::number(writeRate, 'f', 1) + " MB/s";
+    if (!primary || deltaMs <= 0) {
+        m_ioRead = 0.0;
+        m_ioWrite = 0.0;
+        return;
+    }
 
-    // Add combined I/O to history
-    int combinedIo = static_cast<int>(readRate + writeRate);
-    m_ioHistory.append(combinedIo);
+    m_ioRead = primary->rates.readBytesPerSec;
+    m_ioWrite = primary->rates.writeBytesPerSec;
 
-    // Keep only last MAX_IO_HISTORY values
-    while (m_ioHistory.size() > MAX_IO_HISTORY) {
-        m_ioHistory.removeFirst();
-    }
+    // Add combined I/O to history (MB/s)
+    constexpr double MB = 1024.0 * 1024.0;
+    int combinedIo = static_cast<int>((m_ioRead + m_ioWrite) / MB);
+    m_ioHistory.push(combinedIo);
+    m_ioSeries.append(QDateTime::currentSecsSinceEpoch(), m_ioRead + m_ioWrite);
 }
 
-QVariantList StorageMonitor::getIoHistory() const
+bool StorageMonitor::updateIoBaseline()
 {
-    QVariantList result;
-    result.reserve(m_ioHistory.size());
+    if (!m_diskStatsFile.read(m_diskStatsBuffer)) {
+        return false;
+    }
 
-    for (int io : m_ioHistory) {
-        result.append(io);
+    bool measured = false;
+    qint64 deltaMs = 0;
+    if (m_ioTimer.isValid()) {
+        deltaMs = m_ioTimer.restart();
     }
-    
-    return result;
+    else {
+        m_ioTimer.start();
+    }
+
+    parseDiskStats(m_diskStatsBuffer.constData(), m_diskStatsBuffer.size(),
+                   [&](QByteArrayView name, const DiskCounters& counters) {
+        if (name.startsWith("loop") || name.startsWith("ram")) {
+            return;
+        }
+
+        DiskDevice& device = deviceFor(name);
+
+        // Same counters as updateIoStats(), primary device only
+        if (device.name == m_blockDevice && device.primed && deltaMs > 0
+            && counters.sectorsRead >= device.prev.sectorsRead
+            && counters.sectorsWritten >= device.prev.sectorsWritten) {
+            const double sectorsToRate = static_cast<double>(SECTOR_SIZE) * 1000.0 / deltaMs;
+            m_ioRead = (counters.sectorsRead - device.prev.sectorsRead) * sectorsToRate;
+            m_ioWrite = (counters.sectorsWritten - device.prev.sectorsWritten) * sectorsToRate;
+            measured = true;
+        }
+
+        device.prev = counters;
+        device.primed = true;
+    });
+
+    if (measured) {
+        m_ioSeries.append(QDateTime::currentSecsSinceEpoch(), m_ioRead + m_ioWrite);
+    }
+    return measured;
 }
 
-QString StorageMonitor::formatSize(unsigned long long bytes)
+StorageMonitor::DiskDevice &StorageMonitor::deviceFor(QByteArrayView name)
 {
-    constexpr double KB = 1024.0;
-    constexpr double MB = KB * 1024.0;
-    constexpr double GB = MB * 1024.0;
-    constexpr double TB = GB * 1024.0;
-
-    if (bytes >= TB) {
-        return QString::number(bytes / TB, 'f', 1) + " TB";
-    } 
-    else if (bytes >= GB) {
-        return QString::number(bytes / GB, 'f', 1) + " GB";
-    } 
-    else if (bytes >= MB) {
-        return QString::number(bytes / MB, 'f', 1) + " MB";
-    } 
-    else if (bytes >= KB) {
-        return QString::number(bytes / KB, 'f', 1) + " KB";
-    }
-     else {
-        return QString::number(bytes) + " B";
+    for (DiskDevice& device : m_devices) {
+        if (device.key == name) {
+            return device;
+        }
     }
+
+    // New device: the only place that allocates
+    DiskDevice device;
+    device.key = name.toByteArray();
+    device.name = QString::fromLatin1(device.key);
+    device.partition = FileReader::fileExists(QString("/sys/class/block/%1/partition").arg(device.name));
+
+    m_devices.append(device);
+    return m_devices.last();
 }
 
-StorageMonitor::IoStats StorageMonitor::readIoStats()
+void StorageMonitor::updateDeviceRates(DiskDevice &device, const DiskCounters &current, qint64 deltaMs)
 {
-    IoStats stats;
-
-    QString statPath = QString("/sys/block/%1/stat").arg(m_blockDevice);
-    QString statStr = FileReader::readFirstLine(statPath);
+    DiskRates& rates = device.rates;
+    rates.inFlight = static_cast<int>(current.inFlight);
 
-    if (statStr.isEmpty()) {
-        return stats;
+    if (!device.primed || deltaMs <= 0) {
+        device.prev = current;
+        device.primed = true;
+        return;
     }
 
-    // Format: reads reads_merged sectors_read ms_reading writes writes_merged sectors_written ...
-    QStringList parts = statStr.split(' ', Qt::SkipEmptyParts);
+    // A counter going backwards means the device was re-created
+    auto delta = [](unsigned long long now, unsigned long long before) {
+        return now >= before ? now - before : 0ULL;
+    };
 
-    if (parts.size() >= 7) {
-        stats.sectorsRead = parts[2].toULongLong();
-        stats.sectorsWritten = parts[6].toULongLong();
-    }
+    const DiskCounters& prev = device.prev;
+    const unsigned long long reads = delta(current.readsCompleted, prev.readsCompleted);
+    const unsigned long long writes = delta(current.writesCompleted, prev.writesCompleted);
+    const unsigned long long msReading = delta(current.msReading, prev.msReading);
+    const unsigned long long msWriting = delta(current.msWriting, prev.msWriting);
+    const unsigned long long msIo = delta(current.msIo, prev.msIo);
+    const double seconds = deltaMs / 1000.0;
+
+    rates.readBytesPerSec = delta(current.sectorsRead, prev.sectorsRead) * static_cast<double>(SECTOR_SIZE) / seconds;
+    rates.writeBytesPerSec = delta(current.sectorsWritten, prev.sectorsWritten) * static_cast<double>(SECTOR_SIZE) / seconds;
+    rates.readIops = reads / seconds;
+    rates.writeIops = writes / seconds;
+    rates.awaitMs = (reads + writes) > 0 ? static_cast<double>(msReading + msWriting) / (reads + writes) : 0.0;
+    rates.utilization = qMin(100.0, msIo * 100.0 / deltaMs);
 
-    return stats;
+    device.history.push(static_cast<int>((rates.readBytesPerSec + rates.writeBytesPerSec) / 1024.0));
+
+    device.prev = current;
 }
 
-double StorageMonitor::calculateIoRate(unsigned long long deltaSectors)
+QVariantList StorageMonitor::getDeviceStats() const
 {
-    // Sector size is 512 bytes
-    unsigned long long bytes = deltaSectors * SECTOR_SIZE;
+    QVariantList result;
+    result.reserve(m_devices.size());
+
+    for (const DiskDevice& device : m_devices) {
+        QVariantList history;
+        history.reserve(device.history.size());
+        for (int value : device.history) {
+            history.append(value);
+        }
 
-    // Assuming ~1 second update interval
-    constexpr double interval = 1.0; // seconds
-    double mbPerSecond = (bytes / (1024.0 * 1024.0)) / interval;
+        QVariantMap entry;
+        entry["name"] = device.name;
+        entry["partition"] = device.partition;
+        entry["readKBs"] = device.rates.readBytesPerSec / 1024.0;
+        entry["writeKBs"] = device.rates.writeBytesPerSec / 1024.0;
+        entry["readIops"] = device.rates.readIops;
+        entry["writeIops"] = device.rates.writeIops;
+        entry["awaitMs"] = device.rates.awaitMs;
+        entry["inFlight"] = device.rates.inFlight;
+        entry["utilization"] = device.rates.utilization;
+        entry["history"] = history;
+        result.append(entry);
+    }
 
-    return mbPerSecond;
+    return result;
 }
 
 QString StorageMonitor::findBlockDevice()
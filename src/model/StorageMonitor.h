@@ -12,6 +12,14 @@
 #include <QString>
 #include <QVector>
 #include <QVariantList>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <cstring>
+#include "FileReader.h"
+#include "MemoryMonitor.h"
+#include "RingBuffer.h"
+#include "CompressedSeries.h"
+#include "Constants.h"
 
 /**
  * @class StorageMonitor
@@ -19,8 +27,8 @@
  * 
  * Reads data from:
  * - statvfs() for disk usage
- * - /proc/meminfo for swap
- * - /sys/block/device/stat for I/O statistics
+ * - /proc/meminfo for swap (via MemoryMonitor's snapshot)
+ * - /proc/diskstats for per-device I/O statistics
  */
 class StorageMonitor : public QObject 
 {
@@ -28,11 +36,44 @@ class StorageMonitor : public QObject
 
 public:
     /**
-     * @brief I/O statistics structure
+     * @brief Raw counters of one /proc/diskstats line
      */
-    struct IoStats {
+    struct DiskCounters {
+        unsigned long long readsCompleted = 0;
         unsigned long long sectorsRead = 0;
+        unsigned long long msReading = 0;
+        unsigned long long writesCompleted = 0;
         unsigned long long sectorsWritten = 0;
+        unsigned long long msWriting = 0;
+        unsigned long long inFlight = 0;
+        unsigned long long msIo = 0;
+    };
+
+    /**
+     * @brief Rates of one block device over the last interval
+     */
+    struct DiskRates {
+        double readBytesPerSec = 0.0;
+        double writeBytesPerSec = 0.0;
+        double readIops = 0.0;
+        double writeIops = 0.0;
+        double awaitMs = 0.0;        // Average time per completed request
+        int inFlight = 0;            // Requests currently queued or in service
+        double utilization = 0.0;    // % of the interval the device was busy
+    };
+
+    /**
+     * @brief One block device or partition tracked from /proc/diskstats
+     */
+    struct DiskDevice {
+        QString name;
+        QByteArray key;              // Name as bytes, matched without allocating
+        bool partition = false;
+        bool seen = false;           // Present in the last pass
+        bool primed = false;         // prev holds a previous sample
+        DiskCounters prev;
+        DiskRates rates;
+        RingBuffer<int, App::History::CHART_SAMPLES> history;  // Combined throughput, KB/s
     };
 
     explicit StorageMonitor(QObject *parent = nullptr);
@@ -61,39 +102,77 @@ public:
      */
     void updateRootPartition();
 
-    // Root partition getters
-    QString getRootTotal() const { return m_rootTotal;}
-    QString getRootUsed() const { return m_rootUsed;}
-    QString getRootFree() const { return m_rootFree;}
+    // Root partition getters, in bytes
+    unsigned long long getRootTotal() const { return m_rootTotal; }
+    unsigned long long getRootUsed() const { return m_rootUsed; }
+    unsigned long long getRootFree() const { return m_rootFree; }
 
     // === Swap ===
 
     /**
      * @brief Update swap statistics
+     * @param memInfo Snapshot already read by MemoryMonitor this tick
      */
-    void updateSwap();
+    void updateSwap(const MemoryMonitor::MemInfoSnapshot& memInfo);
 
-    // Swap getters
+    // Swap getters, in bytes
     int getSwapUsage() const { return m_swapUsage; }
-    QString getSwapTotal() const { return m_swapTotal; }
-    QString getSwapUsed() const { return m_swapUsed; }
-    QString getSwapFree() const { return m_swapFree; }
+    unsigned long long getSwapTotal() const { return m_swapTotal; }
+    unsigned long long getSwapUsed() const { return m_swapUsed; }
+    unsigned long long getSwapFree() const { return m_swapFree; }
 
     // === I/O Statistics ===
     
     /**
-     * @brief Update I/O statistics
+     * @brief Update I/O statistics of every device from /proc/diskstats
      */
     void updateIoStats();
 
-    // I/O getters
-    QString getIoRead() const {return m_ioRead; }
-    QString getIoWrite() const {return m_ioWrite; }
+    /**
+     * @brief Move every device's counter baseline to /proc/diskstats now
+     *
+     * Cheap stand-in for updateIoStats() while no page shows I/O. Only the
+     * primary device's read/write rates are refreshed (over the whole idle
+     * interval, for the long-range archive); no per-device rates or history.
+     *
+     * @return false if the primary device's rates could not be measured
+     */
+    bool updateIoBaseline();
+
+    // I/O getters (primary device), in bytes/s
+    double getIoRead() const { return m_ioRead; }
+    double getIoWrite() const { return m_ioWrite; }
 
     /**
      * @brief Get I/O history for charting
      */
-    QVariantList getIoHistory() const;
+    const RingBuffer<int, App::History::CHART_SAMPLES>& getIoHistory() const { return m_ioHistory; }
+
+    /**
+     * @brief Combined I/O (bytes/s, to 1 KB/s) over the last
+     *        SERIES_RETENTION_SEC, idle baselines included
+     */
+    const CompressedSeries& getIoSeries() const { return m_ioSeries; }
+
+    /**
+     * @brief All tracked block devices and partitions
+     */
+    const QVector<DiskDevice>& getDevices() const { return m_devices; }
+
+    /**
+     * @brief Per-device rates and history as a list of maps for QML
+     *
+     * Keys: name, partition, readKBs, writeKBs, readIops, writeIops,
+     * awaitMs, inFlight, utilization, history
+     */
+    QVariantList getDeviceStats() const;
+
+    /**
+     * @brief Parse /proc/diskstats content
+     * @param handler Called as handler(QByteArrayView name, const DiskCounters&)
+     */
+    template <typename Handler>
+    static void parseDiskStats(const char* data, qsizetype size, Handler&& handler);
 
     // === Temperature ===
 
@@ -105,19 +184,14 @@ public:
 
 private:
     /**
-     * @brief Format bytes to human-readable string
-     */
-    QString formatSize(unsigned long long bytes);
-
-    /**
-     * @brief Read I/O statistics from /sys/block
+     * @brief Find or add the device for a diskstats name
      */
-    IoStats readIoStats();
+    DiskDevice& deviceFor(QByteArrayView name);
 
     /**
-     * @brief Calculate I/O rate from sector delta
+     * @brief Compute rates of one device from its counter deltas
      */
-    double calculateIoRate(unsigned long long deltaSectors);
+    void updateDeviceRates(DiskDevice& device, const DiskCounters& current, qint64 deltaMs);
 
     /**
      * @brief Find the primary block device
@@ -128,27 +202,108 @@ private:
     // Mount point to monitor
     QString m_mountPoint;
 
-    // Root partition stats
-    QString m_rootTotal;
-    QString m_rootUsed;
-    QString m_rootFree;
+    // Root partition stats (bytes)
+    unsigned long long m_rootTotal;
+    unsigned long long m_rootUsed;
+    unsigned long long m_rootFree;
 
-    // Swap stats
+    // Swap stats (bytes)
     int m_swapUsage;
-    QString m_swapTotal;
-    QString m_swapUsed;
-    QString m_swapFree;
-
-    // I/O stats
-    IoStats m_prevIoStats;
-    QString m_ioRead;
-    QString m_ioWrite;
-    QVector<int> m_ioHistory;
+    unsigned long long m_swapTotal;
+    unsigned long long m_swapUsed;
+    unsigned long long m_swapFree;
+
+    // I/O stats (primary device, bytes/s)
+    double m_ioRead;
+    double m_ioWrite;
+    RingBuffer<int, App::History::CHART_SAMPLES> m_ioHistory;
+    CompressedSeries m_ioSeries;
     QString m_blockDevice;
 
+    // Every device in /proc/diskstats, in file order
+    QVector<DiskDevice> m_devices;
+    QElapsedTimer m_ioTimer;
+
+    // Descriptors kept open between ticks
+    ProcFileHandle m_diskStatsFile;
+    QByteArray m_diskStatsBuffer;
+
     // Constants
-    static constexpr int MAX_IO_HISTORY = 60;
     static constexpr int SECTOR_SIZE = 512;
 };
 
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+template <typename Handler>
+void StorageMonitor::parseDiskStats(const char* data, qsizetype size, Handler&& handler)
+{
+    const char* p = data;
+    const char* end = data + size;
+
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        // Format: major minor name reads merged sectors ms writes merged sectors ms
+        //         in_flight ms_io ms_weighted [discards... flushes...]
+        const char* q = p;
+        auto skipBlanks = [&]() {
+            while (q < lineEnd && *q == ' ') {
+                ++q;
+            }
+        };
+        auto skipField = [&]() {
+            skipBlanks();
+            while (q < lineEnd && *q != ' ') {
+                ++q;
+            }
+        };
+
+        skipField();    // major
+        skipField();    // minor
+        skipBlanks();
+
+        const char* nameStart = q;
+        while (q < lineEnd && *q != ' ') {
+            ++q;
+        }
+        const QByteArrayView name(nameStart, q - nameStart);
+
+        unsigned long long fields[10] = {};
+        int count = 0;
+
+        while (count < 10) {
+            skipBlanks();
+            const char* start = q;
+            while (q < lineEnd && *q >= '0' && *q <= '9') {
+                fields[count] = fields[count] * 10 + static_cast<unsigned long long>(*q - '0');
+                ++q;
+            }
+            if (q == start) {
+                break;
+            }
+            ++count;
+        }
+
+        if (!name.isEmpty() && count == 10) {
+            DiskCounters counters;
+            counters.readsCompleted = fields[0];
+            counters.sectorsRead = fields[2];
+            counters.msReading = fields[3];
+            counters.writesCompleted = fields[4];
+            counters.sectorsWritten = fields[6];
+            counters.msWriting = fields[7];
+            counters.inFlight = fields[8];
+            counters.msIo = fields[9];
+            handler(name, counters);
+        }
+
+        p = lineEnd + 1;
+    }
+}
+
 #endif // STORAGEMONITOR_H
\ No newline at end of file
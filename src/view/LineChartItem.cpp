@@ -0,0 +1,593 @@
+/**
+ * ============================================
+ * File: src/view/LineChartItem.cpp
+ * Description: LineChartItem implementation
+ * ============================================
+ */
+
+#include "LineChartItem.h"
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGRenderNode>
+#include <QSGRendererInterface>
+#include <QtMath>
+#include <algorithm>
+
+namespace {
+
+QSGGeometryNode* createGeometryNode(QSGGeometry::DrawingMode mode)
+{
+    QSGGeometry* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(mode);
+    geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+
+    QSGGeometryNode* node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGFlatColorMaterial);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+void setNodeColor(QSGGeometryNode* node, const QColor& color)
+{
+    static_cast<QSGFlatColorMaterial*>(node->material())->setColor(color);
+    node->markDirty(QSGNode::DirtyMaterial);
+}
+
+/**
+ * @brief RHI backends: grid, fill and line as geometry nodes, back to front
+ */
+class ChartGeometryNode : public QSGNode
+{
+public:
+    ChartGeometryNode()
+        : m_grid(createGeometryNode(QSGGeometry::DrawLines))
+        , m_fill(createGeometryNode(QSGGeometry::DrawTriangleStrip))
+        , m_line(createGeometryNode(QSGGeometry::DrawLineStrip))
+    {
+        appendChildNode(m_grid);
+        appendChildNode(m_fill);
+        appendChildNode(m_line);
+    }
+
+    void sync(const LineChartItem& item, int shift, bool colorsDirty, bool gridDirty)
+    {
+        const int count = item.curvePointCount();
+
+        // Line strip
+        QSGGeometry* line = m_line->geometry();
+        int lineShift = shift;
+        if (line->vertexCount() != count) {
+            line->allocate(count);
+            lineShift = -1;
+        }
+        if (lineShift != 0 || line->lineWidth() != item.lineWidth()) {
+            line->setLineWidth(item.lineWidth());
+            item.writeCurve(line->vertexDataAsPoint2D(), 1, lineShift);
+            m_line->markDirty(QSGNode::DirtyGeometry);
+        }
+
+        // Fill strip: path vertices on even indices, baseline on odd ones
+        QSGGeometry* fill = m_fill->geometry();
+        const int fillCount = item.showFill() ? count * 2 : 0;
+        int fillShift = shift;
+        if (fill->vertexCount() != fillCount) {
+            fill->allocate(fillCount);
+            fillShift = -1;
+        }
+        if (fillCount > 0 && fillShift != 0) {
+            QSGGeometry::Point2D* vertices = fill->vertexDataAsPoint2D();
+            item.writeCurve(vertices, 2, fillShift);
+            if (fillShift < 0) {
+                const float baseline = float(item.height());
+                for (int i = 0; i < count; ++i) {
+                    vertices[i * 2 + 1].set(vertices[i * 2].x, baseline);
+                }
+            }
+            m_fill->markDirty(QSGNode::DirtyGeometry);
+        }
+
+        if (gridDirty) {
+            QSGGeometry* grid = m_grid->geometry();
+            const int lines = item.showGrid() ? item.gridLines() : 0;
+            grid->allocate(lines * 2);
+
+            QSGGeometry::Point2D* vertices = grid->vertexDataAsPoint2D();
+            const qreal step = item.height() / (lines + 1);
+            for (int i = 0; i < lines; ++i) {
+                const float y = float(step * (i + 1));
+                vertices[i * 2].set(0, y);
+                vertices[i * 2 + 1].set(float(item.width()), y);
+            }
+            m_grid->markDirty(QSGNode::DirtyGeometry);
+        }
+
+        if (colorsDirty) {
+            setNodeColor(m_grid, item.gridColor());
+            setNodeColor(m_fill, item.fillColor());
+            setNodeColor(m_line, item.lineColor());
+        }
+    }
+
+private:
+    QSGGeometryNode* m_grid;
+    QSGGeometryNode* m_fill;
+    QSGGeometryNode* m_line;
+};
+
+/**
+ * @brief Software backend: the same path painted with the renderer's QPainter
+ *
+ * Custom geometry is not drawn by the software adaptation, but render
+ * nodes are; the path vertices are still shifted in place, only the
+ * rasterisation goes through QPainter.
+ */
+class ChartPainterNode : public QSGRenderNode
+{
+public:
+    explicit ChartPainterNode(QQuickWindow* window)
+        : m_window(window)
+        , m_lineWidth(1)
+        , m_showFill(false)
+        , m_gridLines(0)
+        , m_antialiasing(false)
+    {
+    }
+
+    void sync(const LineChartItem& item, int shift)
+    {
+        const int count = item.curvePointCount();
+        if (m_path.size() != count) {
+            m_path.resize(count);
+            shift = -1;
+        }
+        item.writeCurve(m_path.data(), 1, shift);
+
+        m_size = item.size();
+        m_lineColor = item.lineColor();
+        m_lineWidth = item.lineWidth();
+        m_showFill = item.showFill();
+        m_fillColor = item.fillColor();
+        m_gridLines = item.showGrid() ? item.gridLines() : 0;
+        m_gridColor = item.gridColor();
+        m_antialiasing = item.antialiasing();
+
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    void render(const RenderState* state) override
+    {
+        QSGRendererInterface* rif = m_window->rendererInterface();
+        QPainter* painter = static_cast<QPainter*>(
+            rif->getResource(m_window, QSGRendererInterface::PainterResource));
+        if (!painter) {
+            return;
+        }
+
+        // Clip must be set before the transform
+        const QRegion* clipRegion = state->clipRegion();
+        if (clipRegion && !clipRegion->isEmpty()) {
+            painter->setClipRegion(*clipRegion, Qt::ReplaceClip);
+        }
+        painter->setTransform(matrix()->toTransform());
+        painter->setOpacity(inheritedOpacity());
+
+        if (m_gridLines > 0) {
+            painter->setRenderHint(QPainter::Antialiasing, false);
+            painter->setPen(QPen(m_gridColor, 1));
+            const qreal step = m_size.height() / (m_gridLines + 1);
+            for (int i = 1; i <= m_gridLines; ++i) {
+                painter->drawLine(QLineF(0, step * i, m_size.width(), step * i));
+            }
+        }
+
+        if (m_path.size() < 2) {
+            return;
+        }
+
+        painter->setRenderHint(QPainter::Antialiasing, m_antialiasing);
+
+        if (m_showFill) {
+            QPolygonF area(m_path);
+            area << QPointF(m_path.last().x(), m_size.height())
+                 << QPointF(m_path.first().x(), m_size.height());
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(m_fillColor);
+            painter->drawPolygon(area);
+        }
+
+        painter->setPen(QPen(m_lineColor, m_lineWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawPolyline(m_path.constData(), m_path.size());
+    }
+
+    StateFlags changedStates() const override { return {}; }
+    RenderingFlags flags() const override { return BoundedRectRendering; }
+    QRectF rect() const override { return QRectF(QPointF(0, 0), m_size); }
+
+private:
+    QQuickWindow* m_window;
+    QVector<QPointF> m_path;
+    QSizeF m_size;
+    QColor m_lineColor;
+    int m_lineWidth;
+    bool m_showFill;
+    QColor m_fillColor;
+    int m_gridLines;
+    QColor m_gridColor;
+    bool m_antialiasing;
+};
+
+} // namespace
+
+LineChartItem::LineChartItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_minValue(0)
+    , m_maxValue(100)
+    , m_lineColor(QStringLiteral("#4CAF50"))
+    , m_lineWidth(2)
+    , m_smoothLine(true)
+    , m_showFill(false)
+    , m_fillColor(QColor::fromRgbF(0.3f, 0.8f, 0.3f, 0.2f))
+    , m_showGrid(false)
+    , m_gridColor(QColor::fromRgbF(1.0f, 1.0f, 1.0f, 0.05f))
+    , m_gridLines(4)
+    , m_dirty(LayoutDirty | ColorDirty | GridDirty)
+    , m_removedFront(0)
+    , m_appended(0)
+    , m_scaleMin(0)
+    , m_scaleMax(0)
+{
+    setFlag(ItemHasContents, true);
+}
+
+// ==================== Data ====================
+
+void LineChartItem::setDataPoints(const QVariantList &points)
+{
+    m_dataPoints = points;
+    emit dataPointsChanged();
+
+    // The model takes precedence, as it did for the Canvas chart
+    if (m_model) {
+        return;
+    }
+
+    QVector<qreal> values;
+    values.reserve(points.size());
+    for (const QVariant &point : points) {
+        values.append(point.toReal());
+    }
+
+    // A history list that moved on by one sample keeps its vertices
+    const bool shiftedByOne = values.size() == m_values.size() && values.size() > 1
+                              && std::equal(values.cbegin(), values.cend() - 1, m_values.cbegin() + 1);
+
+    m_values = values;
+
+    if (shiftedByOne) {
+        ++m_removedFront;
+        ++m_appended;
+        update();
+    } else {
+        markDirty(LayoutDirty);
+    }
+}
+
+void LineChartItem::setModel(HistoryModel *model)
+{
+    if (m_model == model) {
+        return;
+    }
+
+    if (m_model) {
+        disconnect(m_model, nullptr, this, nullptr);
+    }
+
+    m_model = model;
+
+    if (m_model) {
+        connect(m_model, &QAbstractItemModel::rowsInserted, this, &LineChartItem::onRowsInserted);
+        connect(m_model, &QAbstractItemModel::rowsRemoved, this, &LineChartItem::onRowsRemoved);
+        connect(m_model, &QAbstractItemModel::modelReset, this, &LineChartItem::onModelReset);
+    }
+
+    reloadFromModel();
+    emit modelChanged();
+}
+
+void LineChartItem::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent)
+
+    if (first != m_values.size()) {
+        reloadFromModel();
+        return;
+    }
+
+    for (int row = first; row <= last; ++row) {
+        m_values.append(m_model->valueAt(row));
+    }
+    m_appended += last - first + 1;
+    update();
+}
+
+void LineChartItem::onRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent)
+
+    if (first != 0 || last >= m_values.size()) {
+        reloadFromModel();
+        return;
+    }
+
+    m_values.remove(0, last + 1);
+    m_removedFront += last + 1;
+    update();
+}
+
+void LineChartItem::onModelReset()
+{
+    reloadFromModel();
+}
+
+void LineChartItem::reloadFromModel()
+{
+    m_values.clear();
+
+    if (m_model) {
+        const int count = m_model->count();
+        m_values.reserve(count);
+        for (int row = 0; row < count; ++row) {
+            m_values.append(m_model->valueAt(row));
+        }
+    } else {
+        for (const QVariant &point : m_dataPoints) {
+            m_values.append(point.toReal());
+        }
+    }
+
+    markDirty(LayoutDirty);
+}
+
+// ==================== Appearance ====================
+
+void LineChartItem::setMinValue(qreal value)
+{
+    if (m_minValue == value) {
+        return;
+    }
+    m_minValue = value;
+    update();
+    emit minValueChanged();
+}
+
+void LineChartItem::setMaxValue(qreal value)
+{
+    if (m_maxValue == value) {
+        return;
+    }
+    m_maxValue = value;
+    update();
+    emit maxValueChanged();
+}
+
+void LineChartItem::setLineColor(const QColor &color)
+{
+    if (m_lineColor == color) {
+        return;
+    }
+    m_lineColor = color;
+    markDirty(ColorDirty);
+    emit lineColorChanged();
+}
+
+void LineChartItem::setLineWidth(int width)
+{
+    if (m_lineWidth == width) {
+        return;
+    }
+    m_lineWidth = width;
+    markDirty(ColorDirty);
+    emit lineWidthChanged();
+}
+
+void LineChartItem::setSmoothLine(bool smooth)
+{
+    if (m_smoothLine == smooth) {
+        return;
+    }
+    m_smoothLine = smooth;
+    markDirty(LayoutDirty);
+    emit smoothLineChanged();
+}
+
+void LineChartItem::setShowFill(bool show)
+{
+    if (m_showFill == show) {
+        return;
+    }
+    m_showFill = show;
+    markDirty(LayoutDirty | ColorDirty);
+    emit showFillChanged();
+}
+
+void LineChartItem::setFillColor(const QColor &color)
+{
+    if (m_fillColor == color) {
+        return;
+    }
+    m_fillColor = color;
+    markDirty(ColorDirty);
+    emit fillColorChanged();
+}
+
+void LineChartItem::setShowGrid(bool show)
+{
+    if (m_showGrid == show) {
+        return;
+    }
+    m_showGrid = show;
+    markDirty(GridDirty);
+    emit showGridChanged();
+}
+
+void LineChartItem::setGridColor(const QColor &color)
+{
+    if (m_gridColor == color) {
+        return;
+    }
+    m_gridColor = color;
+    markDirty(ColorDirty);
+    emit gridColorChanged();
+}
+
+void LineChartItem::setGridLines(int lines)
+{
+    lines = qMax(0, lines);
+    if (m_gridLines == lines) {
+        return;
+    }
+    m_gridLines = lines;
+    markDirty(GridDirty);
+    emit gridLinesChanged();
+}
+
+void LineChartItem::markDirty(int flags)
+{
+    m_dirty |= flags;
+    update();
+}
+
+// ==================== Layout ====================
+
+int LineChartItem::curvePointCount() const
+{
+    if (m_values.size() < 2) {
+        return 0;
+    }
+    return (m_values.size() - 1) * curveSteps() + 1;
+}
+
+void LineChartItem::updateScale()
+{
+    qreal low = m_minValue;
+    qreal high = m_maxValue;
+
+    // 0 means auto: the series range with 10% padding, as before
+    if (qFuzzyIsNull(m_minValue) || qFuzzyIsNull(m_maxValue)) {
+        qreal minimum = 0;
+        qreal maximum = 0;
+        if (!m_values.isEmpty()) {
+            const auto range = std::minmax_element(m_values.cbegin(), m_values.cend());
+            minimum = *range.first;
+            maximum = *range.second;
+        }
+
+        if (qFuzzyIsNull(m_minValue)) {
+            low = m_values.isEmpty() ? 0 : qFloor(minimum * 0.9);
+        }
+        if (qFuzzyIsNull(m_maxValue)) {
+            high = m_values.isEmpty() ? 100 : qCeil(maximum * 1.1);
+        }
+    }
+
+    if (low != m_scaleMin || high != m_scaleMax) {
+        m_scaleMin = low;
+        m_scaleMax = high;
+        m_dirty |= LayoutDirty;
+    }
+}
+
+qreal LineChartItem::valueToY(qreal value) const
+{
+    qreal range = m_scaleMax - m_scaleMin;
+    if (range == 0) {
+        range = 1;
+    }
+
+    const qreal chartHeight = height();
+    return qBound<qreal>(0, chartHeight - (value - m_scaleMin) / range * chartHeight, chartHeight);
+}
+
+qreal LineChartItem::curveY(int index) const
+{
+    const int steps = curveSteps();
+    const int last = m_values.size() - 1;
+    const int interval = index / steps;
+    const int step = index % steps;
+
+    if (interval >= last) {
+        return valueToY(m_values.at(last));
+    }
+    if (step == 0) {
+        return valueToY(m_values.at(interval));
+    }
+
+    // Catmull-Rom through the neighbouring samples, clamped at both ends
+    const qreal p0 = m_values.at(qMax(interval - 1, 0));
+    const qreal p1 = m_values.at(interval);
+    const qreal p2 = m_values.at(interval + 1);
+    const qreal p3 = m_values.at(qMin(interval + 2, last));
+    const qreal t = qreal(step) / steps;
+
+    const qreal value = 0.5 * (2 * p1
+                               + (p2 - p0) * t
+                               + (2 * p0 - 5 * p1 + 4 * p2 - p3) * t * t
+                               + (3 * p1 - p0 - 3 * p2 + p3) * t * t * t);
+    return valueToY(value);
+}
+
+// ==================== Scene graph ====================
+
+void LineChartItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+    if (newGeometry.size() != oldGeometry.size()) {
+        markDirty(LayoutDirty | GridDirty);
+    }
+}
+
+QSGNode* LineChartItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data)
+
+    updateScale();
+
+    // Same sample count and scale: the vertices only need to move along
+    int shift = -1;
+    if (!(m_dirty & LayoutDirty) && m_removedFront == m_appended) {
+        shift = m_appended;
+    }
+
+    const bool software = window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+
+    if (software) {
+        ChartPainterNode* node = static_cast<ChartPainterNode*>(oldNode);
+        if (!node) {
+            node = new ChartPainterNode(window());
+            shift = -1;
+        }
+        node->sync(*this, shift);
+        oldNode = node;
+    } else {
+        ChartGeometryNode* node = static_cast<ChartGeometryNode*>(oldNode);
+        bool created = false;
+        if (!node) {
+            node = new ChartGeometryNode;
+            created = true;
+            shift = -1;
+        }
+        node->sync(*this, shift, created || (m_dirty & ColorDirty), created || (m_dirty & GridDirty));
+        oldNode = node;
+    }
+
+    m_dirty = 0;
+    m_removedFront = 0;
+    m_appended = 0;
+
+    return oldNode;
+}
@@ -0,0 +1,237 @@
+/**
+ * ============================================
+ * File: src/view/LineChartItem.h
+ * Description: Scene-graph line chart item used by LineChart.qml
+ * ============================================
+ */
+
+#ifndef LINECHARTITEM_H
+#define LINECHARTITEM_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QPointer>
+#include <QSGGeometry>
+#include <QVariantList>
+#include <QVector>
+
+#include "HistoryModel.h"
+
+/**
+ * @class LineChartItem
+ * @brief Line chart drawn with scene-graph geometry instead of a Canvas
+ *
+ * The series comes either from a HistoryModel (model) or from a plain
+ * value list (dataPoints). The item keeps its own copy of the values and
+ * tracks how many samples were shifted in since the last frame; when the
+ * sample count and the Y range are unchanged, updatePaintNode() moves the
+ * existing vertex Y coordinates along and only computes the new tail
+ * (plus the head segment of a smoothed curve) instead of laying out the
+ * whole path again.
+ *
+ * With an RHI backend the chart is a line strip, a fill triangle strip and
+ * grid lines. The software backend (linuxfb on the Pi) cannot draw custom
+ * geometry, so there the same vertices are kept in a render node that
+ * paints them with the scene graph's QPainter.
+ */
+class LineChartItem : public QQuickItem
+{
+    Q_OBJECT
+
+    // Data
+    Q_PROPERTY(QVariantList dataPoints READ dataPoints WRITE setDataPoints NOTIFY dataPointsChanged)
+    Q_PROPERTY(HistoryModel* model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(qreal minValue READ minValue WRITE setMinValue NOTIFY minValueChanged)
+    Q_PROPERTY(qreal maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+
+    // Appearance
+    Q_PROPERTY(QColor lineColor READ lineColor WRITE setLineColor NOTIFY lineColorChanged)
+    Q_PROPERTY(int lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(bool smoothLine READ smoothLine WRITE setSmoothLine NOTIFY smoothLineChanged)
+    Q_PROPERTY(bool showFill READ showFill WRITE setShowFill NOTIFY showFillChanged)
+    Q_PROPERTY(QColor fillColor READ fillColor WRITE setFillColor NOTIFY fillColorChanged)
+
+    // Grid
+    Q_PROPERTY(bool showGrid READ showGrid WRITE setShowGrid NOTIFY showGridChanged)
+    Q_PROPERTY(QColor gridColor READ gridColor WRITE setGridColor NOTIFY gridColorChanged)
+    Q_PROPERTY(int gridLines READ gridLines WRITE setGridLines NOTIFY gridLinesChanged)
+
+public:
+    explicit LineChartItem(QQuickItem *parent = nullptr);
+    ~LineChartItem() override = default;
+
+    QVariantList dataPoints() const { return m_dataPoints; }
+    void setDataPoints(const QVariantList& points);
+
+    HistoryModel* model() const { return m_model; }
+    void setModel(HistoryModel* model);
+
+    qreal minValue() const { return m_minValue; }
+    void setMinValue(qreal value);
+
+    qreal maxValue() const { return m_maxValue; }
+    void setMaxValue(qreal value);
+
+    QColor lineColor() const { return m_lineColor; }
+    void setLineColor(const QColor& color);
+
+    int lineWidth() const { return m_lineWidth; }
+    void setLineWidth(int width);
+
+    bool smoothLine() const { return m_smoothLine; }
+    void setSmoothLine(bool smooth);
+
+    bool showFill() const { return m_showFill; }
+    void setShowFill(bool show);
+
+    QColor fillColor() const { return m_fillColor; }
+    void setFillColor(const QColor& color);
+
+    bool showGrid() const { return m_showGrid; }
+    void setShowGrid(bool show);
+
+    QColor gridColor() const { return m_gridColor; }
+    void setGridColor(const QColor& color);
+
+    int gridLines() const { return m_gridLines; }
+    void setGridLines(int lines);
+
+    /**
+     * @brief Vertices in the chart path for the current series
+     */
+    int curvePointCount() const;
+
+    /**
+     * @brief Bring a vertex array up to date with the series
+     * @param points First vertex of the path; successive ones are stride apart
+     * @param stride Distance between path vertices (2 for the fill strip)
+     * @param shift Samples shifted in since the array was written, -1 to lay out everything
+     *
+     * Works on both QSGGeometry::Point2D (RHI) and QPointF (software) arrays.
+     */
+    template <typename Point>
+    void writeCurve(Point* points, int stride, int shift) const;
+
+signals:
+    void dataPointsChanged();
+    void modelChanged();
+    void minValueChanged();
+    void maxValueChanged();
+    void lineColorChanged();
+    void lineWidthChanged();
+    void smoothLineChanged();
+    void showFillChanged();
+    void fillColorChanged();
+    void showGridChanged();
+    void gridColorChanged();
+    void gridLinesChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private slots:
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    void onRowsRemoved(const QModelIndex& parent, int first, int last);
+    void onModelReset();
+
+private:
+    enum DirtyFlag {
+        LayoutDirty = 0x1,      // Vertex count, size or scale changed
+        ColorDirty = 0x2,       // Materials only
+        GridDirty = 0x4         // Grid lines only
+    };
+
+    void markDirty(int flags);
+    void reloadFromModel();
+    void updateScale();
+
+    int curveSteps() const { return m_smoothLine ? SMOOTH_STEPS : 1; }
+    qreal curveY(int index) const;
+    qreal valueToY(qreal value) const;
+
+private:
+    // Series (oldest first) and the source it mirrors
+    QVector<qreal> m_values;
+    QVariantList m_dataPoints;
+    QPointer<HistoryModel> m_model;
+
+    qreal m_minValue;
+    qreal m_maxValue;
+    QColor m_lineColor;
+    int m_lineWidth;
+    bool m_smoothLine;
+    bool m_showFill;
+    QColor m_fillColor;
+    bool m_showGrid;
+    QColor m_gridColor;
+    int m_gridLines;
+
+    // Changes since the last updatePaintNode()
+    int m_dirty;
+    int m_removedFront;
+    int m_appended;
+
+    // Y range the current vertices were laid out with
+    qreal m_scaleMin;
+    qreal m_scaleMax;
+
+    // Constants
+    static constexpr int SMOOTH_STEPS = 4;      // Vertices per sample interval when smoothed
+};
+
+// ============================================================================
+// Template implementation
+// ============================================================================
+
+namespace ChartVertex {
+inline void set(QSGGeometry::Point2D& point, qreal x, qreal y) { point.set(float(x), float(y)); }
+inline void set(QPointF& point, qreal x, qreal y) { point = QPointF(x, y); }
+
+inline void setY(QSGGeometry::Point2D& point, qreal y) { point.y = float(y); }
+inline void setY(QPointF& point, qreal y) { point.setY(y); }
+
+inline qreal y(const QSGGeometry::Point2D& point) { return point.y; }
+inline qreal y(const QPointF& point) { return point.y(); }
+}
+
+template <typename Point>
+void LineChartItem::writeCurve(Point* points, int stride, int shift) const
+{
+    const int count = curvePointCount();
+    const int samples = m_values.size();
+    const int steps = curveSteps();
+
+    if (count == 0 || shift == 0) {
+        return;
+    }
+
+    // A smoothed interval depends on one sample either side, so only the
+    // interior survives a shift; too large a shift leaves nothing to reuse
+    if (shift < 0 || shift >= samples - 2) {
+        const qreal dx = width() / (samples - 1) / steps;
+        for (int i = 0; i < count; ++i) {
+            ChartVertex::set(points[i * stride], dx * i, curveY(i));
+        }
+        return;
+    }
+
+    // X positions depend only on the vertex index, so shifting is a move
+    // of the Y coordinates by whole sample intervals
+    const int moved = shift * steps;
+    for (int i = 0; i + moved < count; ++i) {
+        ChartVertex::setY(points[i * stride], ChartVertex::y(points[(i + moved) * stride]));
+    }
+
+    const int head = m_smoothLine ? steps : 0;
+    const int tail = m_smoothLine ? (samples - 2 - shift) * steps : (samples - shift) * steps;
+
+    for (int i = 0; i < head; ++i) {
+        ChartVertex::setY(points[i * stride], curveY(i));
+    }
+    for (int i = qMax(tail, head); i < count; ++i) {
+        ChartVertex::setY(points[i * stride], curveY(i));
+    }
+}
+
+#endif // LINECHARTITEM_H
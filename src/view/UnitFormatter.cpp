@@ -0,0 +1,150 @@
+/**
+ * ============================================
+ * File: src/view/UnitFormatter.cpp
+ * Description: Memoizing unit formatter implementation
+ * ============================================
+ */
+
+#include "UnitFormatter.h"
+#include <QtMath>
+
+namespace {
+
+constexpr double KIBI = 1024.0;
+constexpr double MEBI = KIBI * KIBI;
+
+const char* const SIZE_UNITS[] = { " B", " KB", " MB", " GB", " TB" };
+const char* const RATE_UNITS[] = { " B/s", " KB/s", " MB/s", " GB/s" };
+
+/**
+ * @brief A value in the largest binary unit it reaches, as displayed
+ *
+ * The base unit shows whole numbers, larger units one decimal, so the
+ * display key is the truncated value or the value in tenths.
+ */
+struct Scaled {
+    int unit = 0;
+    qint64 shown = 0;
+
+    qint64 key() const { return shown * 8 + unit; }
+};
+
+Scaled scale(double value, int maxUnit)
+{
+    Scaled scaled;
+    double divisor = 1.0;
+    while (scaled.unit < maxUnit && value >= divisor * KIBI) {
+        divisor *= KIBI;
+        ++scaled.unit;
+    }
+
+    scaled.shown = (scaled.unit == 0) ? static_cast<qint64>(value)
+                                      : qRound64(value / divisor * 10.0);
+    return scaled;
+}
+
+QString scaledText(const Scaled& scaled, const char* const* units)
+{
+    if (scaled.unit == 0) {
+        return QString::number(scaled.shown) + QLatin1String(units[0]);
+    }
+    return QString::number(scaled.shown / 10.0, 'f', 1) + QLatin1String(units[scaled.unit]);
+}
+
+} // namespace
+
+UnitFormatter::UnitFormatter(QObject* parent)
+    : QObject(parent)
+{
+}
+
+template <typename Format>
+QString UnitFormatter::cached(int field, Style style, qint64 key, Format format)
+{
+    if (field < 0 || field >= FieldCount) {
+        return format();
+    }
+
+    Entry& entry = m_cache[field];
+    if (entry.style != style || entry.key != key) {
+        entry.style = style;
+        entry.key = key;
+        entry.text = format();
+    }
+    return entry.text;
+}
+
+QString UnitFormatter::size(qint64 bytes, int field)
+{
+    if (bytes < 0) {
+        return cached(field, Style::Size, -1, []() { return QStringLiteral("N/A"); });
+    }
+
+    const Scaled scaled = scale(static_cast<double>(bytes), 4);
+    return cached(field, Style::Size, scaled.key(), [&scaled]() {
+        return scaledText(scaled, SIZE_UNITS);
+    });
+}
+
+QString UnitFormatter::megabytes(qint64 bytes, int field)
+{
+    if (bytes < 0) {
+        return cached(field, Style::Megabytes, -1, []() { return QStringLiteral("N/A"); });
+    }
+
+    const qint64 mb = static_cast<qint64>(bytes / MEBI);
+    return cached(field, Style::Megabytes, mb, [mb]() {
+        return QString::number(mb) + QLatin1Char('M');
+    });
+}
+
+QString UnitFormatter::rate(double bytesPerSec, int field)
+{
+    const Scaled scaled = scale(qMax(0.0, bytesPerSec), 3);
+    return cached(field, Style::Rate, scaled.key(), [&scaled]() {
+        return scaledText(scaled, RATE_UNITS);
+    });
+}
+
+QString UnitFormatter::packetRate(double packetsPerSec, int field)
+{
+    const qint64 pps = static_cast<qint64>(qMax(0.0, packetsPerSec));
+    return cached(field, Style::PacketRate, pps, [pps]() {
+        return QString::number(pps) + QLatin1String(" pps");
+    });
+}
+
+QString UnitFormatter::frequency(qint64 hz, int field)
+{
+    if (hz <= 0) {
+        return cached(field, Style::Frequency, -1, []() { return QStringLiteral("N/A"); });
+    }
+
+    // GHz with one decimal place
+    const qint64 tenths = qRound64(hz / 1e8);
+    return cached(field, Style::Frequency, tenths, [tenths]() {
+        return QString::number(tenths / 10.0, 'f', 1) + QLatin1Char('G');
+    });
+}
+
+QString UnitFormatter::loadAverage(const QList<qreal>& loads, int field)
+{
+    if (loads.size() < 3) {
+        return cached(field, Style::LoadAverage, -1, []() { return QStringLiteral("N/A"); });
+    }
+
+    // Three loads in hundredths, 21 bits each, packed into one key
+    constexpr qint64 MAX_HUNDREDTHS = (1 << 21) - 1;
+    qint64 hundredths[3];
+    qint64 key = 0;
+    for (int i = 0; i < 3; ++i) {
+        hundredths[i] = qBound<qint64>(0, qRound64(loads.at(i) * 100.0), MAX_HUNDREDTHS);
+        key = (key << 21) | hundredths[i];
+    }
+
+    return cached(field, Style::LoadAverage, key, [&hundredths]() {
+        return QString::number(hundredths[0] / 100.0, 'f', 2) + QLatin1Char(' ')
+             + QString::number(hundredths[1] / 100.0, 'f', 2) + QLatin1Char(' ')
+             + QString::number(hundredths[2] / 100.0, 'f', 2);
+    });
+}
@@ -0,0 +1,134 @@
+/**
+ * ============================================
+ * File: src/view/UnitFormatter.h
+ * Description: Memoizing number-to-text formatter exposed to QML
+ * ============================================
+ */
+
+#ifndef UNITFORMATTER_H
+#define UNITFORMATTER_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <array>
+
+/**
+ * @class UnitFormatter
+ * @brief Turns the controller's raw metrics into display text
+ *
+ * SystemController exposes bytes, bytes/s and Hz; QML bindings pass them
+ * through this singleton (module SystemMonitor.Units) to get a label:
+ *
+ *     text: UnitFormatter.size(systemInfo.hddUsed, UnitFormatter.HddUsed)
+ *
+ * Each call with a Field remembers the last result for that field, keyed
+ * by the value rounded to what the text can show. Raw values change on
+ * almost every sample while the label ("1.4 GB") rarely does, so most
+ * calls return the stored QString (an implicitly shared copy) without
+ * formatting or allocating. Calls without a field are not cached.
+ *
+ * GUI thread only.
+ */
+class UnitFormatter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Cache slot of one on-screen value
+     */
+    enum Field {
+        NoCache = -1,
+
+        // CPU / GPU
+        CpuClock,
+        LoadAverage,
+        GpuMem,
+
+        // RAM
+        RamUsed,
+        RamFree,
+        RamCache,
+        RamTotal,
+
+        // Storage
+        HddTotal,
+        HddUsed,
+        HddFree,
+        SwapTotal,
+        SwapUsed,
+        SwapFree,
+        IoRead,
+        IoWrite,
+
+        // Network
+        NetUp,
+        NetDown,
+        PacketRate,
+
+        FieldCount
+    };
+    Q_ENUM(Field)
+
+    explicit UnitFormatter(QObject* parent = nullptr);
+    ~UnitFormatter() override = default;
+
+    /**
+     * @brief Byte count with an automatic unit, e.g. "14.2 GB"
+     */
+    Q_INVOKABLE QString size(qint64 bytes, int field = NoCache);
+
+    /**
+     * @brief Whole mebibytes, e.g. "512M" (compact RAM figures)
+     */
+    Q_INVOKABLE QString megabytes(qint64 bytes, int field = NoCache);
+
+    /**
+     * @brief Transfer rate with an automatic unit, e.g. "1.2 MB/s"
+     */
+    Q_INVOKABLE QString rate(double bytesPerSec, int field = NoCache);
+
+    /**
+     * @brief Packets per second, e.g. "35 pps"
+     */
+    Q_INVOKABLE QString packetRate(double packetsPerSec, int field = NoCache);
+
+    /**
+     * @brief Clock in GHz, e.g. "1.4G"
+     */
+    Q_INVOKABLE QString frequency(qint64 hz, int field = NoCache);
+
+    /**
+     * @brief 1, 5 and 15 minute load, e.g. "0.52 1.07 0.90"
+     */
+    Q_INVOKABLE QString loadAverage(const QList<qreal>& loads, int field = NoCache);
+
+private:
+    enum class Style {
+        None,
+        Size,
+        Megabytes,
+        Rate,
+        PacketRate,
+        Frequency,
+        LoadAverage
+    };
+
+    struct Entry {
+        Style style = Style::None;
+        qint64 key = 0;         // Value as rounded for display
+        QString text;
+    };
+
+    /**
+     * @brief Return the stored text for (style, key), or format and store it
+     */
+    template <typename Format>
+    QString cached(int field, Style style, qint64 key, Format format);
+
+private:
+    std::array<Entry, FieldCount> m_cache;
+};
+
+#endif // UNITFORMATTER_H